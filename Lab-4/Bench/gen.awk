@@ -0,0 +1,61 @@
+# 生成用于性能测试的C--程序：awk -v n=行数 -f gen.awk > big.cmm
+# 每个函数包含若干局部变量、一个数组和一个带分支的循环，main依次调用所有函数
+function pick(k) {
+    return int(rand() * k)
+}
+
+function expr(vars, cnt, depth,    op) {
+    if (depth > 3 || rand() < 0.3) {
+        if (pick(cnt + 1) == cnt)
+            return pick(10)
+        return vars[pick(cnt)]
+    }
+    op = substr("+-*+-", pick(5) + 1, 1)
+    return "(" expr(vars, cnt, depth + 1) " " op " " expr(vars, cnt, depth + 1) ")"
+}
+
+BEGIN {
+    srand(1)
+    if (n == "")
+        n = 100000
+    funcs = int(n / 60)
+    if (funcs < 1)
+        funcs = 1
+    params[0] = "p"; params[1] = "q"
+    for (k = 0; k < 6; k++)
+        vs[k] = "a" k
+    for (k = 0; k < 6; k++)
+        vi[k] = vs[k]
+    vi[6] = "i"
+    for (f = 0; f < funcs; f++) {
+        print "int f" f "(int p, int q) {"
+        print "  int a0, a1, a2, a3, a4, a5;"
+        print "  int arr[16];"
+        print "  int i = 0;"
+        for (k = 0; k < 6; k++)
+            print "  " vs[k] " = " expr(params, 2, 0) ";"
+        print "  while (i < 16) {"
+        print "    arr[i] = " expr(vi, 7, 0) ";"
+        for (k = 0; k < 8; k++) {
+            v = vs[pick(6)]
+            print "    " v " = " expr(vi, 7, 0) ";"
+            print "    if (" v " > " vs[pick(6)] " && " v " < 100) {"
+            print "      " vs[pick(6)] " = " vs[pick(6)] " - arr[i];"
+            print "    } else {"
+            print "      " vs[pick(6)] " = arr[i] + " (pick(9) + 1) ";"
+            print "    }"
+        }
+        print "    i = i + 1;"
+        print "  }"
+        print "  return " expr(vs, 6, 0) ";"
+        print "}"
+        print ""
+    }
+    print "int main() {"
+    print "  int s = 0;"
+    for (f = 0; f < funcs; f++)
+        print "  s = s + f" f "(" (f % 7) ", s);"
+    print "  write(s);"
+    print "  return 0;"
+    print "}"
+}
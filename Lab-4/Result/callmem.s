@@ -0,0 +1,135 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+bump:
+  addi $sp, $sp, -8
+  sw $ra, 4($sp)
+  sw $fp, 0($sp)
+  addi $fp, $sp, 8
+  move $t0, $a0
+  move $t1, $a1
+  blez $a1, label2
+  lw $t8, 0($t0)
+  addi $t2, $t8, 1
+  sw $t2, 0($t0)
+  addi $t1, $t1, -1
+  move $a0, $t0
+  move $a1, $t1
+  jal bump
+  addi $v0, $v0, 1
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
+label2:
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
+
+fill:
+  addi $sp, $sp, -20
+  sw $ra, 16($sp)
+  sw $fp, 12($sp)
+  addi $fp, $sp, 20
+  sw $s0, -12($fp)
+  sw $s1, -16($fp)
+  sw $s2, -20($fp)
+  move $s0, $a0
+  move $s1, $a1
+  bgtz $a1, label4
+  move $v0, $zero
+  lw $s0, -12($fp)
+  lw $s1, -16($fp)
+  lw $s2, -20($fp)
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
+label4:
+  sll $t0, $s1, 2
+  add $s2, $s0, $t0
+  addi $t0, $s1, -1
+  sll $t1, $t0, 2
+  add $t1, $s0, $t1
+  lw $t8, 0($t1)
+  addi $t1, $t8, 2
+  sw $t1, 0($s2)
+  move $a0, $s0
+  move $a1, $t0
+  jal fill
+  lw $t8, 0($s2)
+  sll $t9, $t8, 2
+  addu $t9, $t9, $t8
+  sll $t0, $t9, 1
+  lw $t9, 0($s0)
+  add $t0, $t0, $t9
+  sw $t0, 0($s0)
+  move $v0, $s1
+  lw $s0, -12($fp)
+  lw $s1, -16($fp)
+  lw $s2, -20($fp)
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
+
+main:
+  addi $sp, $sp, -24
+  sw $ra, 20($sp)
+  sw $fp, 16($sp)
+  addi $fp, $sp, 24
+  jal read
+  move $s0, $v0
+  addi $s1, $fp, -24
+  li $t8, 5
+  sw $t8, -24($fp)
+  addi $a0, $fp, -24
+  move $a1, $v0
+  jal bump
+  move $t0, $v0
+  lw $t1, 0($s1)
+  li $a0, 5
+  jal write
+  move $a0, $t1
+  jal write
+  move $a0, $t0
+  jal write
+  li $t8, 1
+  sw $t8, 0($s1)
+  addi $s2, $fp, -20
+  sw $zero, -20($fp)
+  addi $a0, $fp, -24
+  move $a1, $s0
+  jal fill
+  move $t0, $v0
+  lw $a0, 0($s1)
+  jal write
+  lw $t8, 0($s2)
+  add $a0, $t8, $t0
+  jal write
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
@@ -0,0 +1,54 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+main:
+  addi $sp, $sp, -40
+  sw $ra, 36($sp)
+  sw $fp, 32($sp)
+  addi $fp, $sp, 40
+  jal read
+  move $t0, $v0
+  move $t1, $zero
+  addi $t2, $fp, -40
+  move $t3, $zero
+label3:
+  slti $t9, $t1, 8
+  beqz $t9, label5
+  sw $t1, 0($t2)
+  add $t3, $t3, $t1
+  addi $t1, $t1, 1
+  addi $t2, $t2, 4
+  j label3
+label5:
+  move $a0, $t3
+  jal write
+  sll $t9, $t0, 2
+  subu $t0, $t9, $t0
+  addi $a0, $t0, 10
+  jal write
+  li $a0, 10
+  jal write
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
@@ -0,0 +1,60 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+main:
+  addi $sp, $sp, -48
+  sw $ra, 44($sp)
+  sw $fp, 40($sp)
+  addi $fp, $sp, 48
+  jal read
+  move $t0, $v0
+  addi $t1, $fp, -48
+  move $t2, $zero
+label1:
+  slti $t9, $t2, 30
+  beqz $t9, label3
+  sw $t2, 0($t1)
+  addi $t1, $t1, 4
+  addi $t2, $t2, 3
+  j label1
+label3:
+  move $t1, $zero
+  addi $t2, $fp, -48
+  move $t3, $zero
+label4:
+  bge $t1, $t0, label6
+  lw $t8, 0($t2)
+  li $t9, 12
+  beq $t8, $t9, label6
+  lw $t9, 0($t2)
+  add $t3, $t3, $t9
+  addi $t1, $t1, 1
+  addi $t2, $t2, 4
+  j label4
+label6:
+  move $a0, $t3
+  jal write
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
@@ -0,0 +1,130 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+main:
+  addi $sp, $sp, -212
+  sw $ra, 208($sp)
+  sw $fp, 204($sp)
+  addi $fp, $sp, 212
+  jal read
+  move $t0, $v0
+  sw $v0, -212($fp)
+  sw $v0, -144($fp)
+  sw $v0, -76($fp)
+  addi $t1, $fp, -208
+  addi $t2, $fp, -140
+  move $t3, $zero
+label4:
+  bge $t3, $t0, label6
+  mul $t4, $t3, $t0
+  move $t5, $zero
+  move $t6, $zero
+label7:
+  bge $t5, $t0, label9
+  add $t7, $t1, $t6
+  add $s0, $t3, $t5
+  sw $s0, 0($t7)
+  add $t7, $t2, $t6
+  sub $s0, $t4, $t5
+  sw $s0, 0($t7)
+  addi $t5, $t5, 1
+  addi $t6, $t6, 4
+  j label7
+label9:
+  addi $t3, $t3, 1
+  addi $t1, $t1, 16
+  addi $t2, $t2, 16
+  j label4
+label6:
+  addi $t1, $fp, -76
+  addi $t2, $fp, -208
+  addi $t4, $fp, -140
+  addi $t6, $fp, -72
+  addi $t7, $t0, -1
+  move $t3, $zero
+label10:
+  lw $t9, 0($t1)
+  bge $t3, $t9, label12
+  move $t5, $zero
+  move $s0, $zero
+label13:
+  lw $t9, 0($t1)
+  bge $t5, $t9, label15
+  move $s1, $zero
+  move $s2, $t4
+  move $s3, $zero
+  move $s4, $zero
+label16:
+  bge $s4, $t0, label18
+  add $s5, $t2, $s3
+  add $s6, $s2, $s0
+  lw $t8, 0($s5)
+  lw $t9, 0($s6)
+  mul $s5, $t8, $t9
+  add $s1, $s1, $s5
+  addi $s4, $s4, 1
+  addi $s3, $s3, 4
+  addi $s2, $s2, 16
+  j label16
+label18:
+  add $s2, $t6, $s0
+  div $s1, $t7
+  mflo $s1
+  sw $s1, 0($s2)
+  addi $t5, $t5, 1
+  addi $s0, $s0, 4
+  j label13
+label15:
+  addi $t3, $t3, 1
+  addi $t6, $t6, 16
+  addi $t2, $t2, 16
+  j label10
+label12:
+  addi $t1, $fp, -76
+  addi $t2, $fp, -72
+  move $t3, $zero
+  move $t4, $zero
+  move $t5, $zero
+label19:
+  lw $t9, 0($t1)
+  bge $t3, $t9, label20
+  add $t6, $t2, $t4
+  lw $t9, 0($t6)
+  add $t5, $t5, $t9
+  addi $t3, $t3, 1
+  addi $t2, $t2, 16
+  addi $t4, $t4, 4
+  j label19
+label20:
+  move $a0, $t5
+  jal write
+  addi $t1, $fp, -72
+  addi $t0, $t0, -1
+  sll $t0, $t0, 4
+  add $t0, $t1, $t0
+  lw $a0, 0($t0)
+  jal write
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
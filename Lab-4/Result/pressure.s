@@ -0,0 +1,204 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+main:
+  addi $sp, $sp, -116
+  sw $ra, 112($sp)
+  sw $fp, 108($sp)
+  addi $fp, $sp, 116
+  move $t0, $zero
+  addi $t1, $fp, -116
+label4:
+  slti $t9, $t0, 10
+  beqz $t9, label6
+  mul $t2, $t0, $t0
+  addi $t2, $t2, -3
+  sw $t2, 0($t1)
+  addi $t0, $t0, 1
+  addi $t1, $t1, 4
+  j label4
+label6:
+  addi $t8, $fp, -80
+  sw $t8, -76($fp)
+  move $t0, $zero
+  li $t8, -4
+  sw $t8, -72($fp)
+  move $t3, $zero
+  move $t4, $zero
+  li $t5, 7
+  sw $zero, -68($fp)
+  addi $t8, $fp, -116
+  sw $t8, -64($fp)
+  sw $zero, -60($fp)
+label7:
+  slti $t9, $t0, 10
+  beqz $t9, label9
+  lw $t8, -60($fp)
+  li $t9, 1374389535
+  mult $t8, $t9
+  mfhi $t9
+  sra $t9, $t9, 5
+  srl $t8, $t9, 31
+  addu $t8, $t9, $t8
+  sw $t8, -56($fp)
+  lw $t8, -64($fp)
+  lw $t8, 0($t8)
+  sw $t8, -52($fp)
+  lw $t8, -76($fp)
+  lw $t8, 0($t8)
+  sw $t8, -48($fp)
+  lw $t8, -52($fp)
+  add $s4, $t8, $t0
+  lw $t9, -56($fp)
+  add $s5, $t0, $t9
+  addi $s6, $t9, 3
+  lw $t8, -48($fp)
+  addi $s7, $t8, 3
+  lw $t9, -68($fp)
+  add $t1, $t8, $t9
+  lw $t8, -52($fp)
+  sll $t8, $t8, 1
+  sw $t8, -44($fp)
+  lw $t8, -56($fp)
+  sll $t8, $t8, 2
+  sw $t8, -40($fp)
+  lw $t8, -48($fp)
+  sll $t9, $t8, 2
+  subu $t9, $t9, $t8
+  sll $s0, $t9, 1
+  lw $t8, -52($fp)
+  addi $t8, $t8, -7
+  sw $t8, -36($fp)
+  lw $t9, -68($fp)
+  sub $t8, $t0, $t9
+  sw $t8, -32($fp)
+  lw $t8, -56($fp)
+  lw $t9, -48($fp)
+  sub $t8, $t8, $t9
+  sw $t8, -28($fp)
+  li $t8, 3
+  lw $t9, -52($fp)
+  sub $s3, $t8, $t9
+  lw $t8, -48($fp)
+  sub $t8, $t8, $t0
+  sw $t8, -24($fp)
+  add $t8, $s4, $s5
+  sw $t8, -20($fp)
+  add $t8, $t8, $s6
+  sw $t8, -16($fp)
+  add $t8, $s7, $t1
+  sw $t8, -12($fp)
+  add $t2, $t8, $t5
+  li $t7, 15
+  move $t6, $zero
+  move $s1, $zero
+label10:
+  slti $t9, $s1, 5
+  beqz $t9, label11
+  add $s2, $t6, $s4
+  add $s2, $s2, $s5
+  add $s2, $s2, $s6
+  add $s2, $s2, $s7
+  add $s2, $s2, $t1
+  add $s2, $s2, $t5
+  lw $t9, -44($fp)
+  add $s2, $s2, $t9
+  add $s2, $s2, $t4
+  lw $t9, -40($fp)
+  add $s2, $s2, $t9
+  add $s2, $s2, $t7
+  add $s2, $s2, $s0
+  add $s2, $s2, $t3
+  addi $s2, $s2, 56
+  lw $t9, -36($fp)
+  add $s2, $s2, $t9
+  lw $t9, -32($fp)
+  add $s2, $s2, $t9
+  lw $t9, -28($fp)
+  add $s2, $s2, $t9
+  add $s2, $s2, $s3
+  lw $t9, -24($fp)
+  add $s2, $s2, $t9
+  lw $t9, -16($fp)
+  add $s2, $s2, $t9
+  add $t6, $s2, $t2
+  add $s4, $s4, $t2
+  li $t9, 1431655766
+  mult $s4, $t9
+  mfhi $t9
+  srl $s2, $t9, 31
+  addu $s2, $t9, $s2
+  sub $t2, $t2, $s2
+  sll $s2, $t7, 1
+  sub $t7, $s2, $s0
+  addi $s1, $s1, 1
+  j label10
+label11:
+  lw $t9, -52($fp)
+  add $t1, $t6, $t9
+  add $t1, $t1, $t0
+  lw $t9, -56($fp)
+  add $t1, $t1, $t9
+  addi $t1, $t1, 3
+  lw $t9, -48($fp)
+  add $t1, $t1, $t9
+  lw $t9, -68($fp)
+  add $t1, $t1, $t9
+  addi $t1, $t1, 7
+  lw $t8, -60($fp)
+  add $t1, $t8, $t1
+  li $t9, 274877907
+  mult $t1, $t9
+  mfhi $t9
+  sra $t9, $t9, 6
+  srl $t2, $t9, 31
+  addu $t2, $t9, $t2
+  sub $t2, $t0, $t2
+  lw $t9, -72($fp)
+  add $t2, $t2, $t9
+  sub $t8, $t1, $t2
+  sw $t8, -60($fp)
+  move $a0, $t8
+  jal write
+  addi $t0, $t0, 1
+  lw $t8, -64($fp)
+  addi $t8, $t8, 4
+  sw $t8, -64($fp)
+  lw $t8, -76($fp)
+  addi $t8, $t8, -4
+  sw $t8, -76($fp)
+  lw $t8, -68($fp)
+  addi $t8, $t8, 2
+  sw $t8, -68($fp)
+  addi $t5, $t5, 2
+  addi $t4, $t4, 3
+  addi $t3, $t3, 14
+  lw $t8, -72($fp)
+  addi $t8, $t8, 4
+  sw $t8, -72($fp)
+  j label7
+label9:
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
@@ -0,0 +1,171 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+collatz:
+  move $t0, $a0
+  move $t1, $a1
+label17:
+  li $t9, 1
+  bne $t0, $t9, label6
+  move $v0, $t1
+  jr $ra
+label6:
+  srl $t9, $t0, 31
+  addu $t9, $t0, $t9
+  sra $t2, $t9, 1
+  sll $t2, $t2, 1
+  sub $t2, $t0, $t2
+  bnez $t2, label8
+  srl $t9, $t0, 31
+  addu $t9, $t0, $t9
+  sra $t0, $t9, 1
+  addi $t1, $t1, 1
+  j label17
+label8:
+  sll $t9, $t0, 2
+  subu $t2, $t9, $t0
+  addi $t0, $t2, 1
+  addi $t1, $t1, 1
+  j label17
+
+isEven:
+  move $t0, $a0
+  li $t9, 100000
+  ble $a0, $t9, label10
+  li $t1, 2
+label19:
+  bnez $t1, label20
+  addi $v0, $t0, -1
+  jr $ra
+label20:
+  div $t0, $t1
+  mflo $t2
+  mul $t2, $t2, $t1
+  sub $t2, $t0, $t2
+  move $t0, $t1
+  move $t1, $t2
+  j label19
+label10:
+  srl $t9, $t0, 31
+  addu $t9, $t0, $t9
+  sra $t1, $t9, 1
+  sll $t1, $t1, 1
+  sub $t0, $t0, $t1
+  li $t1, 1
+label22:
+  bnez $t0, label23
+  addi $v0, $t1, -1
+  jr $ra
+label23:
+  addi $t2, $t0, -1
+  add $t1, $t1, $t0
+  move $t0, $t2
+  j label22
+
+main:
+  addi $sp, $sp, -8
+  sw $ra, 4($sp)
+  sw $fp, 0($sp)
+  addi $fp, $sp, 8
+  jal read
+  move $s0, $v0
+  move $t0, $v0
+  move $t1, $zero
+label25:
+  beqz $t0, label27
+  addi $t2, $t0, -1
+  add $t1, $t1, $t0
+  move $t0, $t2
+  j label25
+label27:
+  move $a0, $t1
+  jal write
+  sll $t9, $s0, 2
+  subu $t9, $t9, $s0
+  sll $t0, $t9, 1
+  li $t1, 36
+label28:
+  beqz $t1, label30
+  div $t0, $t1
+  mflo $t2
+  mul $t2, $t2, $t1
+  sub $t2, $t0, $t2
+  move $t0, $t1
+  move $t1, $t2
+  j label28
+label30:
+  move $a0, $t0
+  jal write
+  move $a0, $s0
+  jal isEven
+  move $a0, $v0
+  jal write
+  addi $s1, $s0, 1
+  li $t9, 100000
+  ble $s1, $t9, label31
+  move $a0, $s1
+  move $a1, $zero
+  jal collatz
+  move $s2, $v0
+  j label32
+label31:
+  move $a0, $s1
+  jal isEven
+  li $t8, 1
+  sub $s2, $t8, $v0
+label32:
+  move $a0, $s2
+  jal write
+  addi $a0, $s0, 7
+  move $a1, $zero
+  jal collatz
+  move $a0, $v0
+  jal write
+  li $t9, 274877907
+  mult $s0, $t9
+  mfhi $t9
+  sra $t9, $t9, 6
+  srl $t0, $t9, 31
+  addu $t0, $t9, $t0
+  addi $t0, $t0, 1
+  li $t1, 3
+  li $t2, 7
+label33:
+  bgtz $t0, label34
+  sll $t9, $t1, 2
+  subu $t9, $t9, $t1
+  sll $t9, $t9, 3
+  addu $t9, $t9, $t1
+  sll $t3, $t9, 2
+  add $a0, $t3, $t2
+  jal write
+  move $v0, $zero
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
+  jr $ra
+label34:
+  addi $t0, $t0, -1
+  move $t3, $t1
+  move $t1, $t2
+  move $t2, $t3
+  j label33
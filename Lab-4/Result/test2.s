@@ -21,153 +21,50 @@ write:
   jr $ra
 
 fact:
-  addi $sp, $sp, -4
-  sw $fp, 0($sp)
-  move $fp, $sp
-  addi $sp, $sp, -72
-  sw $t9, 68($sp)
-  sw $t8, 64($sp)
-  sw $s7, 60($sp)
-  sw $s6, 56($sp)
-  sw $s5, 52($sp)
-  sw $s4, 48($sp)
-  sw $s3, 44($sp)
-  sw $s2, 40($sp)
-  sw $s1, 36($sp)
-  sw $s0, 32($sp)
-  sw $t7, 28($sp)
-  sw $t6, 24($sp)
-  sw $t5, 20($sp)
-  sw $t4, 16($sp)
-  sw $t3, 12($sp)
-  sw $t2, 8($sp)
-  sw $t1, 4($sp)
-  sw $t0, 0($sp)
-  addi $sp, $sp, -16
-  move $t0, $a0
-  sw $t0, -76($fp)
-  lw $t1, -76($fp)
-  li $t2, 1
-  beq $t1, $t2, label1
-  lw $t3, -76($fp)
-  li $t4, 1
-  sub $t5, $t3, $t4
-  sw $t5, -80($fp)
-  lw $t6, -80($fp)
-  move $a0, $t6
-  addi $sp, $sp, -4
-  sw $ra, 0($sp)
-  jal fact
-  lw $ra, 0($sp)
-  addi $sp, $sp, 4
-  move $t7, $v0
-  sw $t7, -84($fp)
-  lw $s0, -76($fp)
-  lw $s1, -84($fp)
-  mul $s2, $s0, $s1
-  sw $s2, -88($fp)
-  lw $s3, -88($fp)
-  move $v0, $s3
-  addi $sp, $fp, -72
-  lw $t0, 0($sp)
-  lw $t1, 4($sp)
-  lw $t2, 8($sp)
-  lw $t3, 12($sp)
-  lw $t4, 16($sp)
-  lw $t5, 20($sp)
-  lw $t6, 24($sp)
-  lw $t7, 28($sp)
-  lw $s0, 32($sp)
-  lw $s1, 36($sp)
-  lw $s2, 40($sp)
-  lw $s3, 44($sp)
-  lw $s4, 48($sp)
-  lw $s5, 52($sp)
-  lw $s6, 56($sp)
-  lw $s7, 60($sp)
-  lw $t8, 64($sp)
-  lw $t9, 68($sp)
-  addi $sp, $sp, 72
-  lw $fp, 0($sp)
-  addi $sp, $sp, 4
+  addi $sp, $sp, -12
+  sw $ra, 8($sp)
+  sw $fp, 4($sp)
+  addi $fp, $sp, 12
+  sw $s0, -12($fp)
+  move $s0, $a0
+  li $t9, 1
+  bne $a0, $t9, label2
+  move $v0, $s0
+  lw $s0, -12($fp)
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
   jr $ra
-  j label3
-label1:
-  lw $s4, -76($fp)
-  move $v0, $s4
-  addi $sp, $fp, -72
-  lw $t0, 0($sp)
-  lw $t1, 4($sp)
-  lw $t2, 8($sp)
-  lw $t3, 12($sp)
-  lw $t4, 16($sp)
-  lw $t5, 20($sp)
-  lw $t6, 24($sp)
-  lw $t7, 28($sp)
-  lw $s0, 32($sp)
-  lw $s1, 36($sp)
-  lw $s2, 40($sp)
-  lw $s3, 44($sp)
-  lw $s4, 48($sp)
-  lw $s5, 52($sp)
-  lw $s6, 56($sp)
-  lw $s7, 60($sp)
-  lw $t8, 64($sp)
-  lw $t9, 68($sp)
-  addi $sp, $sp, 72
-  lw $fp, 0($sp)
-  addi $sp, $sp, 4
+label2:
+  addi $a0, $s0, -1
+  jal fact
+  mul $v0, $s0, $v0
+  lw $s0, -12($fp)
+  lw $ra, -4($fp)
+  move $sp, $fp
+  lw $fp, -8($sp)
   jr $ra
-label3:
 
 main:
-  addi $sp, $sp, -4
+  addi $sp, $sp, -8
+  sw $ra, 4($sp)
   sw $fp, 0($sp)
-  move $fp, $sp
-  addi $sp, $sp, -16
-  addi $sp, $sp, -4
-  sw $ra, 0($sp)
+  addi $fp, $sp, 8
   jal read
-  lw $ra, 0($sp)
-  addi $sp, $sp, 4
   move $t0, $v0
-  sw $t0, -4($fp)
-  lw $t1, -4($fp)
-  lw $t2, -8($fp)
-  move $t2, $t1
-  sw $t2, -8($fp)
-  lw $t3, -8($fp)
-  li $t4, 1
-  bgt $t3, $t4, label4
-  li $t5, 1
-  lw $t6, -12($fp)
-  move $t6, $t5
-  sw $t6, -12($fp)
-  j label6
-label4:
-  lw $t7, -8($fp)
-  move $a0, $t7
-  addi $sp, $sp, -4
-  sw $ra, 0($sp)
+  slti $t9, $v0, 2
+  bnez $t9, label5
+  move $a0, $t0
   jal fact
-  lw $ra, 0($sp)
-  addi $sp, $sp, 4
-  move $s0, $v0
-  sw $s0, -16($fp)
-  lw $s1, -16($fp)
-  lw $s2, -12($fp)
-  move $s2, $s1
-  sw $s2, -12($fp)
+  move $t0, $v0
+  j label6
+label5:
+  li $t0, 1
 label6:
-  lw $s3, -12($fp)
-  move $a0, $s3
-  addi $sp, $sp, -4
-  sw $ra, 0($sp)
+  move $a0, $t0
   jal write
-  lw $ra, 0($sp)
-  addi $sp, $sp, 4
   move $v0, $zero
+  lw $ra, -4($fp)
   move $sp, $fp
-  lw $fp, 0($sp)
-  addi $sp, $sp, 4
+  lw $fp, -8($sp)
   jr $ra
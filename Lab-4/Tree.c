@@ -1,13 +1,61 @@
+#include <stdlib.h>
 #include "Tree.h"
 #include "malloc.h"
 
-Node* createNode(char* name, NodeType nodeType, int lineno, int childNum, Node** children) {
-    Node* res = (Node*)malloc(sizeof(Node));
+// 内存池每块的大小和分配的对齐字节数
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 8
+
+// 内存池的块，块内按顺序分配，用完后再申请新块
+typedef struct ArenaBlock_ {
+    struct ArenaBlock_* next;   // 链接上一个申请的块
+    size_t used;                // 该块已分配的字节数
+    size_t size;                // 该块可分配的总字节数
+    char data[];
+} ArenaBlock;
+
+// 当前正在分配的块
+static ArenaBlock* arena = NULL;
+
+// 从内存池中分配一段空间，不需要单独释放
+void* treeAlloc(size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (arena == NULL || arena->used + size > arena->size) {
+        // 超过块大小的请求单独占用一块
+        size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + blockSize);
+        if (block == NULL) {
+            printf("Error: Out of memory.\n");
+            exit(1);
+        }
+        block->next = arena;
+        block->used = 0;
+        block->size = blockSize;
+        arena = block;
+    }
+    void* res = arena->data + arena->used;
+    arena->used += size;
+    return res;
+}
+
+// 释放整棵语法树占用的所有块
+void freeTree() {
+    while (arena != NULL) {
+        ArenaBlock* next = arena->next;
+        free(arena);
+        arena = next;
+    }
+}
+
+Node* createNode(char* name, NodeKind kind, NodeType nodeType, int lineno, int childNum, Node** children) {
+    Node* res = (Node*)treeAlloc(sizeof(Node));
     res->name = name;
+    res->kind = kind;
     res->nodeType = nodeType;
     res->lineno = lineno;
     res->childNum = childNum;
     res->children = children;
+    res->entry = NULL;
     // 空串可能会向上传递
     int nullFlag = 1;
     for (int i = 0; i < res->childNum; i++)
@@ -15,22 +15,72 @@ typedef enum {
     ENUM_LEX_OTHER
 } NodeType;
 
+// 树节点种类枚举，词法单元按记号区分，语法单元按产生式区分，语义分析和中间代码生成据此分派
+typedef enum {
+    // 词法单元
+    ENUM_TK_INT, ENUM_TK_FLOAT, ENUM_TK_ID, ENUM_TK_SEMI, ENUM_TK_COMMA,
+    ENUM_TK_ASSIGNOP, ENUM_TK_RELOP, ENUM_TK_PLUS, ENUM_TK_MINUS, ENUM_TK_STAR,
+    ENUM_TK_DIV, ENUM_TK_AND, ENUM_TK_OR, ENUM_TK_DOT, ENUM_TK_NOT, ENUM_TK_TYPE,
+    ENUM_TK_LP, ENUM_TK_RP, ENUM_TK_LB, ENUM_TK_RB, ENUM_TK_LC, ENUM_TK_RC,
+    ENUM_TK_STRUCT, ENUM_TK_RETURN, ENUM_TK_IF, ENUM_TK_ELSE, ENUM_TK_WHILE,
+    // 高层定义
+    ENUM_PROGRAM, ENUM_EXTDEFLIST,
+    ENUM_EXTDEF_VAR,        // Specifier ExtDecList SEMI
+    ENUM_EXTDEF_TYPE,       // Specifier SEMI
+    ENUM_EXTDEF_FUNDEC,     // Specifier FunDec SEMI
+    ENUM_EXTDEF_FUNDEF,     // Specifier FunDec CompSt
+    ENUM_EXTDECLIST,
+    // 类型描述符
+    ENUM_SPECIFIER_TYPE, ENUM_SPECIFIER_STRUCT,
+    ENUM_STRUCTSPECIFIER_DEF, ENUM_STRUCTSPECIFIER_TAG, ENUM_OPTTAG, ENUM_TAG,
+    // 声明符
+    ENUM_VARDEC_ID, ENUM_VARDEC_ARRAY, ENUM_FUNDEC, ENUM_VARLIST, ENUM_PARAMDEC,
+    // 语句
+    ENUM_COMPST, ENUM_STMTLIST,
+    ENUM_STMT_EXP, ENUM_STMT_COMPST, ENUM_STMT_RETURN,
+    ENUM_STMT_IF, ENUM_STMT_IF_ELSE, ENUM_STMT_WHILE,
+    // 局部定义
+    ENUM_DEFLIST, ENUM_DEF, ENUM_DECLIST, ENUM_DEC,
+    // 表达式
+    ENUM_EXP_ASSIGNOP, ENUM_EXP_AND, ENUM_EXP_OR, ENUM_EXP_RELOP,
+    ENUM_EXP_PLUS, ENUM_EXP_MINUS, ENUM_EXP_STAR, ENUM_EXP_DIV,
+    ENUM_EXP_PAREN,         // LP Exp RP
+    ENUM_EXP_NEG,           // MINUS Exp
+    ENUM_EXP_NOT,           // NOT Exp
+    ENUM_EXP_CALL,          // ID LP Args RP 或 ID LP RP
+    ENUM_EXP_INDEX,         // Exp LB Exp RB
+    ENUM_EXP_DOT,           // Exp DOT ID
+    ENUM_EXP_ID, ENUM_EXP_INT, ENUM_EXP_FLOAT,
+    ENUM_ARGS,
+    // 错误恢复产生的节点
+    ENUM_ERROR
+} NodeKind;
+
 // 树节点定义
+// 语义分析中使用的类型，这里只需要前向声明
+struct Entry_d;
+
 typedef struct Node_{
     char* name; // 节点名称
+    NodeKind kind;  // 节点种类
     NodeType nodeType;  // 节点类型
     int lineno; // 该节点对应语法/词法单元的行号
     union { // 该节点需要存储的值信息
-        char strVal[32];    // 定义成char*会报段错误，因为初始化Node时不会给指针分配指向的空间
+        char* strVal;   // 驻留后的字符串，见intern.h
         int intVal;
         float floatVal;
     };
     int childNum;   // 该节点的子节点个数
     struct Node_** children;  // 该节点的子节点数组
+    struct Entry_d* entry;  // 语义分析的标注：变量/函数的引用和定义节点对应的符号表条目
 } Node;
 
 // 树的创建、插入和遍历相关函数
-Node* createNode(char* name, NodeType nodeType, int lineno, int childNum, Node** children);
+Node* createNode(char* name, NodeKind kind, NodeType nodeType, int lineno, int childNum, Node** children);
 void printTree(Node* root, int depth);
 
+// 语法树的内存池，节点和子节点数组都从中分配，编译结束后一次性释放
+void* treeAlloc(size_t size);
+void freeTree();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include "cfg.h"
+
+extern int labelNo;
+
+// 标记编号到所在基本块的映射，按全局标记数分配，各函数共用
+static Block* labelBlock = NULL;
+static int labelCap = 0;
+// 标记编号到所在指令下标的映射，判断有没有向回跳转时使用
+static int* labelAt = NULL;
+static int labelAtCap = 0;
+
+// 控制流分析的统计信息
+static int cfgNum = 0;
+static int blockTotal = 0;
+static int edgeTotal = 0;
+static int unreachableTotal = 0;
+static int loopTotal = 0;
+static int maxLoopDepth = 0;
+
+static void computeRPO(CFG cfg);
+static void computeDominators(CFG cfg);
+static void findLoops(CFG cfg);
+
+// 返回从start处FUNC指令开始的函数的结束下标（下一条FUNC指令或指令末尾）
+int findFuncEnd(int start) {
+    int end = start + 1;
+    while (end < interCodeNum && interCodes[end].kind != FUNC_IR)
+        end++;
+    return end;
+}
+
+// 指令是否结束一个基本块（其后的指令是新基本块的首指令）
+static int endsBlock(InterCode code) {
+    return code->kind == GOTO_IR || code->kind == IF_GOTO_IR || code->kind == RETURN_IR;
+}
+
+/*
+* 下标范围[start, end)内是否有跳到前面（或者跳到本身）的标记的跳转，顺序执行只会向后，
+* 所以没有这样的跳转时控制流图中没有环，循环优化可以不建立控制流图
+*/
+int hasBackJump(int start, int end) {
+    if (labelAtCap < labelNo) {
+        labelAtCap = labelNo;
+        labelAt = (int*)realloc(labelAt, sizeof(int) * labelAtCap);
+    }
+    for (int i = start; i < end; i++)
+        if (interCodes[i].kind == LABEL_IR)
+            labelAt[interCodes[i].ops[0]->no] = i;
+    for (int i = start; i < end; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind == GOTO_IR && labelAt[code->ops[0]->no] <= i)
+            return 1;
+        if (code->kind == IF_GOTO_IR && labelAt[code->ops[2]->no] <= i)
+            return 1;
+    }
+    return 0;
+}
+
+// 为下标范围[start, end)内的函数划分基本块并建立前驱后继关系
+CFG buildCFG(int start, int end) {
+    CFG cfg = (CFG)malloc(sizeof(CFG_));
+    cfg->name = interCodes[start].ops[0]->name;
+    cfg->start = start;
+    cfg->end = end;
+    // 第一遍扫描统计基本块数：函数第一条指令、标记以及跳转和返回之后的指令都是首指令
+    int blockNum = 0;
+    for (int i = start; i < end; i++)
+        if (i == start || interCodes[i].kind == LABEL_IR || endsBlock(&interCodes[i-1]))
+            blockNum++;
+    cfg->blockNum = blockNum;
+    cfg->blocks = (Block)calloc(blockNum, sizeof(Block_));
+    if (labelCap < labelNo) {
+        labelCap = labelNo;
+        labelBlock = (Block*)realloc(labelBlock, sizeof(Block) * labelCap);
+    }
+    // 第二遍扫描记录每个基本块的范围以及标记所在的基本块
+    int no = -1;
+    for (int i = start; i < end; i++) {
+        if (i == start || interCodes[i].kind == LABEL_IR || endsBlock(&interCodes[i-1])) {
+            no++;
+            cfg->blocks[no].no = no;
+            cfg->blocks[no].start = i;
+            if (no > 0)
+                cfg->blocks[no-1].end = i;
+        }
+        if (interCodes[i].kind == LABEL_IR)
+            labelBlock[interCodes[i].ops[0]->no] = &cfg->blocks[no];
+    }
+    cfg->blocks[no].end = end;
+    // 根据每个基本块的最后一条指令连接后继
+    int edgeNum = 0;
+    for (int i = 0; i < blockNum; i++) {
+        Block block = &cfg->blocks[i];
+        InterCode last = &interCodes[block->end - 1];
+        if (last->kind == GOTO_IR)
+            block->succs[block->succNum++] = labelBlock[last->ops[0]->no];
+        else if (last->kind == IF_GOTO_IR) {
+            block->succs[block->succNum++] = labelBlock[last->ops[2]->no];
+            // 跳转目标恰好是下一块时只保留一条边
+            if (i + 1 < blockNum && block->succs[0] != &cfg->blocks[i+1])
+                block->succs[block->succNum++] = &cfg->blocks[i+1];
+        }
+        else if (last->kind != RETURN_IR && i + 1 < blockNum)
+            block->succs[block->succNum++] = &cfg->blocks[i+1];
+        for (int j = 0; j < block->succNum; j++)
+            block->succs[j]->predNum++;
+        edgeNum += block->succNum;
+    }
+    // 所有前驱数组放在一块连续空间中
+    cfg->preds = (Block*)malloc(sizeof(Block) * (edgeNum > 0 ? edgeNum : 1));
+    int offset = 0;
+    for (int i = 0; i < blockNum; i++) {
+        cfg->blocks[i].preds = cfg->preds + offset;
+        offset += cfg->blocks[i].predNum;
+        cfg->blocks[i].predNum = 0;
+    }
+    for (int i = 0; i < blockNum; i++) {
+        Block block = &cfg->blocks[i];
+        for (int j = 0; j < block->succNum; j++) {
+            Block succ = block->succs[j];
+            block->predIndex[j] = succ->predNum;
+            succ->preds[succ->predNum++] = block;
+        }
+    }
+    cfg->edgeNum = edgeNum;
+    computeRPO(cfg);
+    computeDominators(cfg);
+    findLoops(cfg);
+    return cfg;
+}
+
+// 把最终生成目标代码时的控制流图计入统计，优化过程中反复建立的控制流图不计入
+void recordCFGStats(CFG cfg) {
+    cfgNum++;
+    blockTotal += cfg->blockNum;
+    edgeTotal += cfg->edgeNum;
+    unreachableTotal += cfg->blockNum - cfg->rpoNum;
+    loopTotal += cfg->loopNum;
+    for (int i = 0; i < cfg->loopNum; i++)
+        if (cfg->loops[i].depth > maxLoopDepth)
+            maxLoopDepth = cfg->loops[i].depth;
+}
+
+// 用显式栈做深度优先遍历，得到可达基本块的逆后序
+static void computeRPO(CFG cfg) {
+    int blockNum = cfg->blockNum;
+    cfg->rpo = (Block*)malloc(sizeof(Block) * blockNum);
+    Block* stack = (Block*)malloc(sizeof(Block) * blockNum);
+    int* nextSucc = (int*)calloc(blockNum, sizeof(int));
+    for (int i = 0; i < blockNum; i++)
+        cfg->blocks[i].rpoNo = -1;
+    // 先记录后序，入栈时用rpoNo = -2标记已访问
+    int postNum = 0;
+    int top = 0;
+    stack[top++] = &cfg->blocks[0];
+    cfg->blocks[0].rpoNo = -2;
+    while (top > 0) {
+        Block block = stack[top-1];
+        if (nextSucc[block->no] < block->succNum) {
+            Block succ = block->succs[nextSucc[block->no]++];
+            if (succ->rpoNo == -1) {
+                succ->rpoNo = -2;
+                stack[top++] = succ;
+            }
+        }
+        else {
+            cfg->rpo[postNum++] = block;
+            top--;
+        }
+    }
+    // 后序反转即为逆后序
+    for (int i = 0; i < postNum / 2; i++) {
+        Block tmp = cfg->rpo[i];
+        cfg->rpo[i] = cfg->rpo[postNum-1-i];
+        cfg->rpo[postNum-1-i] = tmp;
+    }
+    for (int i = 0; i < postNum; i++)
+        cfg->rpo[i]->rpoNo = i;
+    cfg->rpoNum = postNum;
+    free(stack);
+    free(nextSucc);
+}
+
+// 沿着支配树向上找两个基本块的最近公共支配者
+static Block intersect(Block b1, Block b2) {
+    while (b1 != b2) {
+        while (b1->rpoNo > b2->rpoNo)
+            b1 = b1->idom;
+        while (b2->rpoNo > b1->rpoNo)
+            b2 = b2->idom;
+    }
+    return b1;
+}
+
+/*
+* Cooper-Harvey-Kennedy迭代算法计算直接支配者，按逆后序处理基本块通常两三轮就收敛
+* 然后建立支配树并给出先序和后序编号
+*/
+static void computeDominators(CFG cfg) {
+    for (int i = 0; i < cfg->blockNum; i++) {
+        cfg->blocks[i].idom = NULL;
+        cfg->blocks[i].domChild = NULL;
+        cfg->blocks[i].domSibling = NULL;
+        cfg->blocks[i].domPre = -1;
+        cfg->blocks[i].domPost = -1;
+    }
+    Block entry = cfg->rpo[0];
+    entry->idom = entry;
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 1; i < cfg->rpoNum; i++) {
+            Block block = cfg->rpo[i];
+            Block newIdom = NULL;
+            /*
+            * 从下标大的前驱开始求交：else if链的各分支按深度递增排列，汇合点的前驱很多，
+            * 先取最深的前驱，每次求交只需向上走几步，否则每个前驱都要从自己一直走到链首
+            */
+            for (int j = block->predNum - 1; j >= 0; j--) {
+                Block pred = block->preds[j];
+                if (pred->idom == NULL)
+                    continue;
+                newIdom = newIdom == NULL ? pred : intersect(pred, newIdom);
+            }
+            if (block->idom != newIdom) {
+                block->idom = newIdom;
+                changed = 1;
+            }
+        }
+    }
+    // 按逆后序的倒序插入子节点，使每个节点的子节点按逆后序排列
+    for (int i = cfg->rpoNum - 1; i > 0; i--) {
+        Block block = cfg->rpo[i];
+        block->domSibling = block->idom->domChild;
+        block->idom->domChild = block;
+    }
+    // 非递归地遍历支配树编号
+    Block* stack = (Block*)malloc(sizeof(Block) * (cfg->rpoNum + 1));
+    int top = 0;
+    int counter = 0;
+    stack[top++] = entry;
+    entry->domPre = counter++;
+    while (top > 0) {
+        Block block = stack[top-1];
+        // 找到下一个还没有访问的子节点
+        Block child = block->domChild;
+        while (child != NULL && child->domPre >= 0)
+            child = child->domSibling;
+        if (child != NULL) {
+            child->domPre = counter++;
+            stack[top++] = child;
+        }
+        else {
+            block->domPost = counter++;
+            top--;
+        }
+    }
+    free(stack);
+}
+
+// 判断基本块a是否支配基本块b（不可达的基本块不被任何块支配）
+int dominates(Block a, Block b) {
+    if (a->domPre < 0 || b->domPre < 0)
+        return 0;
+    return a->domPre <= b->domPre && b->domPost <= a->domPost;
+}
+
+// 循环inner是否就是loop或者嵌套在loop中
+int inLoop(Loop inner, Loop loop) {
+    for (; inner != NULL; inner = inner->parent)
+        if (inner == loop)
+            return 1;
+    return 0;
+}
+
+static int compareLoop(const void* a, const void* b) {
+    const Loop_* x = (const Loop_*)a;
+    const Loop_* y = (const Loop_*)b;
+    if (x->blockNum != y->blockNum)
+        return y->blockNum - x->blockNum;
+    return x->header->no - y->header->no;
+}
+
+/*
+* 识别自然循环：目标支配源的边是回边，从回边的源沿前驱反向搜索到循环头得到循环体
+* 自然循环要么嵌套要么不相交，按循环体从大到小依次覆盖每个基本块所在的循环，就得到最内层循环和嵌套关系
+*/
+static void findLoops(CFG cfg) {
+    cfg->loopNum = 0;
+    cfg->loops = NULL;
+    for (int i = 0; i < cfg->blockNum; i++) {
+        cfg->blocks[i].loop = NULL;
+        cfg->blocks[i].loopDepth = 0;
+    }
+    // 统计有回边进入的循环头
+    int* isHeader = (int*)calloc(cfg->blockNum, sizeof(int));
+    for (int i = 0; i < cfg->rpoNum; i++) {
+        Block block = cfg->rpo[i];
+        for (int j = 0; j < block->succNum; j++)
+            if (dominates(block->succs[j], block) && !isHeader[block->succs[j]->no]) {
+                isHeader[block->succs[j]->no] = 1;
+                cfg->loopNum++;
+            }
+    }
+    if (cfg->loopNum == 0) {
+        free(isHeader);
+        return;
+    }
+    cfg->loops = (Loop)calloc(cfg->loopNum, sizeof(Loop_));
+    int* mark = (int*)malloc(sizeof(int) * cfg->blockNum);
+    for (int i = 0; i < cfg->blockNum; i++)
+        mark[i] = -1;
+    Block* work = (Block*)malloc(sizeof(Block) * cfg->blockNum);
+    int n = 0;
+    for (int i = 0; i < cfg->rpoNum; i++) {
+        Block header = cfg->rpo[i];
+        if (!isHeader[header->no])
+            continue;
+        Loop loop = &cfg->loops[n];
+        loop->header = header;
+        // 循环体先收集到work中，最后再复制出来
+        int count = 0;
+        mark[header->no] = n;
+        work[count++] = header;
+        int next = 1;
+        for (int j = 0; j < header->predNum; j++) {
+            Block pred = header->preds[j];
+            if (dominates(header, pred) && mark[pred->no] != n) {
+                mark[pred->no] = n;
+                work[count++] = pred;
+            }
+        }
+        while (next < count) {
+            Block block = work[next++];
+            for (int j = 0; j < block->predNum; j++) {
+                Block pred = block->preds[j];
+                if (pred->rpoNo >= 0 && mark[pred->no] != n) {
+                    mark[pred->no] = n;
+                    work[count++] = pred;
+                }
+            }
+        }
+        loop->blockNum = count;
+        loop->blocks = (Block*)malloc(sizeof(Block) * count);
+        for (int j = 0; j < count; j++)
+            loop->blocks[j] = work[j];
+        n++;
+    }
+    qsort(cfg->loops, cfg->loopNum, sizeof(Loop_), compareLoop);
+    for (int i = 0; i < cfg->loopNum; i++) {
+        Loop loop = &cfg->loops[i];
+        loop->parent = loop->header->loop;
+        loop->depth = loop->parent == NULL ? 1 : loop->parent->depth + 1;
+        for (int j = 0; j < loop->blockNum; j++) {
+            loop->blocks[j]->loop = loop;
+            loop->blocks[j]->loopDepth = loop->depth;
+        }
+    }
+    free(isHeader);
+    free(mark);
+    free(work);
+}
+
+void freeCFG(CFG cfg) {
+    if (cfg == NULL)
+        return;
+    for (int i = 0; i < cfg->loopNum; i++)
+        free(cfg->loops[i].blocks);
+    free(cfg->loops);
+    free(cfg->rpo);
+    free(cfg->blocks);
+    free(cfg->preds);
+    free(cfg);
+}
+
+// 打印控制流分析的统计信息
+void printCFGStats(FILE* fp) {
+    fprintf(fp, "cfg: %d functions, %d blocks (%d unreachable), %d edges\n", cfgNum, blockTotal, unreachableTotal, edgeTotal);
+    fprintf(fp, "cfg: %d natural loops, max nesting depth %d\n", loopTotal, maxLoopDepth);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef CFG_H
+#define CFG_H
+
+#include "intercode.h"
+
+typedef struct Block_d Block_;
+typedef Block_* Block;
+typedef struct CFG_d CFG_;
+typedef CFG_* CFG;
+typedef struct Loop_d Loop_;
+typedef Loop_* Loop;
+
+// 基本块，对应interCodes中下标为[start, end)的一段指令
+struct Block_d {
+    int no;         // 基本块在函数中的编号，按指令顺序排列
+    int start;
+    int end;
+    int succNum;    // 后继块数，最多两个：跳转目标和顺序执行的下一块
+    Block succs[2];
+    int predNum;    // 前驱块数
+    Block* preds;
+    int predIndex[2];   // 本块在第k个后继的前驱数组中的下标，PHI指令按这个下标取参数
+    int rpoNo;      // 逆后序编号，-1表示从入口不可达
+    Block idom;     // 直接支配者，入口块的直接支配者是它自己
+    Block domChild;     // 支配树中的第一个子节点
+    Block domSibling;   // 支配树中的下一个兄弟节点
+    int domPre;     // 支配树的先序和后序编号，用于在常数时间内判断支配关系
+    int domPost;
+    Loop loop;      // 所在的最内层循环，不在循环中时为NULL
+    int loopDepth;  // 循环嵌套深度，不在循环中时为0
+};
+
+// 自然循环，同一个循环头的所有回边合并为一个循环
+struct Loop_d {
+    Block header;   // 循环头
+    Loop parent;    // 直接外层循环
+    int depth;      // 嵌套深度，最外层为1
+    int blockNum;   // 循环体中的基本块（包含循环头）
+    Block* blocks;
+};
+
+// 单个函数的控制流图
+struct CFG_d {
+    char* name;     // 函数名（驻留字符串）
+    int start;      // 函数在interCodes中的下标范围[start, end)，start处是FUNC指令
+    int end;
+    int blockNum;
+    int edgeNum;
+    Block blocks;   // 按指令顺序存放的基本块数组，blocks[0]是入口块
+    Block* preds;   // 所有基本块的前驱数组共用的存储空间
+    int rpoNum;     // 可达基本块数
+    Block* rpo;     // 按逆后序排列的可达基本块
+    int loopNum;
+    Loop loops;     // 按循环体从大到小排列，外层循环总在内层循环之前
+};
+
+int findFuncEnd(int start);
+int hasBackJump(int start, int end);
+CFG buildCFG(int start, int end);
+void recordCFGStats(CFG cfg);
+void freeCFG(CFG cfg);
+int dominates(Block a, Block b);
+int inLoop(Loop inner, Loop loop);
+void printCFGStats(FILE* fp);
+
+#endif
\ No newline at end of file
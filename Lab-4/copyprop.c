@@ -0,0 +1,122 @@
+#include "copyprop.h"
+
+extern int tmpVarNo;
+
+// 拷贝传播的统计信息
+static int copyTotal = 0;
+static int phiTotal = 0;
+
+// 被拷贝替代的值最终对应的值，没有被替代时为NULL
+static Operand* repl = NULL;
+
+// 沿替代链找到最终的值，并压缩路径
+static Operand resolve(Operand op) {
+    Operand root = op;
+    while (valueNo(root) >= 0 && repl[valueNo(root)] != NULL)
+        root = repl[valueNo(root)];
+    while (op != root) {
+        Operand next = repl[valueNo(op)];
+        repl[valueNo(op)] = root;
+        op = next;
+    }
+    return root;
+}
+
+// 使用处的操作数换成最终的值，解引用的地址换名时生成新的操作数
+static Operand replaceUse(Operand op) {
+    if (op == NULL)
+        return NULL;
+    if (op->kind == GET_VAL_OP && valueNo(op->opr) >= 0) {
+        Operand value = resolve(op->opr);
+        if (value == op->opr)
+            return op;
+        Operand val = allocOperand();
+        val->kind = GET_VAL_OP;
+        val->opr = value;
+        return val;
+    }
+    return resolve(op);
+}
+
+// PHI的参数除了结果自身以外都是同一个值时返回该值，否则返回NULL
+static Operand trivialPhi(InterCode code) {
+    int v = valueNo(code->ops[0]);
+    Operand same = NULL;
+    for (int j = 0; j < code->argNum; j++) {
+        // 某条路径上没有定值时替换会破坏支配关系
+        if (code->args[j] == NULL)
+            return NULL;
+        Operand arg = resolve(code->args[j]);
+        int a = valueNo(arg);
+        if (a < 0)
+            return NULL;
+        if (a == v)
+            continue;
+        if (same != NULL && valueNo(same) != a)
+            return NULL;
+        same = arg;
+    }
+    return same;
+}
+
+/*
+* SSA形式上的全局拷贝传播：值之间的拷贝x := y以及参数都相同的PHI都被删除，x的全部使用换成y
+* y的定值支配x的定值，因此也支配x的全部使用，替换跨越标记和跳转也是安全的
+* 常量的拷贝已由常量传播处理，这里只传播SSA值；离开SSA时替换后的值和原变量的其他版本再合并回同一个名字
+* 返回删除的拷贝和PHI数
+*/
+int propagateCopies() {
+    int valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0)
+        return 0;
+    repl = (Operand*)calloc(valueCount, sizeof(Operand));
+    // 删除一个PHI可能使另一个PHI的参数变得相同，重复到不再变化
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 0; i < interCodeNum; i++) {
+            InterCode code = &interCodes[i];
+            if (code->kind != ASSIGN_IR && code->kind != PHI_IR)
+                continue;
+            int v = valueNo(code->ops[0]);
+            if (v < 0 || repl[v] != NULL)
+                continue;
+            Operand src = code->kind == ASSIGN_IR ? resolve(code->ops[1]) : trivialPhi(code);
+            if (src == NULL || valueNo(src) < 0 || valueNo(src) == v)
+                continue;
+            repl[v] = src;
+            changed = 1;
+        }
+    }
+    int copies = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+        if (v >= 0 && repl[v] != NULL) {
+            if (code->kind == PHI_IR)
+                phiTotal++;
+            else
+                copyTotal++;
+            code->kind = NULL_IR;
+            copies++;
+            continue;
+        }
+        if (code->kind == PHI_IR) {
+            for (int j = 0; j < code->argNum; j++)
+                code->args[j] = replaceUse(code->args[j]);
+            continue;
+        }
+        for (int k = definesOp(code); k < 3; k++)
+            code->ops[k] = replaceUse(code->ops[k]);
+    }
+    if (copies > 0)
+        compactCodes();
+    free(repl);
+    repl = NULL;
+    return copies;
+}
+
+// 打印拷贝传播的统计信息
+void printCopyStats(FILE* fp) {
+    fprintf(fp, "copy: %d copies and %d trivial phis propagated\n", copyTotal, phiTotal);
+}
@@ -0,0 +1,9 @@
+#ifndef COPYPROP_H
+#define COPYPROP_H
+
+#include "ssa.h"
+
+int propagateCopies();
+void printCopyStats(FILE* fp);
+
+#endif
@@ -0,0 +1,119 @@
+#include "dce.h"
+
+extern int tmpVarNo;
+
+// 死代码删除的统计信息
+static int deadTotal = 0;
+static int deadPhiTotal = 0;
+static int deadResultTotal = 0;
+
+static char* live = NULL;
+static int* defAt = NULL;
+static int* work = NULL;
+static int workTop = 0;
+static int valueCount = 0;
+
+// 标记操作数（包括解引用的地址）读取的值为活跃
+static void markUse(Operand op) {
+    if (op == NULL)
+        return;
+    if (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP)
+        op = op->opr;
+    int v = valueNo(op);
+    if (v >= 0 && v < valueCount && !live[v]) {
+        live[v] = 1;
+        work[workTop++] = v;
+    }
+}
+
+static void markUses(InterCode code) {
+    if (code->kind == PHI_IR) {
+        for (int j = 0; j < code->argNum; j++)
+            markUse(code->args[j]);
+        return;
+    }
+    for (int k = definesOp(code); k < 3; k++)
+        markUse(code->ops[k]);
+}
+
+// 指令是否有定值以外的作用：控制流、调用、输入输出、写内存以及对不参与SSA的变量赋值
+static int isCritical(InterCode code) {
+    switch (code->kind) {
+        case ASSIGN_IR:
+        case PLUS_IR:
+        case SUB_IR:
+        case MUL_IR:
+        case DIV_IR:
+            return code->ops[0] != NULL && valueNo(code->ops[0]) < 0;
+        case PHI_IR:
+        case NULL_IR:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+/*
+* SSA形式上的死代码删除：从有副作用的指令出发，沿定值-使用关系反向标记活跃的值，
+* 没有被标记的运算、拷贝和PHI都被删除，调用和读入的结果不活跃时只去掉存放结果的操作数
+* 一遍标记就能删除互相使用但都没有被有用指令使用的指令，包括循环中的PHI环，返回删除的指令数
+*/
+int eliminateDeadCode() {
+    valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0)
+        return 0;
+    live = (char*)calloc(valueCount, 1);
+    defAt = (int*)malloc(sizeof(int) * valueCount);
+    work = (int*)malloc(sizeof(int) * valueCount);
+    workTop = 0;
+    for (int v = 0; v < valueCount; v++)
+        defAt[v] = -1;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+        if (v >= 0 && v < valueCount)
+            defAt[v] = i;
+    }
+    for (int i = 0; i < interCodeNum; i++)
+        if (isCritical(&interCodes[i]))
+            markUses(&interCodes[i]);
+    while (workTop > 0) {
+        int v = work[--workTop];
+        if (defAt[v] >= 0)
+            markUses(&interCodes[defAt[v]]);
+    }
+    int removed = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+        if (v >= 0 && v < valueCount && live[v])
+            continue;
+        if (code->kind == CALL_IR || code->kind == READ_IR) {
+            if (v >= 0) {
+                code->ops[0] = NULL;
+                deadResultTotal++;
+            }
+            continue;
+        }
+        if (isCritical(code))
+            continue;
+        if (code->kind == PHI_IR)
+            deadPhiTotal++;
+        else
+            deadTotal++;
+        code->kind = NULL_IR;
+        removed++;
+    }
+    if (removed > 0)
+        compactCodes();
+    free(live);
+    free(defAt);
+    free(work);
+    return removed;
+}
+
+// 打印死代码删除的统计信息
+void printDCEStats(FILE* fp) {
+    fprintf(fp, "dce: %d dead codes and %d dead phis removed, %d unused call results dropped\n",
+        deadTotal, deadPhiTotal, deadResultTotal);
+}
@@ -0,0 +1,9 @@
+#ifndef DCE_H
+#define DCE_H
+
+#include "ssa.h"
+
+int eliminateDeadCode();
+void printDCEStats(FILE* fp);
+
+#endif
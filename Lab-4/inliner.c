@@ -0,0 +1,449 @@
+#include "inliner.h"
+
+extern int tmpVarNo;
+extern int labelNo;
+
+// 不超过INLINE_SMALL条指令的函数在每个调用点展开，只有一个调用点的函数不超过INLINE_SINGLE条时展开
+#define INLINE_SMALL 16
+#define INLINE_SINGLE 200
+// 调用者展开后超过这个规模就不再向它展开
+#define INLINE_CALLER_MAX 3000
+
+// 内联展开的统计信息
+static int inlineTotal = 0;
+static int removeTotal = 0;
+static int recursiveTotal = 0;
+static int tailTotal = 0;
+
+// 函数的指令单独存放，按调用图自底向上逐个展开
+typedef struct FuncInfo_d {
+    char* name;
+    InterCode codes;
+    int codeNum;
+    int size;       // 除FUNC、PARAM、DEC和标记以外的指令数
+    int sites;      // 展开前的调用点数
+    int recursive;  // 在调用图的环上（包括调用自己），不展开
+    int index;      // Tarjan算法中的访问次序和能到达的最小次序
+    int low;
+    int onStack;
+} FuncInfo;
+
+static FuncInfo* funcs = NULL;
+static int funcNum = 0;
+static int* funcTable = NULL;
+static int funcTableSize = 0;
+
+// 展开一次调用时被调用函数的临时变量、标记和变量到新名字的映射，临时变量和标记按编号打戳
+static Operand* tempMap = NULL;
+static int* tempStamp = NULL;
+static int tempCap = 0;
+static Operand* labelMap = NULL;
+static int* labelStamp = NULL;
+static int labelCap = 0;
+static int stamp = 0;
+static char** varNames = NULL;
+static Operand* varOps = NULL;
+static int varNum = 0;
+static int varCap = 0;
+
+static unsigned int nameHash(char* name) {
+    return (unsigned int)(((size_t)name >> 3) * 2654435761u);
+}
+
+// 按函数名（驻留字符串）查找函数，找不到时返回-1
+static int findFunc(char* name) {
+    unsigned int mask = (unsigned int)funcTableSize - 1;
+    for (unsigned int h = nameHash(name) & mask; funcTable[h] >= 0; h = (h + 1) & mask)
+        if (funcs[funcTable[h]].name == name)
+            return funcTable[h];
+    return -1;
+}
+
+static int calleeOf(InterCode code) {
+    return code->kind == CALL_IR ? findFunc(code->ops[1]->name) : -1;
+}
+
+static int codeSize(InterCode codes, int num) {
+    int size = 0;
+    for (int i = 0; i < num; i++)
+        if (codes[i].kind != FUNC_IR && codes[i].kind != PARAM_IR && codes[i].kind != DEC_IR && codes[i].kind != LABEL_IR)
+            size++;
+    return size;
+}
+
+static void emitCode(int kind, Operand a, Operand b) {
+    InterCode_ code;
+    memset(&code, 0, sizeof(InterCode_));
+    code.kind = kind;
+    code.ops[0] = a;
+    code.ops[1] = b;
+    emitInterCode(&code);
+}
+
+// 用重写得到的指令序列替换函数f原来的指令
+static void finishFunc(FuncInfo* f) {
+    InterCode saved = interCodes;
+    int savedNum = interCodeNum;
+    interCodes = f->codes;
+    finishRewrite();
+    f->codes = interCodes;
+    f->codeNum = interCodeNum;
+    interCodes = saved;
+    interCodeNum = savedNum;
+}
+
+// i处是否是对函数自己的尾调用：CALL之后紧跟RETURN调用结果，且实参个数与形参相同
+static int selfTailCall(FuncInfo* f, int i, int params) {
+    InterCode code = &f->codes[i];
+    if (code->kind != CALL_IR || code->ops[1]->name != f->name || code->ops[0] == NULL || i + 1 >= f->codeNum)
+        return 0;
+    Operand ret = f->codes[i+1].ops[0];
+    if (f->codes[i+1].kind != RETURN_IR || ret == NULL || ret->kind != code->ops[0]->kind)
+        return 0;
+    if (ret != code->ops[0] && (ret->kind != TEMP_VAR_OP || ret->no != code->ops[0]->no))
+        return 0;
+    int argNum = 0;
+    while (i - argNum - 1 >= 0 && f->codes[i-argNum-1].kind == ARG_IR)
+        argNum++;
+    return argNum == params;
+}
+
+/*
+* 自身的尾递归改为循环：在PARAM之后放一个入口标记，尾调用处先把实参存入新的临时变量，
+* 再赋给形参（实参可能引用形参），然后跳回入口。有DEC的函数不处理，实参可能是本层数组的地址
+*/
+static void removeTailRecursion(FuncInfo* f) {
+    int params = 0;
+    while (params + 1 < f->codeNum && f->codes[params+1].kind == PARAM_IR)
+        params++;
+    int found = 0;
+    for (int i = 0; i < f->codeNum; i++) {
+        if (f->codes[i].kind == DEC_IR)
+            return;
+        found |= selfTailCall(f, i, params);
+    }
+    if (!found)
+        return;
+    Operand entry = newLabel();
+    beginRewrite(f->codeNum + params + 1);
+    for (int i = 0; i <= params; i++)
+        emitInterCode(&f->codes[i]);
+    emitCode(LABEL_IR, entry, NULL);
+    Operand* temps = (Operand*)malloc(sizeof(Operand) * (params > 0 ? params : 1));
+    int i = params + 1;
+    while (i < f->codeNum) {
+        // ARG指令之后紧跟着CALL
+        int call = i;
+        while (call < f->codeNum && f->codes[call].kind == ARG_IR)
+            call++;
+        if (call == f->codeNum || !selfTailCall(f, call, params)) {
+            for (int j = i; j <= call && j < f->codeNum; j++)
+                emitInterCode(&f->codes[j]);
+            i = call + 1;
+            continue;
+        }
+        for (int k = 0; k < params; k++) {
+            temps[k] = newTemp();
+            emitCode(ASSIGN_IR, temps[k], f->codes[call-1-k].ops[0]);
+        }
+        for (int k = 0; k < params; k++)
+            emitCode(ASSIGN_IR, f->codes[k+1].ops[0], temps[k]);
+        emitCode(GOTO_IR, entry, NULL);
+        tailTotal++;
+        // 跳过紧跟的RETURN
+        i = call + 2;
+    }
+    free(temps);
+    finishFunc(f);
+}
+
+// 把指令数组按函数拆开，建立函数名的散列表并统计调用点数
+static void splitFuncs() {
+    funcNum = 0;
+    for (int i = 0; i < interCodeNum; i++)
+        if (interCodes[i].kind == FUNC_IR)
+            funcNum++;
+    funcs = (FuncInfo*)calloc(funcNum > 0 ? funcNum : 1, sizeof(FuncInfo));
+    funcTableSize = 16;
+    while (funcTableSize < 2 * funcNum)
+        funcTableSize *= 2;
+    funcTable = (int*)malloc(sizeof(int) * funcTableSize);
+    for (int h = 0; h < funcTableSize; h++)
+        funcTable[h] = -1;
+    int n = 0;
+    for (int start = 0; start < interCodeNum; ) {
+        int end = start + 1;
+        while (end < interCodeNum && interCodes[end].kind != FUNC_IR)
+            end++;
+        FuncInfo* f = &funcs[n];
+        f->name = interCodes[start].ops[0]->name;
+        f->codeNum = end - start;
+        f->codes = (InterCode)malloc(sizeof(InterCode_) * f->codeNum);
+        memcpy(f->codes, interCodes + start, sizeof(InterCode_) * f->codeNum);
+        removeTailRecursion(f);
+        f->size = codeSize(f->codes, f->codeNum);
+        f->index = -1;
+        unsigned int mask = (unsigned int)funcTableSize - 1;
+        unsigned int h = nameHash(f->name) & mask;
+        while (funcTable[h] >= 0)
+            h = (h + 1) & mask;
+        funcTable[h] = n++;
+        start = end;
+    }
+    for (int f = 0; f < funcNum; f++)
+        for (int i = 0; i < funcs[f].codeNum; i++) {
+            int g = calleeOf(&funcs[f].codes[i]);
+            if (g >= 0)
+                funcs[g].sites++;
+        }
+}
+
+/*
+* 用非递归的Tarjan算法求调用图的强连通分量，分量按被调用者在前的顺序写入order，
+* 多于一个函数的分量以及调用自己的函数都是递归的
+*/
+static void orderFuncs(int* order) {
+    int* stack = (int*)malloc(sizeof(int) * funcNum);
+    int* callStack = (int*)malloc(sizeof(int) * funcNum);
+    int* nextCode = (int*)malloc(sizeof(int) * funcNum);
+    int top = 0, orderNum = 0, counter = 0;
+    for (int root = 0; root < funcNum; root++) {
+        if (funcs[root].index >= 0)
+            continue;
+        int depth = 0;
+        callStack[depth++] = root;
+        nextCode[root] = 0;
+        funcs[root].index = funcs[root].low = counter++;
+        funcs[root].onStack = 1;
+        stack[top++] = root;
+        while (depth > 0) {
+            int f = callStack[depth-1];
+            FuncInfo* info = &funcs[f];
+            // 继续扫描f中下一个调用
+            int g = -1;
+            while (nextCode[f] < info->codeNum && g < 0)
+                g = calleeOf(&info->codes[nextCode[f]++]);
+            if (g >= 0) {
+                if (g == f)
+                    info->recursive = 1;
+                if (funcs[g].index < 0) {
+                    funcs[g].index = funcs[g].low = counter++;
+                    funcs[g].onStack = 1;
+                    stack[top++] = g;
+                    nextCode[g] = 0;
+                    callStack[depth++] = g;
+                }
+                else if (funcs[g].onStack && funcs[g].index < info->low)
+                    info->low = funcs[g].index;
+                continue;
+            }
+            depth--;
+            if (depth > 0 && info->low < funcs[callStack[depth-1]].low)
+                funcs[callStack[depth-1]].low = info->low;
+            if (info->low != info->index)
+                continue;
+            // f是分量的根，弹出整个分量
+            int first = orderNum;
+            int h;
+            do {
+                h = stack[--top];
+                funcs[h].onStack = 0;
+                order[orderNum++] = h;
+            } while (h != f);
+            if (orderNum - first > 1)
+                for (int k = first; k < orderNum; k++)
+                    funcs[order[k]].recursive = 1;
+        }
+    }
+    for (int f = 0; f < funcNum; f++)
+        recursiveTotal += funcs[f].recursive;
+    free(stack);
+    free(callStack);
+    free(nextCode);
+}
+
+static Operand renameOp(Operand op, int instance) {
+    if (op == NULL)
+        return NULL;
+    switch (op->kind) {
+        case VARIABLE_OP: {
+            for (int k = 0; k < varNum; k++)
+                if (varNames[k] == op->name)
+                    return varOps[k];
+            if (varNum == varCap) {
+                varCap = varCap > 0 ? varCap * 2 : 16;
+                varNames = (char**)realloc(varNames, sizeof(char*) * varCap);
+                varOps = (Operand*)realloc(varOps, sizeof(Operand) * varCap);
+            }
+            // 变量名都以v开头，展开出的变量以i开头，不会和原有的变量重名
+            char buf[32];
+            snprintf(buf, sizeof(buf), "i%d_", instance);
+            Operand var = allocOperand();
+            *var = *op;
+            var->name = internConcat(buf, op->name);
+            varNames[varNum] = op->name;
+            varOps[varNum++] = var;
+            return var;
+        }
+        case TEMP_VAR_OP:
+            if (tempStamp[op->no] != stamp) {
+                tempStamp[op->no] = stamp;
+                tempMap[op->no] = newTemp();
+            }
+            return tempMap[op->no];
+        case LABEL_OP:
+            if (labelStamp[op->no] != stamp) {
+                labelStamp[op->no] = stamp;
+                labelMap[op->no] = newLabel();
+            }
+            return labelMap[op->no];
+        case GET_ADDR_OP:
+        case GET_VAL_OP: {
+            Operand wrap = allocOperand();
+            *wrap = *op;
+            wrap->opr = renameOp(op->opr, instance);
+            return wrap;
+        }
+        default:
+            return op;
+    }
+}
+
+// 映射表按当前的临时变量和标记总数扩大，被调用函数中可能有先前展开时新建的临时变量和标记
+static void growMaps() {
+    if (tempCap < tmpVarNo) {
+        int cap = tempCap * 2 > tmpVarNo ? tempCap * 2 : tmpVarNo;
+        tempMap = (Operand*)realloc(tempMap, sizeof(Operand) * cap);
+        tempStamp = (int*)realloc(tempStamp, sizeof(int) * cap);
+        for (int i = tempCap; i < cap; i++)
+            tempStamp[i] = 0;
+        tempCap = cap;
+    }
+    if (labelCap < labelNo) {
+        int cap = labelCap * 2 > labelNo ? labelCap * 2 : labelNo;
+        labelMap = (Operand*)realloc(labelMap, sizeof(Operand) * cap);
+        labelStamp = (int*)realloc(labelStamp, sizeof(int) * cap);
+        for (int i = labelCap; i < cap; i++)
+            labelStamp[i] = 0;
+        labelCap = cap;
+    }
+}
+
+/*
+* 在调用点展开函数g：参数变量换名后用ARG的操作数赋初值（离CALL最近的ARG是第一个参数），
+* 函数体中的变量、临时变量和标记都换成新的名字，RETURN改为给调用结果赋值并跳到展开代码的末尾
+*/
+static void expandCall(InterCode args, int argNum, InterCode call, FuncInfo* g) {
+    growMaps();
+    stamp++;
+    varNum = 0;
+    int instance = ++inlineTotal;
+    int k = 0;
+    for (int i = 1; i < g->codeNum && g->codes[i].kind == PARAM_IR; i++, k++)
+        emitCode(ASSIGN_IR, renameOp(g->codes[i].ops[0], instance), args[argNum-1-k].ops[0]);
+    Operand end = NULL;
+    for (int i = k + 1; i < g->codeNum; i++) {
+        InterCode code = &g->codes[i];
+        if (code->kind == RETURN_IR) {
+            if (call->ops[0] != NULL)
+                emitCode(ASSIGN_IR, call->ops[0], renameOp(code->ops[0], instance));
+            if (i + 1 < g->codeNum) {
+                if (end == NULL)
+                    end = newLabel();
+                emitCode(GOTO_IR, end, NULL);
+            }
+            continue;
+        }
+        InterCode copy = emitInterCode(code);
+        for (int j = 0; j < 3; j++)
+            copy->ops[j] = renameOp(copy->ops[j], instance);
+    }
+    if (end != NULL)
+        emitCode(LABEL_IR, end, NULL);
+}
+
+// 调用点是否展开：被调用者不递归、不是main，规模足够小，且调用者展开后不会过大
+static int shouldInline(FuncInfo* f, int g) {
+    if (g < 0 || &funcs[g] == f || funcs[g].recursive || strcmp(funcs[g].name, "main") == 0)
+        return 0;
+    if (f->size + funcs[g].size > INLINE_CALLER_MAX)
+        return 0;
+    return funcs[g].size <= INLINE_SMALL || (funcs[g].sites == 1 && funcs[g].size <= INLINE_SINGLE);
+}
+
+static void inlineInto(FuncInfo* f) {
+    beginRewrite(f->codeNum);
+    int i = 0;
+    while (i < f->codeNum) {
+        InterCode code = &f->codes[i];
+        if (code->kind != ARG_IR && code->kind != CALL_IR) {
+            emitInterCode(code);
+            i++;
+            continue;
+        }
+        // ARG指令之后紧跟着CALL
+        int call = i;
+        while (call < f->codeNum && f->codes[call].kind == ARG_IR)
+            call++;
+        int g = call < f->codeNum ? calleeOf(&f->codes[call]) : -1;
+        if (shouldInline(f, g)) {
+            expandCall(&f->codes[i], call - i, &f->codes[call], &funcs[g]);
+            f->size += funcs[g].size;
+        }
+        else
+            for (int j = i; j <= call && j < f->codeNum; j++)
+                emitInterCode(&f->codes[j]);
+        i = call + 1;
+    }
+    finishFunc(f);
+}
+
+/*
+* 中间代码层次的内联展开：先把自身的尾递归改成循环，再按调用图自底向上处理，被调用者先展开它自己的调用，再被展开到调用者中，
+* 递归的函数不展开，所有调用点都被展开的函数（main除外）整个删除，展开后的代码由后面的优化按调用者的上下文化简
+*/
+void inlineCalls() {
+    if (interCodeNum == 0 || interCodes[0].kind != FUNC_IR)
+        return;
+    splitFuncs();
+    int* order = (int*)malloc(sizeof(int) * funcNum);
+    orderFuncs(order);
+    for (int k = 0; k < funcNum; k++)
+        inlineInto(&funcs[order[k]]);
+    // 重新统计调用点，删除展开后不再被调用的函数
+    int* calls = (int*)calloc(funcNum, sizeof(int));
+    int total = 0;
+    for (int f = 0; f < funcNum; f++) {
+        for (int i = 0; i < funcs[f].codeNum; i++) {
+            int g = calleeOf(&funcs[f].codes[i]);
+            if (g >= 0)
+                calls[g]++;
+        }
+        total += funcs[f].codeNum;
+    }
+    free(interCodes);
+    interCodes = (InterCode)malloc(sizeof(InterCode_) * (total > 0 ? total : 1));
+    interCodeNum = 0;
+    for (int f = 0; f < funcNum; f++) {
+        if (funcs[f].sites > 0 && calls[f] == 0 && strcmp(funcs[f].name, "main") != 0)
+            removeTotal++;
+        else {
+            memcpy(interCodes + interCodeNum, funcs[f].codes, sizeof(InterCode_) * funcs[f].codeNum);
+            interCodeNum += funcs[f].codeNum;
+        }
+        free(funcs[f].codes);
+    }
+    free(calls);
+    free(order);
+    free(funcs);
+    free(funcTable);
+    funcs = NULL;
+    funcTable = NULL;
+}
+
+// 打印内联展开的统计信息
+void printInlineStats(FILE* fp) {
+    fprintf(fp, "inline: %d call sites inlined, %d functions removed, %d recursive functions kept\n",
+        inlineTotal, removeTotal, recursiveTotal);
+    fprintf(fp, "inline: %d self tail calls turned into jumps\n", tailTotal);
+}
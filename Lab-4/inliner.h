@@ -0,0 +1,9 @@
+#ifndef INLINER_H
+#define INLINER_H
+
+#include "intercode.h"
+
+void inlineCalls();
+void printInlineStats(FILE* fp);
+
+#endif
@@ -1,10 +1,33 @@
 #include "intercode.h"
+#include "simplify.h"
 
-extern Entry symbolTable[HASH_SIZE];
-extern Entry layersHead;
+// 压缩后连续存放的指令数组，翻译完成后由compactInterCodes生成，后端按下标顺序遍历
+InterCode interCodes = NULL;
+int interCodeNum = 0;
 
-// 存储指令的双向链表的链表头节点
-InterCode interCodes;
+// 指令和操作数按块从池中分配，避免每条指令单独malloc
+#define IR_POOL_CHUNK 4096
+
+typedef struct CodeChunk_d {
+    struct CodeChunk_d* next;
+    int used;
+    InterCode_ codes[IR_POOL_CHUNK];
+} CodeChunk;
+
+typedef struct OperandChunk_d {
+    struct OperandChunk_d* next;
+    int used;
+    Operand_ ops[IR_POOL_CHUNK];
+} OperandChunk;
+
+static CodeChunk* codePool = NULL;
+static OperandChunk* operandPool = NULL;
+
+// 中间代码的内存统计
+static int codeChunkNum = 0;
+static int operandChunkNum = 0;
+static int nullCodeNum = 0;
+static int totalCodeNum = 0;
 
 // 临时变量，标记的全局编号
 int tmpVarNo = 1;
@@ -13,6 +36,108 @@ int labelNo = 1;
 // 初始化双向链表
 void initInterCodes() {}
 
+// 从指令池中取一条清零的指令，翻译阶段的链表节点都来自这里
+InterCode allocInterCode() {
+    if (codePool == NULL || codePool->used == IR_POOL_CHUNK) {
+        CodeChunk* chunk = (CodeChunk*)calloc(1, sizeof(CodeChunk));
+        if (chunk == NULL) {
+            fprintf(stderr, "Out of memory when allocating intercodes.\n");
+            exit(1);
+        }
+        chunk->next = codePool;
+        codePool = chunk;
+        codeChunkNum++;
+    }
+    totalCodeNum++;
+    return &codePool->codes[codePool->used++];
+}
+
+// 从操作数池中取一个清零的操作数，操作数在目标代码生成结束前一直有效
+Operand allocOperand() {
+    if (operandPool == NULL || operandPool->used == IR_POOL_CHUNK) {
+        OperandChunk* chunk = (OperandChunk*)calloc(1, sizeof(OperandChunk));
+        if (chunk == NULL) {
+            fprintf(stderr, "Out of memory when allocating operands.\n");
+            exit(1);
+        }
+        chunk->next = operandPool;
+        operandPool = chunk;
+        operandChunkNum++;
+    }
+    return &operandPool->ops[operandPool->used++];
+}
+
+// 把翻译得到的循环链表按顺序拷贝到连续数组中，同时丢弃所有空指令
+// 拷贝完成后链表节点不再使用，整个指令池被释放
+void compactInterCodes(InterCode head) {
+    int capacity = totalCodeNum > 0 ? totalCodeNum : 1;
+    interCodes = (InterCode)malloc(sizeof(InterCode_) * capacity);
+    interCodeNum = 0;
+    nullCodeNum = 0;
+    if (head != NULL) {
+        InterCode curr = head;
+        do {
+            if (curr->kind == NULL_IR)
+                nullCodeNum++;
+            else {
+                interCodes[interCodeNum] = *curr;
+                interCodes[interCodeNum].pre = NULL;
+                interCodes[interCodeNum].next = NULL;
+                interCodeNum++;
+            }
+            curr = curr->next;
+        } while (curr != NULL && curr != head);
+    }
+    // 收缩到实际大小
+    if (interCodeNum > 0)
+        interCodes = (InterCode)realloc(interCodes, sizeof(InterCode_) * interCodeNum);
+    while (codePool != NULL) {
+        CodeChunk* next = codePool->next;
+        free(codePool);
+        codePool = next;
+    }
+}
+
+// 优化时重写当前指令数组的缓冲区
+static InterCode rewriteCodes = NULL;
+static int rewriteNum = 0;
+static int rewriteCap = 0;
+
+// 开始生成新的指令序列，capacity是预计的指令数
+void beginRewrite(int capacity) {
+    rewriteCap = capacity > 16 ? capacity : 16;
+    rewriteCodes = (InterCode)malloc(sizeof(InterCode_) * rewriteCap);
+    rewriteNum = 0;
+}
+
+// 把一条指令拷贝到新序列末尾，返回的位置在下一次emitInterCode之前有效
+InterCode emitInterCode(InterCode code) {
+    if (rewriteNum == rewriteCap) {
+        rewriteCap *= 2;
+        rewriteCodes = (InterCode)realloc(rewriteCodes, sizeof(InterCode_) * rewriteCap);
+    }
+    rewriteCodes[rewriteNum] = *code;
+    return &rewriteCodes[rewriteNum++];
+}
+
+// 用新序列替换interCodes，原数组被释放
+void finishRewrite() {
+    free(interCodes);
+    interCodes = rewriteCodes;
+    interCodeNum = rewriteNum;
+    rewriteCodes = NULL;
+    rewriteNum = 0;
+    rewriteCap = 0;
+}
+
+// 打印中间代码的内存统计
+void printInterCodeStats(FILE* fp) {
+    fprintf(fp, "intercode: %d codes kept, %d null codes dropped\n", interCodeNum, nullCodeNum);
+    fprintf(fp, "intercode: pool %zu bytes (%d code chunks, %d operand chunks), array %zu bytes\n",
+        sizeof(CodeChunk) * codeChunkNum + sizeof(OperandChunk) * operandChunkNum,
+        codeChunkNum, operandChunkNum, sizeof(InterCode_) * interCodeNum);
+}
+
 // 向指令链表尾部插入多条指令组成的双向链表
 void insertInterCode(InterCode code, InterCode interCodes) {
     if (interCodes == NULL) {
@@ -55,158 +180,158 @@ void insertInterCode(InterCode code, InterCode interCodes) {
 
 // 向指定文件中打印中间代码
 void printInterCodes(char* name) {
-    FILE* fp = fopen(name, "w");
-    if (fp == NULL) {
+    OutBuffer out = openOutBuffer(name);
+    if (out == NULL) {
         printf("Cannot open file %s", name);
         return;
     }
-    InterCode curr = interCodes;
-    int flag = 1;
-    while (flag == 1 || curr != interCodes) {
-        flag = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode curr = &interCodes[i];
         switch(curr->kind) {
             case LABEL_IR:
-                fputs("LABEL ", fp);
-                printOperand(curr->ops[0], fp);
-                fputs(" :", fp);
+                outStr(out, "LABEL ");
+                printOperand(curr->ops[0], out);
+                outStr(out, " :");
                 break;
             case FUNC_IR:
-                fputs("FUNCTION ", fp);
-                printOperand(curr->ops[0], fp);
-                fputs(" :", fp);
+                outStr(out, "FUNCTION ");
+                printOperand(curr->ops[0], out);
+                outStr(out, " :");
                 break;
             case ASSIGN_IR:
-                printOperand(curr->ops[0], fp);
-                fputs(" := ", fp);
-                printOperand(curr->ops[1], fp);
+                printOperand(curr->ops[0], out);
+                outStr(out, " := ");
+                printOperand(curr->ops[1], out);
                 break;
             case PLUS_IR:
-                printOperand(curr->ops[0], fp);
-                fputs(" := ", fp);
-                printOperand(curr->ops[1], fp);
-                fputs(" + ", fp);
-                printOperand(curr->ops[2], fp);
+                printOperand(curr->ops[0], out);
+                outStr(out, " := ");
+                printOperand(curr->ops[1], out);
+                outStr(out, " + ");
+                printOperand(curr->ops[2], out);
                 break;
             case SUB_IR:
-                printOperand(curr->ops[0], fp);
-                fputs(" := ", fp);
-                printOperand(curr->ops[1], fp);
-                fputs(" - ", fp);
-                printOperand(curr->ops[2], fp);
+                printOperand(curr->ops[0], out);
+                outStr(out, " := ");
+                printOperand(curr->ops[1], out);
+                outStr(out, " - ");
+                printOperand(curr->ops[2], out);
                 break;
             case MUL_IR:
-                printOperand(curr->ops[0], fp);
-                fputs(" := ", fp);
-                printOperand(curr->ops[1], fp);
-                fputs(" * ", fp);
-                printOperand(curr->ops[2], fp);
+                printOperand(curr->ops[0], out);
+                outStr(out, " := ");
+                printOperand(curr->ops[1], out);
+                outStr(out, " * ");
+                printOperand(curr->ops[2], out);
                 break;
             case DIV_IR:
-                printOperand(curr->ops[0], fp);
-                fputs(" := ", fp);
-                printOperand(curr->ops[1], fp);
-                fputs(" / ", fp);
-                printOperand(curr->ops[2], fp);
+                printOperand(curr->ops[0], out);
+                outStr(out, " := ");
+                printOperand(curr->ops[1], out);
+                outStr(out, " / ");
+                printOperand(curr->ops[2], out);
                 break;
             case TO_MEM_IR:
-                fputs("*", fp);
-                printOperand(curr->ops[0], fp);
-                fputs(" := ", fp);
-                printOperand(curr->ops[1], fp);
+                outStr(out, "*");
+                printOperand(curr->ops[0], out);
+                outStr(out, " := ");
+                printOperand(curr->ops[1], out);
                 break;
             case GOTO_IR:
-                fputs("GOTO ", fp);
-                printOperand(curr->ops[0], fp);
+                outStr(out, "GOTO ");
+                printOperand(curr->ops[0], out);
                 break;
             case IF_GOTO_IR:
-                fputs("IF ", fp);
-                printOperand(curr->ops[0], fp);
-                fputs(" ", fp);
-                fputs(curr->relop, fp);
-                fputs(" ", fp);
-                printOperand(curr->ops[1], fp);
-                fputs(" GOTO ", fp);
-                printOperand(curr->ops[2], fp);
+                outStr(out, "IF ");
+                printOperand(curr->ops[0], out);
+                outStr(out, " ");
+                outStr(out, curr->relop);
+                outStr(out, " ");
+                printOperand(curr->ops[1], out);
+                outStr(out, " GOTO ");
+                printOperand(curr->ops[2], out);
                 break;
             case RETURN_IR:
-                fputs("RETURN ", fp);
-                printOperand(curr->ops[0], fp);
+                outStr(out, "RETURN ");
+                printOperand(curr->ops[0], out);
                 break;
             case DEC_IR:
-                fputs("DEC ", fp);
-                printOperand(curr->ops[0], fp);
-                char str[32];
-                sprintf(str, " %d", curr->size);
-                fputs(str, fp);
+                outStr(out, "DEC ");
+                printOperand(curr->ops[0], out);
+                outChar(out, ' ');
+                outInt(out, curr->size);
                 break;
             case ARG_IR:
-                fputs("ARG ", fp);
-                printOperand(curr->ops[0], fp);
+                outStr(out, "ARG ");
+                printOperand(curr->ops[0], out);
                 break;
             case CALL_IR:
-                printOperand(curr->ops[0], fp);
-                fputs(" := CALL ", fp);
-                printOperand(curr->ops[1], fp);
+                printOperand(curr->ops[0], out);
+                outStr(out, " := CALL ");
+                printOperand(curr->ops[1], out);
                 break;
             case PARAM_IR:
-                fputs("PARAM ", fp);
-                printOperand(curr->ops[0], fp);
+                outStr(out, "PARAM ");
+                printOperand(curr->ops[0], out);
                 break;
             case READ_IR:
-                fputs("READ ", fp);
-                printOperand(curr->ops[0], fp);
+                outStr(out, "READ ");
+                printOperand(curr->ops[0], out);
                 break;
             case WRITE_IR:
-                fputs("WRITE ", fp);
-                printOperand(curr->ops[0], fp);
+                outStr(out, "WRITE ");
+                printOperand(curr->ops[0], out);
+                break;
+            // 只在SSA形式中出现，离开SSA之前被消去
+            case PHI_IR:
+                printOperand(curr->ops[0], out);
+                outStr(out, " := PHI");
+                for (int k = 0; k < curr->argNum; k++) {
+                    outChar(out, k == 0 ? ' ' : ',');
+                    printOperand(curr->args[k], out);
+                }
                 break;
             default:
                 break;
         }
-        // 空指令什么也不输出，也不需要换行
-        if (curr->kind != NULL_IR)
-            fputs("\n", fp);
-        fflush(fp);
-        curr = curr->next;
+        // 空指令已在压缩时丢弃，每条指令占一行
+        outChar(out, '\n');
     }
-    fclose(fp);
+    closeOutBuffer(out);
 }
 
 // 向指定文件中打印操作数
-void printOperand(Operand op, FILE* fp) {
+void printOperand(Operand op, OutBuffer out) {
     if (op == NULL) {
-        fputs("null", fp);
+        outStr(out, "null");
         return;
     }
-    char out[32];
     switch (op->kind) {
         case VARIABLE_OP:
-            sprintf(out, "%s", op->name);
-            fputs(out, fp);
+            outStr(out, op->name);
             break;
         case TEMP_VAR_OP:
-            sprintf(out, "t%d", op->no);
-            fputs(out, fp);
+            outChar(out, 't');
+            outInt(out, op->no);
             break;
         case CONSTANT_OP:
-            sprintf(out, "#%d", op->value);
-            fputs(out, fp);
+            outChar(out, '#');
+            outInt(out, op->value);
             break;
         case LABEL_OP:
-            sprintf(out, "label%d", op->no);
-            fputs(out, fp);
+            outStr(out, "label");
+            outInt(out, op->no);
             break;
         case FUNCTION_OP:
-            sprintf(out, "%s", op->name);
-            fputs(out, fp);
+            outStr(out, op->name);
             break;
         case GET_ADDR_OP:
-            fputs("&", fp);
-            printOperand(op->opr, fp);
+            outChar(out, '&');
+            printOperand(op->opr, out);
             break;
         case GET_VAL_OP:
-            fputs("*", fp);
-            printOperand(op->opr, fp);
+            outChar(out, '*');
+            printOperand(op->opr, out);
             break;
         default:
             break;
@@ -216,7 +341,7 @@ void printOperand(Operand op, FILE* fp) {
 
 // 创建临时变量
 Operand newTemp() {
-    Operand tmpVar = (Operand)malloc(sizeof(Operand_));
+    Operand tmpVar = allocOperand();
     tmpVar->kind = TEMP_VAR_OP;
     tmpVar->no = tmpVarNo;
     tmpVarNo++;
@@ -225,7 +350,7 @@ Operand newTemp() {
 
 // 创建临时标记
 Operand newLabel() {
-    Operand label = (Operand)malloc(sizeof(Operand_));
+    Operand label = allocOperand();
     label->kind = LABEL_OP;
     label->no = labelNo;
     labelNo++;
@@ -234,32 +359,47 @@ Operand newLabel() {
 
 // 创建常量
 Operand getValue(int num) {
-    Operand cons = (Operand)malloc(sizeof(Operand_));
+    Operand cons = allocOperand();
     cons->kind = CONSTANT_OP;
     cons->value = num;
     return cons;
 }
 
+// 取反的关系运算符，条件跳转改为在相反的条件下跳转时使用
+char* invertRelop(char* relop) {
+    if (strcmp(relop, "==") == 0)
+        return "!=";
+    if (strcmp(relop, "!=") == 0)
+        return "==";
+    if (strcmp(relop, "<") == 0)
+        return ">=";
+    if (strcmp(relop, ">=") == 0)
+        return "<";
+    if (strcmp(relop, ">") == 0)
+        return "<=";
+    return ">";
+}
+
 // 创建变量操作数
 Operand getVar(char* name) {
-    Operand var = (Operand)malloc(sizeof(Operand_));
+    Operand var = allocOperand();
     var->kind = VARIABLE_OP;
     //在变量操作数名前面加上一个v，防止某些名字和临时变量名重名
-    sprintf(var->name, "v%s", name);
+    var->name = internConcat("v", name);
     return var;
 }
 
 // 创建函数操作数
 Operand getFunc(char* name) {
-    Operand func = (Operand)malloc(sizeof(Operand_));
+    Operand func = allocOperand();
     func->kind = FUNCTION_OP;
-    strcpy(func->name, name);
+    func->name = name;
     return func;
 }
 
 // 对某个操作数取地址
 Operand getAddr(Operand op) {
-    Operand addr = (Operand)malloc(sizeof(Operand_));
+    Operand addr = allocOperand();
     addr->kind = GET_ADDR_OP;
     addr->opr = op;
     return addr;
@@ -267,7 +407,7 @@ Operand getAddr(Operand op) {
 
 // 对某个操作数解引用
 Operand getVal(Operand op) {
-    Operand val = (Operand)malloc(sizeof(Operand_));
+    Operand val = allocOperand();
     val->kind = GET_VAL_OP;
     val->opr = op;
     return val;
@@ -281,7 +421,7 @@ void operandCpy(Operand dest, Operand src) {
     else if (dest->kind == CONSTANT_OP)
         dest->value = src->value;
     else if (dest->kind == VARIABLE_OP || dest->kind == FUNCTION_OP)
-        strcpy(dest->name, src->name);
+        dest->name = src->name;
     else
         dest->opr = src->opr;
     dest->type = src->type;
@@ -315,7 +455,7 @@ int getSize(Type type) {
 
 // 获取一条空指令
 InterCode getNullInterCode() {
-    InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+    InterCode code1 = allocInterCode();
     code1->kind = NULL_IR;
     return code1;
 }
@@ -337,7 +477,7 @@ InterCode optimizePLUSIR(Operand dest, Operand src1, Operand src2) {
         return getNullInterCode();
     }
     else {
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = PLUS_IR;
         code1->ops[0] = dest;
         code1->ops[1] = src1;
@@ -358,7 +498,7 @@ InterCode optimizeSUBIR(Operand dest, Operand src1, Operand src2) {
         return getNullInterCode();
     }
     else {
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = SUB_IR;
         code1->ops[0] = dest;
         code1->ops[1] = src1;
@@ -389,7 +529,7 @@ InterCode optimizeMULIR(Operand dest, Operand src1, Operand src2) {
         return getNullInterCode();
     }
     else {
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = MUL_IR;
         code1->ops[0] = dest;
         code1->ops[1] = src1;
@@ -414,7 +554,7 @@ InterCode optimizeDIVIR(Operand dest, Operand src1, Operand src2) {
         return getNullInterCode();
     }
     else {
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = DIV_IR;
         code1->ops[0] = dest;
         code1->ops[1] = src1;
@@ -423,45 +563,19 @@ InterCode optimizeDIVIR(Operand dest, Operand src1, Operand src2) {
     }
 }
 
-// 找到语句链表中的最后一条非空语句或者空语句（如果没有非空语句的话）   
-InterCode findLastInterCode(InterCode code) {
-    InterCode last = code->pre;
-    while (last->kind == NULL_IR && last != code)
-        last = last->pre;
-    return last;
-}
-
-// 优化后面跟着GOTO或LABEL的LABEL语句
-void optimizeLABELBeforeGOTO(InterCode code, Operand label) {
-    InterCode last = findLastInterCode(code);
-    if (last->kind == LABEL_IR) {
-        int no = last->ops[0]->no;
-        last->kind = NULL_IR;
-        InterCode curr = last;
-        while (curr != code) {
-            if (curr->kind == GOTO_IR && curr->ops[0]->no == no)
-                curr->ops[0]->no = label->no;
-            else if (curr->kind == IF_GOTO_IR && curr->ops[2]->no == no)
-                curr->ops[2]->no = label->no;
-            curr = curr->pre;
-        }
-    }
-}
-
 // 基本表达式的翻译
 InterCode translateExp(Node* root, Operand place) {
     // 赋值表达式
-    if (root->childNum == 3 && strcmp(root->children[1]->name, "ASSIGNOP") == 0) {
+    if (root->kind == ENUM_EXP_ASSIGNOP) {
         // 单个变量作为左值
-        if (root->children[0]->childNum == 1 && 
-            strcmp(root->children[0]->children[0]->name, "ID") == 0) {
-            Entry sym = findSymbolAll(root->children[0]->children[0]->strVal);
+        if (root->children[0]->kind == ENUM_EXP_ID) {
+            Entry sym = root->children[0]->entry;
             Operand var = getVar(sym->name);
             Operand tmp1 = newTemp();
             // 右侧exp的运算结果存储在t1中
             InterCode code1 = translateExp(root->children[2], tmp1);
             // 把t1的值赋给左侧的左值
-            InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+            InterCode code2 = allocInterCode();
             code2->kind = ASSIGN_IR;
             code2->ops[0] = var;
             code2->ops[1] = tmp1;
@@ -472,8 +586,7 @@ InterCode translateExp(Node* root, Operand place) {
             return code1;
         }
         // 数组元素作为左值
-        else if (root->children[0]->childNum == 4 && 
-            strcmp(root->children[0]->children[1]->name, "LB") == 0) {
+        else if (root->children[0]->kind == ENUM_EXP_INDEX) {
             // tmp1应当是数组的地址，tmp2应当是一个整型，tmp3是所取元素的偏移量
             Operand tmp1 = newTemp();
             Operand tmp2 = newTemp();
@@ -491,7 +604,7 @@ InterCode translateExp(Node* root, Operand place) {
             // tmp5存储的是右侧表达式的运算结果
             Operand tmp5 = newTemp();
             InterCode code5 = translateExp(root->children[2], tmp5);
-            InterCode code6 = (InterCode)malloc(sizeof(InterCode_));
+            InterCode code6 = allocInterCode();
             code6->kind = TO_MEM_IR;
             code6->ops[0] = tmp4;
             code6->ops[1] = tmp5;
@@ -503,18 +616,16 @@ InterCode translateExp(Node* root, Operand place) {
             return code1;
         }
         // 结构体特定域作为左值
-        else if (root->children[0]->childNum == 3 &&
-            strcmp(root->children[0]->children[1]->name, "DOT") == 0) {
+        else if (root->children[0]->kind == ENUM_EXP_DOT) {
             // 获取域名
-            char name[32];
-            strcpy(name, root->children[0]->children[2]->strVal);
+            char* name = root->children[0]->children[2]->strVal;
             Operand tmp1 = newTemp();
             // tmp1返回的是一个结构体的首地址，并且带有type属性
             InterCode code1 = translateExp(root->children[0]->children[0], tmp1);
             // 获取域的偏移量和类型
             int offset = 0;
             FieldList head = tmp1->type->structure->head;
-            while (strcmp(head->name, name) != 0) {
+            while (head->name != name) {
                 int tmp = getSize(head->type);
                 // 按四字节对齐
                 if (tmp % 4 != 0)
@@ -529,7 +640,7 @@ InterCode translateExp(Node* root, Operand place) {
             // tmp3存储的是右侧表达式的运算结果
             Operand tmp3 = newTemp();
             InterCode code3 = translateExp(root->children[2], tmp3);
-            InterCode code4 = (InterCode)malloc(sizeof(InterCode_));
+            InterCode code4 = allocInterCode();
             code4->kind = TO_MEM_IR;
             code4->ops[0] = tmp2;
             code4->ops[1] = tmp3;
@@ -542,28 +653,26 @@ InterCode translateExp(Node* root, Operand place) {
         }
     }
     // 加减乘除表达式
-    else if (root->childNum == 3 && (
-             strcmp(root->children[1]->name, "PLUS") == 0 ||
-             strcmp(root->children[1]->name, "MINUS") == 0 ||
-             strcmp(root->children[1]->name, "STAR") == 0 ||
-             strcmp(root->children[1]->name, "DIV") == 0)) {
+    else if (root->kind == ENUM_EXP_PLUS || root->kind == ENUM_EXP_MINUS ||
+             root->kind == ENUM_EXP_STAR || root->kind == ENUM_EXP_DIV) {
         Operand tmp1 = newTemp();
         Operand tmp2 = newTemp();
         InterCode code1 = translateExp(root->children[0], tmp1);
         InterCode code2 = translateExp(root->children[2], tmp2);
         insertInterCode(code2, code1);
         InterCode code3 = getNullInterCode();
-        switch (root->children[1]->name[0]) {
-            case 'P': code3 = optimizePLUSIR(place, tmp1, tmp2); break;
-            case 'M': code3 = optimizeSUBIR(place, tmp1, tmp2); break;
-            case 'S': code3 = optimizeMULIR(place, tmp1, tmp2); break;
-            case 'D': code3 = optimizeDIVIR(place, tmp1, tmp2); break;
+        switch (root->kind) {
+            case ENUM_EXP_PLUS: code3 = optimizePLUSIR(place, tmp1, tmp2); break;
+            case ENUM_EXP_MINUS: code3 = optimizeSUBIR(place, tmp1, tmp2); break;
+            case ENUM_EXP_STAR: code3 = optimizeMULIR(place, tmp1, tmp2); break;
+            case ENUM_EXP_DIV: code3 = optimizeDIVIR(place, tmp1, tmp2); break;
+            default: break;
         }
         insertInterCode(code3, code1);
         return code1;
     }
     // 取负表达式
-    else if (strcmp(root->children[0]->name, "MINUS") == 0) {
+    else if (root->kind == ENUM_EXP_NEG) {
         Operand tmp1 = newTemp();
         InterCode code1 = translateExp(root->children[1], tmp1);
         InterCode code2 = optimizeSUBIR(place, getValue(0), tmp1);
@@ -571,7 +680,7 @@ InterCode translateExp(Node* root, Operand place) {
         return code1;
     }
     // 括号表达式
-    else if (strcmp(root->children[0]->name, "LP") == 0) {
+    else if (root->kind == ENUM_EXP_PAREN) {
         Operand tmp1 = newTemp();
         InterCode code1 = translateExp(root->children[1], tmp1);
         // 优化：直接把place修改为tmp1
@@ -580,27 +689,23 @@ InterCode translateExp(Node* root, Operand place) {
         return code1;
     }
     // 条件表达式
-    else if (root->childNum >= 2 && (
-             strcmp(root->children[0]->name, "NOT") == 0 ||
-             strcmp(root->children[1]->name, "RELOP") == 0 ||
-             strcmp(root->children[1]->name, "AND") == 0 ||
-             strcmp(root->children[1]->name, "OR") == 0)) {
+    else if (root->kind == ENUM_EXP_NOT || root->kind == ENUM_EXP_RELOP ||
+             root->kind == ENUM_EXP_AND || root->kind == ENUM_EXP_OR) {
         Operand label1 = newLabel();
         Operand label2 = newLabel();
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = ASSIGN_IR;
         code1->ops[0] = place;
         code1->ops[1] = getValue(0);
         InterCode code2 = translateCond(root, label1, label2);
-        optimizeLABELBeforeGOTO(code2, label1);
-        InterCode code3 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code3 = allocInterCode();
         code3->kind = LABEL_IR;
         code3->ops[0] = label1;
-        InterCode code4 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code4 = allocInterCode();
         code4->kind = ASSIGN_IR;
         code4->ops[0] = place;
         code4->ops[1] = getValue(1);
-        InterCode code5 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code5 = allocInterCode();
         code5->kind = LABEL_IR;
         code5->ops[0] = label2;
         insertInterCode(code2, code1);
@@ -609,10 +714,10 @@ InterCode translateExp(Node* root, Operand place) {
         insertInterCode(code5, code1);
         return code1;
     }
-    else if (strcmp(root->children[0]->name, "ID") == 0) {
+    else if (root->kind == ENUM_EXP_ID || root->kind == ENUM_EXP_CALL) {
         // 单变量表达式
-        if (root->childNum == 1) {
-            Entry sym = findSymbolAll(root->children[0]->strVal);
+        if (root->kind == ENUM_EXP_ID) {
+            Entry sym = root->entry;
             Operand var = getVar(sym->name);
             // 数组类型和结构体类型并且不是函数参数是局部变量——需要取地址指令
             if (sym->type->kind != ENUM_BASIC && sym->isArg == 0) {
@@ -629,18 +734,18 @@ InterCode translateExp(Node* root, Operand place) {
         }
         // 函数调用表达式
         else {
-            Entry sym = findSymbolFunc(root->children[0]->strVal);
+            Entry sym = root->entry;
             Operand func = getFunc(sym->name);
             // 无参函数
             if (root->childNum == 3) {
                 // read函数
                 if (strcmp(func->name, "read") == 0) {
-                    InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+                    InterCode code1 = allocInterCode();
                     code1->kind = READ_IR;
                     code1->ops[0] = place;
                     return code1;
                 }
-                InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+                InterCode code1 = allocInterCode();
                 code1->kind = CALL_IR;
                 code1->ops[0] = place;
                 code1->ops[1] = func;
@@ -648,11 +753,11 @@ InterCode translateExp(Node* root, Operand place) {
             }
             // 带参函数
             else if (root->childNum == 4) {
-                Operand argList = (Operand)malloc(sizeof(Operand_));
+                Operand argList = allocOperand();
                 InterCode code1 = translateArgs(root->children[2], argList);
                 // write函数
                 if (strcmp(func->name, "write") == 0) {
-                    InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+                    InterCode code2 = allocInterCode();
                     code2->kind = WRITE_IR;
                     code2->ops[0] = argList->next;
                     insertInterCode(code2, code1);
@@ -662,13 +767,13 @@ InterCode translateExp(Node* root, Operand place) {
                 }
                 Operand curr = argList->next;
                 while (curr != NULL) {
-                    InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+                    InterCode code2 = allocInterCode();
                     code2->kind = ARG_IR;
                     code2->ops[0] = curr;
                     insertInterCode(code2, code1);
                     curr = curr->next;
                 }
-                InterCode code3 = (InterCode)malloc(sizeof(InterCode_));
+                InterCode code3 = allocInterCode();
                 code3->kind = CALL_IR;
                 code3->ops[0] = place;
                 code3->ops[1] = func;
@@ -678,7 +783,7 @@ InterCode translateExp(Node* root, Operand place) {
         }
     }
     // 整型表达式
-    else if (strcmp(root->children[0]->name, "INT") == 0) {
+    else if (root->kind == ENUM_EXP_INT) {
         // 优化：直接把place改成一个常量操作数，不需要多加一条赋值指令
         Operand value = getValue(root->children[0]->intVal);
         operandCpy(place, value);
@@ -686,7 +791,7 @@ InterCode translateExp(Node* root, Operand place) {
         return getNullInterCode();
     }
     // 数组元素表达式
-    else if (root->childNum == 4 && strcmp(root->children[1]->name, "LB") == 0) {
+    else if (root->kind == ENUM_EXP_INDEX) {
         // tmp1应当是地址，tmp2应当是一个整型
         Operand tmp1 = newTemp();
         Operand tmp2 = newTemp();
@@ -719,17 +824,16 @@ InterCode translateExp(Node* root, Operand place) {
         return code1;
     }
     // 取结构体域
-    else if (root->childNum == 3 && strcmp(root->children[1]->name, "DOT") == 0) {
+    else if (root->kind == ENUM_EXP_DOT) {
         // 获取域名
-        char name[32];
-        strcpy(name, root->children[2]->strVal);
+        char* name = root->children[2]->strVal;
         Operand tmp1 = newTemp();
         // tmp1返回的是一个结构体的首地址，并且带有type属性
         InterCode code1 = translateExp(root->children[0], tmp1);
         // 获取域的偏移量和类型
         int offset = 0;
         FieldList head = tmp1->type->structure->head;
-        while (strcmp(head->name, name) != 0) {
+        while (head->name != name) {
             int tmp = getSize(head->type);
             // 按四字节对齐
             if (tmp % 4 != 0)
@@ -779,33 +883,30 @@ InterCode translateArgs(Node* root, Operand argList) {
 
 // 语句的翻译模式
 InterCode translateStmt(Node* root) {
-    if (strcmp(root->children[0]->name, "Exp") == 0) {
+    if (root->kind == ENUM_STMT_EXP) {
         return translateExp(root->children[0], NULL);
     }
-    else if (strcmp(root->children[0]->name, "CompSt") == 0) {
-        pushLayer();
-        InterCode code1 = translateCompSt(root->children[0], NULL);
-        popLayer();
-        return code1;
+    else if (root->kind == ENUM_STMT_COMPST) {
+        return translateCompSt(root->children[0]);
     }
-    else if (strcmp(root->children[0]->name, "RETURN") == 0) {
+    else if (root->kind == ENUM_STMT_RETURN) {
         Operand tmp1 = newTemp();
         InterCode code1 = translateExp(root->children[1], tmp1);
-        InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code2 = allocInterCode();
         code2->kind = RETURN_IR;
         code2->ops[0] = tmp1;
         insertInterCode(code2, code1);
         return code1;
     }
-    else if (strcmp(root->children[0]->name, "IF") == 0 && root->childNum == 5) {
+    else if (root->kind == ENUM_STMT_IF) {
         Operand label1 = newLabel();
         Operand label2 = newLabel();
         InterCode code1 = translateCond(root->children[2], label1, label2);
-        InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code2 = allocInterCode();
         code2->kind = LABEL_IR;
         code2->ops[0] = label1;
         InterCode code3 = translateStmt(root->children[4]);
-        InterCode code4 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code4 = allocInterCode();
         code4->kind = LABEL_IR;
         code4->ops[0] = label2;
         insertInterCode(code2, code1);
@@ -814,62 +915,23 @@ InterCode translateStmt(Node* root) {
         insertInterCode(code4, code1);
         return code1;
     }
-    else if (strcmp(root->children[0]->name, "IF") == 0 && root->childNum == 7) {
+    else if (root->kind == ENUM_STMT_IF_ELSE) {
         Operand label1 = newLabel();
         Operand label2 = newLabel();
         Operand label3 = newLabel();
         InterCode code1 = translateCond(root->children[2], label1, label2);
-        // code1的最后一条语句为goto labelfalse并且code1中只有这一条向labelflase的跳转语句，此时可以优化
-        InterCode last = findLastInterCode(code1);
-        if (last->kind == GOTO_IR && last->ops[0]->no == label2->no) {
-            int count = 0;
-            if (code1->kind == GOTO_IR && code1->ops[0]->no == label2->no)
-                count++;
-            InterCode curr = code1->pre;
-            while (curr != code1) {
-                if (curr->kind == GOTO_IR && curr->ops[0]->no == label2->no)
-                    count++;
-                curr = curr->pre;
-            }
-            // 优化：把labelFalse对应的语句提到条件表达式的IFGOTO语句后面，可以消除一个冗余的label
-            if (count == 1) {
-                last->kind = NULL_IR;
-                InterCode code2 = translateStmt(root->children[6]);
-                // 优化：如果code2的最后一句是LABEL语句，那么将code2中的所有GOTO语句中的该LABEL替换为LABEL3
-                optimizeLABELBeforeGOTO(code2, label3);
-                InterCode code3 = (InterCode)malloc(sizeof(InterCode_));
-                code3->kind = GOTO_IR;
-                code3->ops[0] = label3;
-                InterCode code4 = (InterCode)malloc(sizeof(InterCode_));
-                code4->kind = LABEL_IR;
-                code4->ops[0] = label1;
-                InterCode code5 = translateStmt(root->children[4]);
-                optimizeLABELBeforeGOTO(code5, label3);
-                InterCode code6 = (InterCode)malloc(sizeof(InterCode_));
-                code6->kind = LABEL_IR;
-                code6->ops[0] = label3;
-                insertInterCode(code2, code1);
-                insertInterCode(code3, code1);
-                insertInterCode(code4, code1);
-                insertInterCode(code5, code1);
-                insertInterCode(code6, code1);
-                return code1;
-            }
-        }
-        InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code2 = allocInterCode();
         code2->kind = LABEL_IR;
         code2->ops[0] = label1;
         InterCode code3 = translateStmt(root->children[4]);
-        optimizeLABELBeforeGOTO(code3, label3);
-        InterCode code4 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code4 = allocInterCode();
         code4->kind = GOTO_IR;
         code4->ops[0] = label3;
-        InterCode code5 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code5 = allocInterCode();
         code5->kind = LABEL_IR;
         code5->ops[0] = label2;
         InterCode code6 = translateStmt(root->children[6]);
-        optimizeLABELBeforeGOTO(code6, label3);
-        InterCode code7 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code7 = allocInterCode();
         code7->kind = LABEL_IR;
         code7->ops[0] = label3;
         insertInterCode(code2, code1);
@@ -880,23 +942,22 @@ InterCode translateStmt(Node* root) {
         insertInterCode(code7, code1);
         return code1;
     }
-    else if (strcmp(root->children[0]->name, "WHILE") == 0) {
+    else if (root->kind == ENUM_STMT_WHILE) {
         Operand label1 = newLabel();
         Operand label2 = newLabel();
         Operand label3 = newLabel();
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = LABEL_IR;
         code1->ops[0] = label1;
         InterCode code2 = translateCond(root->children[2], label2, label3);
-        InterCode code3 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code3 = allocInterCode();
         code3->kind = LABEL_IR;
         code3->ops[0] = label2;
         InterCode code4 = translateStmt(root->children[4]);
-        optimizeLABELBeforeGOTO(code4, label1);
-        InterCode code5 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code5 = allocInterCode();
         code5->kind = GOTO_IR;
         code5->ops[0] = label1;
-        InterCode code6 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code6 = allocInterCode();
         code6->kind = LABEL_IR;
         code6->ops[0] = label3;
         insertInterCode(code2, code1);
@@ -911,18 +972,18 @@ InterCode translateStmt(Node* root) {
 
 // 条件表达式的翻译模式
 InterCode translateCond(Node* root, Operand labelTrue, Operand labelFalse) {
-    if (root->childNum >= 2 && strcmp(root->children[1]->name, "RELOP") == 0) {
+    if (root->kind == ENUM_EXP_RELOP) {
         Operand tmp1 = newTemp();
         Operand tmp2 = newTemp();
         InterCode code1 = translateExp(root->children[0], tmp1);
         InterCode code2 = translateExp(root->children[2], tmp2);
-        InterCode code3 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code3 = allocInterCode();
         code3->kind = IF_GOTO_IR;
         code3->ops[0] = tmp1;
         code3->ops[1] = tmp2;
         code3->ops[2] = labelTrue;
-        strcpy(code3->relop, root->children[1]->strVal);
-        InterCode code4 = (InterCode)malloc(sizeof(InterCode_));
+        code3->relop = root->children[1]->strVal;
+        InterCode code4 = allocInterCode();
         code4->kind = GOTO_IR;
         code4->ops[0] = labelFalse;
         insertInterCode(code2, code1);
@@ -930,19 +991,17 @@ InterCode translateCond(Node* root, Operand labelTrue, Operand labelFalse) {
         insertInterCode(code4, code1);
         return code1;
     }
-    else if (strcmp(root->children[0]->name, "NOT") == 0) {
+    else if (root->kind == ENUM_EXP_NOT) {
         return translateCond(root->children[1], labelFalse, labelTrue);
     }
-    else if (root->childNum >= 2 && (
-             strcmp(root->children[1]->name, "AND") == 0 ||
-             strcmp(root->children[1]->name, "OR") == 0)) {
+    else if (root->kind == ENUM_EXP_AND || root->kind == ENUM_EXP_OR) {
         Operand label1 = newLabel();
         InterCode code1;
-        switch (root->children[1]->name[0]) {
-            case 'A': code1 = translateCond(root->children[0], label1, labelFalse); break;
-            case 'O': code1 = translateCond(root->children[0], labelTrue, label1); break;
-        }
-        InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+        if (root->kind == ENUM_EXP_AND)
+            code1 = translateCond(root->children[0], label1, labelFalse);
+        else
+            code1 = translateCond(root->children[0], labelTrue, label1);
+        InterCode code2 = allocInterCode();
         code2->kind = LABEL_IR;
         code2->ops[0] = label1;
         InterCode code3 = translateCond(root->children[2], labelTrue, labelFalse);
@@ -953,13 +1012,13 @@ InterCode translateCond(Node* root, Operand labelTrue, Operand labelFalse) {
     else {
         Operand tmp1 = newTemp();
         InterCode code1 = translateExp(root, tmp1);
-        InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code2 = allocInterCode();
         code2->kind = IF_GOTO_IR;
         code2->ops[0] = tmp1;
         code2->ops[1] = getValue(0);
         code2->ops[2] = labelTrue;
-        strcpy(code2->relop, "!=");
-        InterCode code3 = (InterCode)malloc(sizeof(InterCode_));
+        code2->relop = "!=";
+        InterCode code3 = allocInterCode();
         code3->kind = GOTO_IR;
         code3->ops[0] = labelFalse;
         insertInterCode(code2, code1);
@@ -968,11 +1027,13 @@ InterCode translateCond(Node* root, Operand labelTrue, Operand labelFalse) {
     }
 }
 
+// 语义分析已经把符号表条目标注在语法树上，翻译时直接使用，不再重建符号表
 void translateProgram(Node* root) {
-    initSymbolTable();
     initInterCodes();
     InterCode code = translateExtDefList(root->children[0]);
-    interCodes = code;
+    compactInterCodes(code);
+    // 标记和跳转的整理统一由控制流化简完成
+    simplifyCFG();
 }
 
 InterCode translateExtDefList(Node* root) {
@@ -990,45 +1051,22 @@ InterCode translateExtDefList(Node* root) {
 }
 
 InterCode translateExtDef(Node* root) {
-    Type type = Specifier(root->children[0]);
-    // 结构体定义，是结构体，不是匿名类型，域定义没有产生错误
-    if (type->kind == ENUM_STRUCT && type->structure->name != "" && type->structure->head != NULL) {
-        Entry res = (Entry)malloc(sizeof(Entry_));
-        strcpy(res->name, type->structure->name);
-        // 需要保证对res->type->kind的改动不会影响到type
-        res->type = (Type)malloc(sizeof(Type_));
-        res->type->structure = type->structure;
-        res->type->kind = ENUM_STRUCT_DEF;
-        insertSymbol(res);
-    }
-    // 函数定义
-    if (strcmp(root->children[1]->name, "FunDec") == 0) {
-        Function func = FunDec(root->children[1]);
+    // 只有函数定义需要生成代码
+    if (root->kind == ENUM_EXTDEF_FUNDEF) {
+        Function func = root->children[1]->entry->type->func;
         // 生成FUNCTION和PARAM中间代码
-        InterCode code1 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code1 = allocInterCode();
         code1->kind = FUNC_IR;
         code1->ops[0] = getFunc(func->name);
         FieldList head = func->head;
         while (head != NULL) {
-            InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+            InterCode code2 = allocInterCode();
             code2->kind = PARAM_IR;
             code2->ops[0] = getVar(head->name);
             insertInterCode(code2, code1);
             head = head->next;
         }
-        // 向符号表中添加符号
-        func->returnType = type;
-        func->hasDefined = 1;
-        Type newType = (Type)malloc(sizeof(Type_));
-        newType->kind = ENUM_FUNC;
-        newType->func = func;
-        Entry res = (Entry)malloc(sizeof(Entry_));
-        strcpy(res->name, func->name);
-        res->type = newType;
-        insertSymbol(res);
-        pushLayer();
-        InterCode code3 = translateCompSt(root->children[2], func->name);
-        popLayer();
+        InterCode code3 = translateCompSt(root->children[2]);
         if (code3 != NULL)
             insertInterCode(code3, code1);
         return code1;
@@ -1036,22 +1074,8 @@ InterCode translateExtDef(Node* root) {
     return getNullInterCode();
 }
 
-InterCode translateCompSt(Node* root, char* funcName) {
-    // 先把函数参数存进符号表
-    if (funcName != NULL) {
-        Entry sym = findSymbolFunc(funcName);
-        FieldList parms = sym->type->func->head;
-        while (parms != NULL) {
-            Entry parm = (Entry)malloc(sizeof(Entry_));
-            strcpy(parm->name, parms->name);
-            parm->type = parms->type;
-            // 标记该符号表条目为函数传入的参数
-            parm->isArg = 1;
-            insertSymbol(parm);
-            parms = parms->next;
-        }
-    }
-    InterCode code1 = translateDefList(root->children[1], ENUM_VAR);
+InterCode translateCompSt(Node* root) {
+    InterCode code1 = translateDefList(root->children[1]);
     InterCode code2 = translateStmtList(root->children[2]);
     insertInterCode(code2, code1);
     return code1;
@@ -1073,63 +1097,54 @@ InterCode translateStmtList(Node* root) {
 }
 
 // 函数体局部变量的翻译模式
-InterCode translateDefList(Node* root, IdType class) {
+InterCode translateDefList(Node* root) {
     if (root->childNum == 0)
         return getNullInterCode();
     else {
-        InterCode code1 = translateDef(root->children[0], class);
-        InterCode code2 = translateDefList(root->children[1], class);
+        InterCode code1 = translateDef(root->children[0]);
+        InterCode code2 = translateDefList(root->children[1]);
         insertInterCode(code2, code1);
         return code1;
     }
 }
 
-InterCode translateDef(Node* root, IdType class) {
-    Type type = Specifier(root->children[0]);
+InterCode translateDef(Node* root) {
     InterCode code1 = getNullInterCode();
-    FieldList res = translateDecList(root->children[1], type, class, code1);
-    // 如果type是结构体或者数组，那么对每个定义的局部变量都要申请空间
-    FieldList curr = res;
-    while (curr != NULL) {
-        if (curr->type->kind == ENUM_ARRAY || curr->type->kind == ENUM_STRUCT) {
+    translateDecList(root->children[1], code1);
+    // 如果变量是结构体或者数组，那么对每个定义的局部变量都要申请空间
+    Node* decList = root->children[1];
+    while (decList != NULL) {
+        Entry sym = decList->children[0]->children[0]->entry;
+        if (sym->type->kind == ENUM_ARRAY || sym->type->kind == ENUM_STRUCT) {
             InterCode code2 = getNullInterCode();
             code2->kind = DEC_IR;
-            code2->ops[0] = getVar(curr->name);
-            code2->ops[0]->type = curr->type;
-            code2->size = getSize(curr->type);
+            code2->ops[0] = getVar(sym->name);
+            code2->ops[0]->type = sym->type;
+            code2->size = getSize(sym->type);
             insertInterCode(code2, code1);
         }
-        curr = curr->next;
+        decList = decList->childNum == 3 ? decList->children[2] : NULL;
     }
     return code1;
 }
 
-FieldList translateDecList(Node* root, Type type, IdType class, InterCode code) {
-    FieldList res = translateDec(root->children[0], type, class, code);
-    if (root->childNum == 3) {
-        if (res == NULL)
-            res = translateDecList(root->children[2], type, class, code);
-        else {
-            FieldList tmp = res;
-            while (tmp->next != NULL) tmp = tmp->next;
-            tmp->next = translateDecList(root->children[2], type, class, code);
-        }
-    }
-    return res;
+void translateDecList(Node* root, InterCode code) {
+    translateDec(root->children[0], code);
+    if (root->childNum == 3)
+        translateDecList(root->children[2], code);
 }
 
-FieldList translateDec(Node* root, Type type, IdType class, InterCode code) {
-    FieldList res = VarDec(root->children[0], type, class);
+void translateDec(Node* root, InterCode code) {
     // 局部变量在声明时初始化
-    if (class == ENUM_VAR && res != NULL && root->childNum == 3) {
+    if (root->childNum == 3) {
+        Entry sym = root->children[0]->entry;
         Operand tmp1 = newTemp();
         InterCode code1 = translateExp(root->children[2], tmp1);
         insertInterCode(code1, code);
-        InterCode code2 = (InterCode)malloc(sizeof(InterCode_));
+        InterCode code2 = allocInterCode();
         code2->kind = ASSIGN_IR;
-        code2->ops[0] = getVar(res->name);
+        code2->ops[0] = getVar(sym->name);
         code2->ops[1] = tmp1;
         insertInterCode(code2, code);
     }
-    return res;
 }
\ No newline at end of file
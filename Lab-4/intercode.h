@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "semantic.h"
+#include "output.h"
 
 typedef struct Operand_d Operand_;
 typedef Operand_* Operand;
@@ -19,7 +20,7 @@ struct Operand_d {
     union {
         int no; // 临时变量的编号，标记的编号
         int value;  // 常量的值
-        char name[32];  // 函数以及变量的名字
+        char* name;     // 函数以及变量的名字（驻留字符串）
         Operand opr; // 取地址和解引用指向的操作数
     };
     Type type;  // 存放数组/结构体类型变量的类型
@@ -32,26 +33,42 @@ struct InterCode_d {
         LABEL_IR, FUNC_IR, ASSIGN_IR, PLUS_IR, SUB_IR, MUL_IR, 
         DIV_IR, TO_MEM_IR, GOTO_IR,
         IF_GOTO_IR, RETURN_IR, DEC_IR, ARG_IR, CALL_IR, PARAM_IR,
-        READ_IR, WRITE_IR, NULL_IR
+        READ_IR, WRITE_IR, PHI_IR, NULL_IR
     } kind;
+    int argNum;     // PHI指令的参数个数，等于所在基本块的前驱数
     // 操作数指针数组
     Operand ops[3];
     // 额外信息
     union {
-        char relop[32];
+        char* relop;    // 比较运算符（驻留字符串或字面量）
         int size;
+        Operand* args;  // PHI指令的参数，第i个参数来自所在基本块的第i个前驱
     };
-    // 前一条和后一条指令
+    // 前一条和后一条指令，只在翻译阶段拼接链表时使用，压缩成数组后置空
     InterCode pre;
     InterCode next;
 };
 
 int getSize(Type type);
 
+extern InterCode interCodes;
+extern int interCodeNum;
+
 void initInterCodes();
+InterCode allocInterCode();
+Operand allocOperand();
+void compactInterCodes(InterCode head);
+void beginRewrite(int capacity);
+InterCode emitInterCode(InterCode code);
+void finishRewrite();
+void printInterCodeStats(FILE* fp);
 void insertInterCode(InterCode code, InterCode interCodes);
 void printInterCodes(char* name);
-void printOperand(Operand op, FILE* fp);
+void printOperand(Operand op, OutBuffer out);
+Operand newTemp();
+Operand newLabel();
+Operand getValue(int num);
+char* invertRelop(char* relop);
 
 InterCode translateExp(Node* root, Operand place);
 InterCode translateArgs(Node* root, Operand argList);
@@ -60,11 +77,11 @@ InterCode translateCond(Node* root, Operand labelTrue, Operand labelFalse);
 void translateProgram(Node* root);
 InterCode translateExtDefList(Node* root);
 InterCode translateExtDef(Node* root);
-InterCode translateCompSt(Node* root, char* funcName);
+InterCode translateCompSt(Node* root);
 InterCode translateStmtList(Node* root);
-InterCode translateDefList(Node* root, IdType class);
-InterCode translateDef(Node* root, IdType class);
-FieldList translateDecList(Node* root, Type type, IdType class, InterCode code);
-FieldList translateDec(Node* root, Type type, IdType class, InterCode code);
+InterCode translateDefList(Node* root);
+InterCode translateDef(Node* root);
+void translateDecList(Node* root, InterCode code);
+void translateDec(Node* root, InterCode code);
 
 #endif
\ No newline at end of file
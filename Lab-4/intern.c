@@ -0,0 +1,90 @@
+#include <stddef.h>
+#include "intern.h"
+
+// 驻留字符串节点，散列值和长度存放在字符串内容之前
+typedef struct InternStr_d InternStr_;
+typedef InternStr_* InternStr;
+struct InternStr_d {
+    InternStr next;     // 同一槽位的下一个字符串
+    unsigned int hash;  // 字符串的散列值
+    int len;            // 字符串长度
+    char str[];         // 字符串内容，以'\0'结尾
+};
+
+InternStr* internTable = NULL;
+int internSize = 0;
+int internCount = 0;
+
+// 散列函数（FNV-1a）
+unsigned int hashString(char* str, int len) {
+    unsigned int val = 2166136261u;
+    for (int i = 0; i < len; i++) {
+        val ^= (unsigned char)str[i];
+        val *= 16777619u;
+    }
+    return val;
+}
+
+// 槽位数翻倍，重新分配所有字符串
+void resizeInternTable() {
+    int newSize = internSize == 0 ? INTERN_INIT_SIZE : internSize * 2;
+    InternStr* newTable = (InternStr*)calloc(newSize, sizeof(InternStr));
+    for (int i = 0; i < internSize; i++) {
+        InternStr curr = internTable[i];
+        while (curr != NULL) {
+            InternStr next = curr->next;
+            unsigned int slot = curr->hash & (newSize - 1);
+            curr->next = newTable[slot];
+            newTable[slot] = curr;
+            curr = next;
+        }
+    }
+    free(internTable);
+    internTable = newTable;
+    internSize = newSize;
+}
+
+char* internLen(char* str, int len) {
+    unsigned int hash = hashString(str, len);
+    if (internTable != NULL) {
+        InternStr curr = internTable[hash & (internSize - 1)];
+        while (curr != NULL) {
+            if (curr->hash == hash && curr->len == len && memcmp(curr->str, str, len) == 0)
+                return curr->str;
+            curr = curr->next;
+        }
+    }
+    // 装载因子超过3/4时扩容
+    if ((internCount + 1) * 4 > internSize * 3)
+        resizeInternTable();
+    InternStr res = (InternStr)malloc(sizeof(InternStr_) + len + 1);
+    res->hash = hash;
+    res->len = len;
+    memcpy(res->str, str, len);
+    res->str[len] = '\0';
+    unsigned int slot = hash & (internSize - 1);
+    res->next = internTable[slot];
+    internTable[slot] = res;
+    internCount++;
+    return res->str;
+}
+
+char* intern(char* str) {
+    return internLen(str, strlen(str));
+}
+
+char* internConcat(char* prefix, char* str) {
+    int preLen = strlen(prefix);
+    int len = strlen(str);
+    char* buf = (char*)malloc(preLen + len);
+    memcpy(buf, prefix, preLen);
+    memcpy(buf + preLen, str, len);
+    char* res = internLen(buf, preLen + len);
+    free(buf);
+    return res;
+}
+
+unsigned int internHash(char* name) {
+    InternStr node = (InternStr)(name - offsetof(InternStr_, str));
+    return node->hash;
+}
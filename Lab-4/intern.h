@@ -0,0 +1,20 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 驻留字符串表初始槽位数（必须是2的幂）
+#define INTERN_INIT_SIZE 256
+
+// 字符串驻留：内容相同的字符串只保存一份，返回的指针在整个编译过程中有效
+// 驻留后的名字可以直接用指针判断是否相等，不需要strcmp
+char* intern(char* str);
+char* internLen(char* str, int len);
+// 拼接两个字符串后驻留，用于生成带前缀的名字
+char* internConcat(char* prefix, char* str);
+// 取出驻留字符串在驻留时计算好的散列值，参数必须是intern返回的指针
+unsigned int internHash(char* name);
+
+#endif
@@ -0,0 +1,620 @@
+#include <limits.h>
+#include "ivsr.h"
+
+extern int tmpVarNo;
+
+// 归纳变量强度削弱的统计信息，清理会重复运行，基本归纳变量按SSA值只计一次
+static int basicTotal = 0;
+static int reduceTotal = 0;
+static int mulTotal = 0;
+static int testTotal = 0;
+static char* basicCounted = NULL;
+static int basicCountedCap = 0;
+
+// 值作为归纳变量的种类：循环头的PHI、它加上步长之后的值、由它们线性派生的值
+enum { IV_NONE, IV_BASIC, IV_NEXT, IV_DERIVED };
+
+// 归纳变量，值 = scale * 基本归纳变量 + 循环不变量
+typedef struct IVInfo_d {
+    int kind;
+    Loop loop;
+    int basic;      // 所属基本归纳变量（循环头PHI）的值编号
+    int post;       // 是否跟随基本归纳变量加上步长之后的版本
+    int scale;
+    int step;       // 每次迭代增加的常量
+    Operand init;   // 基本归纳变量进入循环时的值
+    int next;       // 基本归纳变量加上步长之后的值编号
+    int from;       // 派生归纳变量：定值中作为归纳变量的操作数的值编号和位置，以及运算和另一个操作数
+    int side;
+    int op;
+    Operand other;
+    int reduce;     // 是否为它新建归纳变量
+    int rep;        // 同一个线性式的派生归纳变量共用一个新归纳变量，rep是其中最先出现的那个
+    int order;      // 按逆后序发现的次序，线性式越复杂越靠后
+    Operand pre;    // 新建的归纳变量：循环头PHI的结果和加上步长之后的值
+    Operand post2;
+} IVInfo;
+
+// 重写时插入的指令，key为2i表示插在第i条指令之前，2i+1表示之后
+typedef struct Extra_d {
+    int key;
+    int seq;
+    InterCode_ code;
+} Extra;
+
+static CFG cfg = NULL;
+static int valueCount = 0;
+static IVInfo* iv = NULL;
+static int* defAt = NULL;
+static Loop* defLoop = NULL;
+static int* bucket = NULL;      // 按线性式散列派生归纳变量的代表
+static int* chain = NULL;
+static int bucketMask = 0;
+static Extra* extras = NULL;
+static int extraNum = 0;
+static int extraCap = 0;
+
+static void addExtra(int key, int kind, Operand a, Operand b, Operand c) {
+    if (extraNum == extraCap) {
+        extraCap = extraCap > 0 ? extraCap * 2 : 64;
+        extras = (Extra*)realloc(extras, sizeof(Extra) * extraCap);
+    }
+    Extra* extra = &extras[extraNum];
+    memset(extra, 0, sizeof(Extra));
+    extra->key = key;
+    extra->seq = extraNum++;
+    extra->code.kind = kind;
+    extra->code.ops[0] = a;
+    extra->code.ops[1] = b;
+    extra->code.ops[2] = c;
+}
+
+static int compareExtra(const void* a, const void* b) {
+    const Extra* x = (const Extra*)a;
+    const Extra* y = (const Extra*)b;
+    if (x->key != y->key)
+        return x->key - y->key;
+    return x->seq - y->seq;
+}
+
+static IVInfo* ivOf(Operand op) {
+    int v = valueNo(op);
+    if (v < 0 || v >= valueCount || iv[v].kind == IV_NONE)
+        return NULL;
+    return &iv[v];
+}
+
+// 操作数在循环中是否不变：常量、数组和结构体的地址以及在循环外定值的SSA值
+static int invariant(Operand op, Loop loop) {
+    if (op->kind == CONSTANT_OP)
+        return 1;
+    if (op->kind == GET_ADDR_OP)
+        return valueNo(op->opr) < 0;
+    int v = valueNo(op);
+    return v >= 0 && v < valueCount && !inLoop(defLoop[v], loop);
+}
+
+// 循环外唯一前驱只有循环头一个后继时，新归纳变量的初值算在它的末尾，返回插入位置的key，不满足时返回-1
+static int entryKey(Loop loop) {
+    Block entry = NULL;
+    int outside = 0;
+    for (int j = 0; j < loop->header->predNum; j++)
+        if (!inLoop(loop->header->preds[j]->loop, loop)) {
+            entry = loop->header->preds[j];
+            outside++;
+        }
+    if (outside != 1 || entry->rpoNo < 0 || entry->succNum != 1)
+        return -1;
+    InterCode last = &interCodes[entry->end - 1];
+    return last->kind == GOTO_IR || last->kind == IF_GOTO_IR ? 2 * (entry->end - 1) : 2 * (entry->end - 1) + 1;
+}
+
+/*
+* 基本归纳变量：循环头的PHI，循环外的参数是初值，来自循环内的参数都是它加上（或减去）同一个常量的结果
+*/
+static void findBasic(int* entryKeys) {
+    for (int l = 0; l < cfg->loopNum; l++) {
+        Loop loop = &cfg->loops[l];
+        if (entryKeys[l] < 0)
+            continue;
+        Block header = loop->header;
+        for (int i = header->start; i < header->end; i++) {
+            InterCode code = &interCodes[i];
+            if (code->kind != PHI_IR)
+                continue;
+            int v = valueNo(code->ops[0]);
+            Operand init = NULL;
+            int next = -1, ok = v >= 0 && v < valueCount;
+            for (int j = 0; j < code->argNum && ok; j++) {
+                if (!inLoop(header->preds[j]->loop, loop)) {
+                    init = code->args[j];
+                    ok = init != NULL;
+                    continue;
+                }
+                int a = valueNo(code->args[j]);
+                if (a < 0 || a >= valueCount || (next >= 0 && next != a))
+                    ok = 0;
+                next = a;
+            }
+            if (!ok || init == NULL || next < 0 || defAt[next] < 0 || !inLoop(defLoop[next], loop))
+                continue;
+            InterCode inc = &interCodes[defAt[next]];
+            int step;
+            if (inc->kind == PLUS_IR && valueNo(inc->ops[1]) == v && inc->ops[2]->kind == CONSTANT_OP)
+                step = inc->ops[2]->value;
+            else if (inc->kind == PLUS_IR && valueNo(inc->ops[2]) == v && inc->ops[1]->kind == CONSTANT_OP)
+                step = inc->ops[1]->value;
+            else if (inc->kind == SUB_IR && valueNo(inc->ops[1]) == v && inc->ops[2]->kind == CONSTANT_OP)
+                step = -inc->ops[2]->value;
+            else
+                continue;
+            iv[v].kind = IV_BASIC;
+            iv[v].loop = loop;
+            iv[v].basic = v;
+            iv[v].scale = 1;
+            iv[v].step = step;
+            iv[v].init = init;
+            iv[v].next = next;
+            iv[next].kind = IV_NEXT;
+            iv[next].loop = loop;
+            iv[next].basic = v;
+            iv[next].post = 1;
+            iv[next].scale = 1;
+        }
+    }
+}
+
+// 运算的另一个操作数的散列值和相等判断，地址按变量名比较
+static unsigned int otherHash(Operand op) {
+    if (op->kind == CONSTANT_OP)
+        return (unsigned int)op->value;
+    if (op->kind == GET_ADDR_OP)
+        return (unsigned int)(size_t)op->opr->name;
+    return (unsigned int)valueNo(op) * 2654435761u;
+}
+
+static int sameOther(Operand a, Operand b) {
+    if (a->kind != b->kind)
+        return 0;
+    if (a->kind == CONSTANT_OP)
+        return a->value == b->value;
+    if (a->kind == GET_ADDR_OP)
+        return a->opr->name == b->opr->name;
+    return valueNo(a) == valueNo(b);
+}
+
+// 派生归纳变量的线性式由运算、操作数所属的类和另一个操作数决定，可交换的运算不区分位置
+static int classOf(int v) {
+    IVInfo* info = &iv[v];
+    int from = iv[info->from].kind == IV_DERIVED ? iv[info->from].rep : info->basic;
+    int side = info->op == SUB_IR ? info->side : 1;
+    unsigned int h = ((unsigned int)info->op * 31 + (unsigned int)from * 7 + (unsigned int)side) ^ otherHash(info->other);
+    h = (h * 2654435761u) & bucketMask;
+    for (int c = bucket[h]; c >= 0; c = chain[c]) {
+        IVInfo* rep = &iv[c];
+        int repFrom = iv[rep->from].kind == IV_DERIVED ? iv[rep->from].rep : rep->basic;
+        int repSide = rep->op == SUB_IR ? rep->side : 1;
+        if (rep->op == info->op && repFrom == from && repSide == side && sameOther(rep->other, info->other))
+            return c;
+    }
+    chain[v] = bucket[h];
+    bucket[h] = v;
+    return v;
+}
+
+/*
+* 派生归纳变量：归纳变量乘常量、加减循环不变量的结果，按逆后序处理使操作数先于使用确定
+* 乘法以及建立在已削弱的归纳变量上的加减法需要削弱，不同块中相同的线性式归为一类
+*/
+static void findDerived() {
+    int order = 0;
+    for (int r = 0; r < cfg->rpoNum; r++) {
+        Block block = cfg->rpo[r];
+        if (block->loop == NULL)
+            continue;
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            if (code->kind != PLUS_IR && code->kind != SUB_IR && code->kind != MUL_IR)
+                continue;
+            int d = valueNo(code->ops[0]);
+            if (d < 0 || d >= valueCount || iv[d].kind != IV_NONE)
+                continue;
+            IVInfo* a = ivOf(code->ops[1]);
+            IVInfo* b = ivOf(code->ops[2]);
+            IVInfo* x;
+            int side;
+            if (a != NULL && b == NULL && invariant(code->ops[2], a->loop)) {
+                x = a;
+                side = 1;
+            }
+            else if (b != NULL && a == NULL && invariant(code->ops[1], b->loop)) {
+                x = b;
+                side = 2;
+            }
+            else
+                continue;
+            if (!inLoop(block->loop, x->loop))
+                continue;
+            Operand other = code->ops[3 - side];
+            int scale = x->scale;
+            if (code->kind == SUB_IR && side == 2)
+                scale = -scale;
+            else if (code->kind == MUL_IR) {
+                // 步长必须是常量，系数太大时不处理以免溢出
+                if (other->kind != CONSTANT_OP || other->value > 65536 || other->value < -65536)
+                    continue;
+                scale *= other->value;
+            }
+            if (scale == 0 || scale > (1 << 24) || scale < -(1 << 24))
+                continue;
+            IVInfo* info = &iv[d];
+            info->kind = IV_DERIVED;
+            info->loop = x->loop;
+            info->basic = x->basic;
+            info->post = x->post;
+            info->scale = scale;
+            info->from = valueNo(code->ops[side]);
+            info->side = side;
+            info->op = code->kind;
+            info->other = other;
+            info->reduce = code->kind == MUL_IR || x->reduce;
+            info->rep = classOf(d);
+            info->order = order++;
+        }
+    }
+}
+
+// 按运算计算常量，和目标机一样按32位回绕
+static int fold(int kind, int a, int b) {
+    unsigned int x = (unsigned int)a, y = (unsigned int)b;
+    switch (kind) {
+        case PLUS_IR:
+            return (int)(x + y);
+        case SUB_IR:
+            return (int)(x - y);
+        default:
+            return (int)(x * y);
+    }
+}
+
+/*
+* 把基本归纳变量换成x，重新计算派生归纳变量v的值，指令插在key处，memo非空时记住已算出的结果
+* 结果就是新归纳变量的初值（x为初值）或者循环条件中界的对应值（x为界）
+*/
+static Operand replay(int v, Operand x, int key, Operand* memo) {
+    IVInfo* info = &iv[v];
+    if (info->kind != IV_DERIVED)
+        return x;
+    if (memo != NULL && memo[v] != NULL)
+        return memo[v];
+    Operand a = replay(info->from, x, key, memo);
+    Operand b = info->other;
+    if (info->side == 2) {
+        b = a;
+        a = info->other;
+    }
+    Operand result;
+    if (a->kind == CONSTANT_OP && b->kind == CONSTANT_OP)
+        result = getValue(fold(info->op, a->value, b->value));
+    else if (info->op != MUL_IR && b->kind == CONSTANT_OP && b->value == 0)
+        result = a;
+    else if (info->op == PLUS_IR && a->kind == CONSTANT_OP && a->value == 0)
+        result = b;
+    else {
+        result = newTemp();
+        addExtra(key, info->op, result, a, b);
+    }
+    if (memo != NULL)
+        memo[v] = result;
+    return result;
+}
+
+// 循环头中PHI之后的位置
+static int phiKey(Block header) {
+    int i = header->start;
+    if (interCodes[i].kind != LABEL_IR && interCodes[i].kind != PHI_IR)
+        return 2 * i;
+    while (i + 1 < header->end && interCodes[i+1].kind == PHI_IR)
+        i++;
+    return 2 * i + 1;
+}
+
+// 第一次从基本归纳变量v削弱出派生归纳变量时计数
+static void countBasic(int v) {
+    if (basicCountedCap < tmpVarNo) {
+        int cap = basicCountedCap * 2 > tmpVarNo ? basicCountedCap * 2 : tmpVarNo;
+        basicCounted = (char*)realloc(basicCounted, cap);
+        memset(basicCounted + basicCountedCap, 0, cap - basicCountedCap);
+        basicCountedCap = cap;
+    }
+    if (!basicCounted[ssaBase + v]) {
+        basicCounted[ssaBase + v] = 1;
+        basicTotal++;
+    }
+}
+
+// 为需要削弱的派生归纳变量新建归纳变量：循环头的PHI，基本归纳变量加步长处紧跟着加上scale倍的步长
+static int reduceDerived(int* entryKeys, Operand* memo) {
+    int num = 0;
+    for (int v = 0; v < valueCount; v++) {
+        IVInfo* info = &iv[v];
+        if (info->kind != IV_DERIVED || !info->reduce || info->rep != v)
+            continue;
+        IVInfo* basic = &iv[info->basic];
+        Loop loop = info->loop;
+        Operand init = replay(v, basic->init, entryKeys[loop - cfg->loops], memo);
+        info->pre = newTemp();
+        info->post2 = newTemp();
+        Block header = loop->header;
+        addExtra(phiKey(header), PHI_IR, info->pre, NULL, NULL);
+        Extra* phi = &extras[extraNum - 1];
+        phi->code.argNum = header->predNum;
+        phi->code.args = allocPhiArgs(header->predNum);
+        for (int j = 0; j < header->predNum; j++)
+            phi->code.args[j] = inLoop(header->preds[j]->loop, loop) ? info->post2 : init;
+        addExtra(2 * defAt[basic->next] + 1, PLUS_IR, info->post2, info->pre,
+            getValue(fold(MUL_IR, info->scale, basic->step)));
+        countBasic(info->basic);
+        num++;
+    }
+    return num;
+}
+
+static char* flipRelop(char* relop) {
+    if (strcmp(relop, "<") == 0)
+        return ">";
+    if (strcmp(relop, ">") == 0)
+        return "<";
+    if (strcmp(relop, "<=") == 0)
+        return ">=";
+    if (strcmp(relop, ">=") == 0)
+        return "<=";
+    return relop;
+}
+
+static void countUse(Operand op, int* uses) {
+    if (op != NULL && (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP))
+        op = op->opr;
+    int v = valueNo(op);
+    if (v >= 0 && v < valueCount)
+        uses[v]++;
+}
+
+// 数组或结构体变量声明的字节数，找不到声明时返回-1
+static int declaredSize(Operand var) {
+    for (int i = 0; i < interCodeNum; i++)
+        if (interCodes[i].kind == DEC_IR && interCodes[i].ops[0]->name == var->name)
+            return interCodes[i].size;
+    return -1;
+}
+
+/*
+* 基本归纳变量取常量x时派生归纳变量v的值，结果为基址加偏移，基址只能是数组或结构体的地址
+* 线性式中有非常量的循环不变量时无法确定，返回0
+*/
+static int evalLinear(int v, long long x, Operand* base, long long* offset) {
+    IVInfo* info = &iv[v];
+    if (info->kind != IV_DERIVED) {
+        *base = NULL;
+        *offset = x;
+        return 1;
+    }
+    if (!evalLinear(info->from, x, base, offset))
+        return 0;
+    Operand other = info->other;
+    if (other->kind == GET_ADDR_OP) {
+        if (*base != NULL || info->op != PLUS_IR)
+            return 0;
+        *base = other;
+        return 1;
+    }
+    if (other->kind != CONSTANT_OP)
+        return 0;
+    if (info->op == PLUS_IR)
+        *offset += other->value;
+    else if (info->op == SUB_IR && info->side == 1)
+        *offset -= other->value;
+    else if (*base != NULL)
+        return 0;
+    else if (info->op == SUB_IR)
+        *offset = other->value - *offset;
+    else
+        *offset *= other->value;
+    return 1;
+}
+
+/*
+* 替换后的比较只有在新归纳变量不回绕时才和原来等价：初值和界都是常量，
+* 基本归纳变量在两者之间（多走一步）取值时，不含地址的线性式不超出int的范围，
+* 含数组地址的线性式偏移不超出数组声明的大小
+*/
+static int noWrap(int w, Operand init, Operand bound, int step) {
+    if (init->kind != CONSTANT_OP || bound->kind != CONSTANT_OP)
+        return 0;
+    long long lo = init->value < bound->value ? init->value : bound->value;
+    long long hi = init->value < bound->value ? bound->value : init->value;
+    long long slack = step < 0 ? -(long long)step : step;
+    for (int k = 0; k < 2; k++) {
+        Operand base;
+        long long offset;
+        if (!evalLinear(w, k == 0 ? lo : hi, &base, &offset))
+            return 0;
+        if (base != NULL) {
+            if (offset < 0 || offset > declaredSize(base->opr))
+                return 0;
+            continue;
+        }
+        evalLinear(w, k == 0 ? lo - slack : hi + slack, &base, &offset);
+        if (offset < INT_MIN || offset > INT_MAX)
+            return 0;
+    }
+    return 1;
+}
+
+/*
+* 线性函数测试替换：基本归纳变量除了加步长以外只在循环条件中和不变量比较时，
+* 把比较换成某个新归纳变量和界的对应值的比较，系数为负时比较方向相反，之后基本归纳变量成为死代码
+* 新归纳变量可能回绕时保留原来的比较
+*/
+static int replaceTests(int* entryKeys) {
+    int* uses = (int*)calloc(valueCount, sizeof(int));
+    int* witness = (int*)malloc(sizeof(int) * valueCount);
+    for (int v = 0; v < valueCount; v++)
+        witness[v] = -1;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind == PHI_IR) {
+            for (int j = 0; j < code->argNum; j++)
+                countUse(code->args[j], uses);
+            continue;
+        }
+        for (int k = definesOp(code); k < 3; k++)
+            countUse(code->ops[k], uses);
+    }
+    // 削弱后派生归纳变量的定值变成拷贝，不再使用原来的归纳变量
+    for (int v = 0; v < valueCount; v++) {
+        IVInfo* info = &iv[v];
+        if (info->kind == IV_DERIVED && info->reduce) {
+            uses[info->from]--;
+            // 用最后出现的线性式替换，它通常就是访问数组的指针，削弱后仍然要用
+            int w = witness[info->basic];
+            if (w < 0 || iv[w].order < iv[info->rep].order)
+                witness[info->basic] = info->rep;
+        }
+        else if (info->kind == IV_BASIC) {
+            uses[v]--;
+            for (int j = 0; j < info->loop->header->predNum; j++)
+                if (inLoop(info->loop->header->preds[j]->loop, info->loop))
+                    uses[info->next]--;
+        }
+    }
+    int num = 0;
+    for (int v = 0; v < valueCount; v++) {
+        IVInfo* basic = &iv[v];
+        if (basic->kind != IV_BASIC || witness[v] < 0 || uses[v] + uses[basic->next] != 1)
+            continue;
+        Loop loop = basic->loop;
+        for (int j = 0; j < loop->blockNum; j++) {
+            InterCode code = &interCodes[loop->blocks[j]->end - 1];
+            if (code->kind != IF_GOTO_IR)
+                continue;
+            int side = -1;
+            for (int k = 0; k < 2; k++)
+                if (valueNo(code->ops[k]) == v || valueNo(code->ops[k]) == basic->next)
+                    side = k;
+            if (side < 0 || !invariant(code->ops[1 - side], loop) ||
+                !noWrap(witness[v], basic->init, code->ops[1 - side], basic->step))
+                continue;
+            IVInfo* r = &iv[witness[v]];
+            Operand bound = replay(witness[v], code->ops[1 - side], entryKeys[loop - cfg->loops], NULL);
+            code->ops[side] = valueNo(code->ops[side]) == v ? r->pre : r->post2;
+            code->ops[1 - side] = bound;
+            if (r->scale < 0)
+                code->relop = flipRelop(code->relop);
+            num++;
+            break;
+        }
+    }
+    free(uses);
+    free(witness);
+    return num;
+}
+
+static void rewriteCodes() {
+    qsort(extras, extraNum, sizeof(Extra), compareExtra);
+    beginRewrite(interCodeNum + extraNum);
+    int e = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        while (e < extraNum && extras[e].key == 2 * i)
+            emitInterCode(&extras[e++].code);
+        InterCode code = &interCodes[i];
+        int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+        InterCode copy = emitInterCode(code);
+        // 削弱的派生归纳变量改成新归纳变量的拷贝，交给拷贝传播删除
+        if (v >= 0 && v < valueCount && iv[v].kind == IV_DERIVED && iv[v].reduce) {
+            copy->kind = ASSIGN_IR;
+            IVInfo* rep = &iv[iv[v].rep];
+            copy->ops[1] = iv[v].post ? rep->post2 : rep->pre;
+            copy->ops[2] = NULL;
+            if (iv[v].op == MUL_IR)
+                mulTotal++;
+        }
+        while (e < extraNum && extras[e].key == 2 * i + 1)
+            emitInterCode(&extras[e++].code);
+    }
+    finishRewrite();
+}
+
+/*
+* 循环中的归纳变量强度削弱：数组下标乘元素大小再加基址的地址运算，改成每次迭代加常量的指针，
+* 乘法只在循环前计算一次初值；循环条件只用到原下标时同时替换循环条件，原下标由死代码删除去掉
+* 只处理循环外唯一前驱直接进入循环头的循环，返回新建的归纳变量数和替换的循环条件数
+*/
+int reduceStrength() {
+    valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0 || interCodeNum == 0 || !hasBackJump(0, interCodeNum))
+        return 0;
+    cfg = buildCFG(0, interCodeNum);
+    if (cfg->loopNum == 0) {
+        freeCFG(cfg);
+        return 0;
+    }
+    iv = (IVInfo*)calloc(valueCount, sizeof(IVInfo));
+    defAt = (int*)malloc(sizeof(int) * valueCount);
+    defLoop = (Loop*)calloc(valueCount, sizeof(Loop));
+    for (int v = 0; v < valueCount; v++)
+        defAt[v] = -1;
+    for (int b = 0; b < cfg->blockNum; b++)
+        for (int i = cfg->blocks[b].start; i < cfg->blocks[b].end; i++) {
+            InterCode code = &interCodes[i];
+            int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+            if (v >= 0 && v < valueCount) {
+                defAt[v] = i;
+                defLoop[v] = cfg->blocks[b].loop;
+            }
+        }
+    int* entryKeys = (int*)malloc(sizeof(int) * cfg->loopNum);
+    for (int l = 0; l < cfg->loopNum; l++)
+        entryKeys[l] = entryKey(&cfg->loops[l]);
+    findBasic(entryKeys);
+    int size = 64;
+    while (size < 2 * valueCount)
+        size *= 2;
+    bucketMask = size - 1;
+    bucket = (int*)malloc(sizeof(int) * size);
+    chain = (int*)malloc(sizeof(int) * valueCount);
+    for (int h = 0; h < size; h++)
+        bucket[h] = -1;
+    findDerived();
+    Operand* memo = (Operand*)calloc(valueCount, sizeof(Operand));
+    extraNum = 0;
+    int reduced = reduceDerived(entryKeys, memo);
+    int tests = 0;
+    if (reduced > 0) {
+        tests = replaceTests(entryKeys);
+        rewriteCodes();
+    }
+    reduceTotal += reduced;
+    testTotal += tests;
+    free(memo);
+    free(bucket);
+    free(chain);
+    free(entryKeys);
+    free(iv);
+    free(defAt);
+    free(defLoop);
+    freeCFG(cfg);
+    iv = NULL;
+    bucket = NULL;
+    chain = NULL;
+    defAt = NULL;
+    defLoop = NULL;
+    cfg = NULL;
+    return reduced + tests;
+}
+
+// 打印归纳变量强度削弱的统计信息
+void printIVSRStats(FILE* fp) {
+    fprintf(fp, "ivsr: %d derived induction variables reduced from %d basic ones, %d multiplies removed, %d loop tests replaced\n",
+        reduceTotal, basicTotal, mulTotal, testTotal);
+}
@@ -0,0 +1,9 @@
+#ifndef IVSR_H
+#define IVSR_H
+
+#include "ssa.h"
+
+int reduceStrength();
+void printIVSRStats(FILE* fp);
+
+#endif
@@ -546,6 +546,7 @@ char *yytext;
     #include <stdlib.h>
     #include <ctype.h>
     #include "Tree.h"
+    #include "intern.h"
     #define YYSTYPE Node*
     #include "syntax.tab.h"
     int yycolumn = 1;
@@ -558,8 +559,8 @@ char *yytext;
     int charToi(char ch);
     int hexstrToi(char* text);
     int octstrToi(char* text);
-#line 562 "./lex.yy.c"
 #line 563 "./lex.yy.c"
+#line 564 "./lex.yy.c"
 
 #define INITIAL 0
 
@@ -778,7 +779,7 @@ YY_DECL
 	{
 #line 32 "./lexical.l"
 
-#line 782 "./lex.yy.c"
+#line 783 "./lex.yy.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -848,220 +849,220 @@ do_action:	/* This label is used only to access EOF actions. */
 case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
-#line 33 "./lexical.l"
+#line 34 "./lexical.l"
 { yycolumn = 1; }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 34 "./lexical.l"
+#line 35 "./lexical.l"
 { }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 35 "./lexical.l"
+#line 36 "./lexical.l"
 { char c = input(); 
               while (c != '\n') c = input(); }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 37 "./lexical.l"
+#line 38 "./lexical.l"
 { char a = input();
               char b = input();
               while (!(a == '*' && b == '/')) { a = b; b = input(); } }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 40 "./lexical.l"
-{ yylval = createNode("SEMI", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 41 "./lexical.l"
+{ yylval = createNode("SEMI", ENUM_TK_SEMI, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return SEMI; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 42 "./lexical.l"
-{ yylval = createNode("COMMA", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 43 "./lexical.l"
+{ yylval = createNode("COMMA", ENUM_TK_COMMA, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return COMMA; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 44 "./lexical.l"
-{ yylval = createNode("ASSIGNOP", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 45 "./lexical.l"
+{ yylval = createNode("ASSIGNOP", ENUM_TK_ASSIGNOP, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return ASSIGNOP; }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 46 "./lexical.l"
-{ yylval = createNode("PLUS", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 47 "./lexical.l"
+{ yylval = createNode("PLUS", ENUM_TK_PLUS, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return PLUS; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 48 "./lexical.l"
-{ yylval = createNode("MINUS", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 49 "./lexical.l"
+{ yylval = createNode("MINUS", ENUM_TK_MINUS, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return MINUS; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 50 "./lexical.l"
-{ yylval = createNode("STAR", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 51 "./lexical.l"
+{ yylval = createNode("STAR", ENUM_TK_STAR, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return STAR; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 52 "./lexical.l"
-{ yylval = createNode("DIV", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 53 "./lexical.l"
+{ yylval = createNode("DIV", ENUM_TK_DIV, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return DIV; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 54 "./lexical.l"
-{ yylval = createNode("AND", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 55 "./lexical.l"
+{ yylval = createNode("AND", ENUM_TK_AND, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return AND; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 56 "./lexical.l"
-{ yylval = createNode("OR", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 57 "./lexical.l"
+{ yylval = createNode("OR", ENUM_TK_OR, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return OR; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 58 "./lexical.l"
-{ yylval = createNode("DOT", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 59 "./lexical.l"
+{ yylval = createNode("DOT", ENUM_TK_DOT, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return DOT; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 60 "./lexical.l"
-{ yylval = createNode("NOT", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 61 "./lexical.l"
+{ yylval = createNode("NOT", ENUM_TK_NOT, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return NOT; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 62 "./lexical.l"
-{ yylval = createNode("LP", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 63 "./lexical.l"
+{ yylval = createNode("LP", ENUM_TK_LP, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return LP; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 64 "./lexical.l"
-{ yylval = createNode("RP", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 65 "./lexical.l"
+{ yylval = createNode("RP", ENUM_TK_RP, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return RP; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 66 "./lexical.l"
-{ yylval = createNode("LB", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 67 "./lexical.l"
+{ yylval = createNode("LB", ENUM_TK_LB, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return LB; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 68 "./lexical.l"
-{ yylval = createNode("RB", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 69 "./lexical.l"
+{ yylval = createNode("RB", ENUM_TK_RB, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return RB; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 70 "./lexical.l"
-{ yylval = createNode("LC", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 71 "./lexical.l"
+{ yylval = createNode("LC", ENUM_TK_LC, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return LC; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 72 "./lexical.l"
-{ yylval = createNode("RC", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 73 "./lexical.l"
+{ yylval = createNode("RC", ENUM_TK_RC, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return RC; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 74 "./lexical.l"
-{ yylval = createNode("STRUCT", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 75 "./lexical.l"
+{ yylval = createNode("STRUCT", ENUM_TK_STRUCT, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return STRUCT; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 76 "./lexical.l"
-{ yylval = createNode("RETURN", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 77 "./lexical.l"
+{ yylval = createNode("RETURN", ENUM_TK_RETURN, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return RETURN; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 78 "./lexical.l"
-{ yylval = createNode("IF", ENUM_LEX_OTHER, yylineno, 0, NULL); 
+#line 79 "./lexical.l"
+{ yylval = createNode("IF", ENUM_TK_IF, ENUM_LEX_OTHER, yylineno, 0, NULL); 
               return IF; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 80 "./lexical.l"
-{ yylval = createNode("ELSE", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 81 "./lexical.l"
+{ yylval = createNode("ELSE", ENUM_TK_ELSE, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return ELSE; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 82 "./lexical.l"
-{ yylval = createNode("WHILE", ENUM_LEX_OTHER, yylineno, 0, NULL);
+#line 83 "./lexical.l"
+{ yylval = createNode("WHILE", ENUM_TK_WHILE, ENUM_LEX_OTHER, yylineno, 0, NULL);
               return WHILE; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 84 "./lexical.l"
-{ yylval = createNode("RELOP", ENUM_LEX_OTHER, yylineno, 0, NULL);
-              strcpy(yylval->strVal, yytext);
+#line 85 "./lexical.l"
+{ yylval = createNode("RELOP", ENUM_TK_RELOP, ENUM_LEX_OTHER, yylineno, 0, NULL);
+              yylval->strVal = internLen(yytext, yyleng);
               return RELOP; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 87 "./lexical.l"
-{ yylval = createNode("TYPE", ENUM_LEX_TYPE, yylineno, 0, NULL);
-              strcpy(yylval->strVal, yytext);
+#line 88 "./lexical.l"
+{ yylval = createNode("TYPE", ENUM_TK_TYPE, ENUM_LEX_TYPE, yylineno, 0, NULL);
+              yylval->strVal = internLen(yytext, yyleng);
               return TYPE; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 90 "./lexical.l"
-{ yylval = createNode("INT", ENUM_LEX_INT, yylineno, 0, NULL);
+#line 91 "./lexical.l"
+{ yylval = createNode("INT", ENUM_TK_INT, ENUM_LEX_INT, yylineno, 0, NULL);
               yylval->intVal = hexstrToi(yytext);
               return INT; }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 93 "./lexical.l"
-{ yylval = createNode("INT", ENUM_LEX_INT, yylineno, 0, NULL);
+#line 94 "./lexical.l"
+{ yylval = createNode("INT", ENUM_TK_INT, ENUM_LEX_INT, yylineno, 0, NULL);
               yylval->intVal = octstrToi(yytext);
               return INT; }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 96 "./lexical.l"
-{ yylval = createNode("INT", ENUM_LEX_INT, yylineno, 0, NULL);
+#line 97 "./lexical.l"
+{ yylval = createNode("INT", ENUM_TK_INT, ENUM_LEX_INT, yylineno, 0, NULL);
               yylval->intVal = atoi(yytext);
               return INT; }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 99 "./lexical.l"
-{ yylval = createNode("FLOAT", ENUM_LEX_FLOAT, yylineno, 0, NULL);
+#line 100 "./lexical.l"
+{ yylval = createNode("FLOAT", ENUM_TK_FLOAT, ENUM_LEX_FLOAT, yylineno, 0, NULL);
               yylval->floatVal = atof(yytext);
               return FLOAT; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 102 "./lexical.l"
-{ yylval = createNode("ID", ENUM_LEX_ID, yylineno, 0, NULL);
-              strcpy(yylval->strVal, yytext);
+#line 103 "./lexical.l"
+{ yylval = createNode("ID", ENUM_TK_ID, ENUM_LEX_ID, yylineno, 0, NULL);
+              yylval->strVal = internLen(yytext, yyleng);
               return ID; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 105 "./lexical.l"
+#line 106 "./lexical.l"
 { printf("Error type A at Line %d: Mysterious characters \'%s\'\n", yylineno, yytext); 
               lexError++; }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 107 "./lexical.l"
+#line 108 "./lexical.l"
 ECHO;
 	YY_BREAK
-#line 1065 "./lex.yy.c"
+#line 1066 "./lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2078,7 +2079,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 107 "./lexical.l"
+#line 108 "./lexical.l"
 
 int charToi(char ch)
 {   // 如果是数字，则用数字的ASCII码减去48, 如果ch = '2' ,则 '2' - 48 = 2
@@ -0,0 +1,363 @@
+#include "licm.h"
+
+extern int tmpVarNo;
+extern int labelNo;
+
+// 循环不变代码外提的统计信息，清理会重复运行，循环按循环头的标记只计一次
+static int hoistTotal = 0;
+static int loopTotal = 0;
+static int preheaderTotal = 0;
+static char* loopCounted = NULL;
+static int loopCountedCap = 0;
+
+// 前置块的位置：循环外唯一前驱的末尾、循环头之前的新块、函数末尾的新块
+enum { PRE_TAIL, PRE_BEFORE, PRE_APPEND };
+
+// 循环的外提信息，按循环在cfg->loops中的下标索引
+typedef struct LoopInfo_d {
+    Block entry;    // 循环外唯一的前驱，没有或者有多个时为NULL，不向这个循环外提
+    int writes;     // 循环中是否有写内存的指令
+    int exitNum;    // 有后继在循环外的块，-1表示还没有统计
+    Block* exits;
+    int place;      // 前置块的位置
+    Operand label;  // 新建的前置块的标记
+    int first;      // 外提到前置块的指令在hoisted中的范围
+    int num;
+} LoopInfo;
+
+static CFG cfg = NULL;
+static LoopInfo* info = NULL;
+static int valueCount = 0;
+// 值的定值所在的最内层循环，外提之后是前置块所在的循环，不在循环中时为NULL
+static Loop* valueLoop = NULL;
+
+// 操作数的值是否在循环外确定：常量、数组和结构体的地址以及在循环外定值的SSA值，读内存另外判断
+static int outsideLoop(Operand op, Loop loop) {
+    if (op == NULL)
+        return 1;
+    if (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP)
+        op = op->opr;
+    int v = valueNo(op);
+    return v < 0 || v >= valueCount || !inLoop(valueLoop[v], loop);
+}
+
+/*
+* 只有对SSA值定值的运算和拷贝可以外提，reads表示是否读内存
+* traps表示提前执行时是否可能出错：解引用的地址可能只在某些路径上有效，除数也可能只在某些路径上不为0
+*/
+static int movable(InterCode code, int* reads, int* traps) {
+    switch (code->kind) {
+        case ASSIGN_IR:
+        case PLUS_IR:
+        case SUB_IR:
+        case MUL_IR:
+        case DIV_IR:
+            break;
+        default:
+            return 0;
+    }
+    if (!definesOp(code) || valueNo(code->ops[0]) < 0)
+        return 0;
+    *reads = 0;
+    *traps = 0;
+    for (int k = 1; k < 3; k++) {
+        Operand op = code->ops[k];
+        if (op == NULL)
+            continue;
+        if (op->kind == GET_VAL_OP) {
+            *reads = 1;
+            *traps = 1;
+        }
+        else if ((op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP) && valueNo(op) < 0)
+            *reads = 1;
+    }
+    if (code->kind == DIV_IR && (code->ops[2]->kind != CONSTANT_OP || code->ops[2]->value == 0))
+        *traps = 1;
+    return 1;
+}
+
+// 基本块是否在循环的每次执行中都会执行：支配所有出口块，没有出口的循环只认循环头
+static int dominatesExits(Block block, Loop loop, LoopInfo* li) {
+    if (li->exitNum < 0) {
+        li->exits = (Block*)malloc(sizeof(Block) * loop->blockNum);
+        li->exitNum = 0;
+        for (int j = 0; j < loop->blockNum; j++) {
+            Block b = loop->blocks[j];
+            for (int k = 0; k < b->succNum; k++)
+                if (!inLoop(b->succs[k]->loop, loop)) {
+                    li->exits[li->exitNum++] = b;
+                    break;
+                }
+        }
+    }
+    if (li->exitNum == 0)
+        return block == loop->header;
+    for (int j = 0; j < li->exitNum; j++)
+        if (!dominates(block, li->exits[j]))
+            return 0;
+    return 1;
+}
+
+// 找出每个循环外唯一的前驱以及循环中是否写内存，同一个块只给一个循环做前驱
+static void collectLoops(int* entryOf) {
+    for (int l = 0; l < cfg->loopNum; l++) {
+        Loop loop = &cfg->loops[l];
+        LoopInfo* li = &info[l];
+        li->exitNum = -1;
+        Block entry = NULL;
+        int outside = 0;
+        for (int j = 0; j < loop->header->predNum; j++) {
+            Block pred = loop->header->preds[j];
+            if (!inLoop(pred->loop, loop)) {
+                entry = pred;
+                outside++;
+            }
+        }
+        if (outside == 1 && entry->rpoNo >= 0 && entryOf[entry->no] < 0) {
+            li->entry = entry;
+            entryOf[entry->no] = l;
+        }
+    }
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+            if (v >= 0 && v < valueCount)
+                valueLoop[v] = block->loop;
+            if (writesMemory(code))
+                for (Loop loop = block->loop; loop != NULL && !info[loop - cfg->loops].writes; loop = loop->parent)
+                    info[loop - cfg->loops].writes = 1;
+        }
+    }
+}
+
+/*
+* 按逆后序找出不变的指令，每条指令外提到它不变的最外层循环，操作数的定值先于使用处理，
+* 因此依赖已外提的值的指令也能接着外提，返回外提的指令数
+*/
+static int findInvariants(int* hoistTo, int* order) {
+    int num = 0;
+    for (int r = 0; r < cfg->rpoNum; r++) {
+        Block block = cfg->rpo[r];
+        for (int i = block->start; i < block->end && block->loop != NULL; i++) {
+            InterCode code = &interCodes[i];
+            int reads, traps;
+            if (!movable(code, &reads, &traps))
+                continue;
+            Loop target = NULL;
+            for (Loop loop = block->loop; loop != NULL; loop = loop->parent) {
+                LoopInfo* li = &info[loop - cfg->loops];
+                // 在某层循环中可变则在更外层也可变
+                if (!outsideLoop(code->ops[1], loop) || !outsideLoop(code->ops[2], loop) || (reads && li->writes))
+                    break;
+                if (li->entry == NULL || (traps && !dominatesExits(block, loop, li)))
+                    continue;
+                target = loop;
+            }
+            if (target == NULL)
+                continue;
+            hoistTo[i] = (int)(target - cfg->loops);
+            info[hoistTo[i]].num++;
+            order[num++] = i;
+            valueLoop[valueNo(code->ops[0])] = target->parent;
+        }
+    }
+    return num;
+}
+
+// 前置块代替原前驱进入循环头后，按新的块顺序重排循环头中PHI的参数
+static void reorderPhis(Block header, Block entry, int pos) {
+    int n = header->predNum;
+    int* perm = (int*)malloc(sizeof(int) * n * 2);
+    int* key = perm + n;
+    int moved = 0;
+    for (int j = 0; j < n; j++) {
+        key[j] = header->preds[j] == entry ? pos : 2 * header->preds[j]->no;
+        int k = j;
+        while (k > 0 && key[perm[k-1]] > key[j]) {
+            perm[k] = perm[k-1];
+            k--;
+            moved = 1;
+        }
+        perm[k] = j;
+    }
+    Operand* old = (Operand*)malloc(sizeof(Operand) * n);
+    for (int i = header->start; i < header->end && moved; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind != PHI_IR)
+            continue;
+        for (int j = 0; j < n; j++)
+            old[j] = code->args[j];
+        for (int j = 0; j < n; j++)
+            code->args[j] = old[perm[j]];
+    }
+    free(old);
+    free(perm);
+}
+
+static void emitHoisted(LoopInfo* li, int* hoisted) {
+    for (int k = 0; k < li->num; k++)
+        emitInterCode(&interCodes[hoisted[li->first + k]]);
+}
+
+static void emitJump(int kind, Operand label) {
+    InterCode_ code;
+    memset(&code, 0, sizeof(InterCode_));
+    code.kind = kind;
+    code.ops[0] = label;
+    emitInterCode(&code);
+}
+
+// 外提到循环的前置块时计数，之前几轮已经向同一个循环外提过的不再计
+static void countLoop(Block header) {
+    if (interCodes[header->start].kind != LABEL_IR)
+        return;
+    Operand label = interCodes[header->start].ops[0];
+    if (loopCountedCap < labelNo) {
+        int cap = loopCountedCap * 2 > labelNo ? loopCountedCap * 2 : labelNo;
+        loopCounted = (char*)realloc(loopCounted, cap);
+        memset(loopCounted + loopCountedCap, 0, cap - loopCountedCap);
+        loopCountedCap = cap;
+    }
+    if (!loopCounted[label->no]) {
+        loopCounted[label->no] = 1;
+        loopTotal++;
+    }
+}
+
+/*
+* 确定每个有外提指令的循环的前置块：唯一前驱只有循环头一个后继时直接放在它的末尾，
+* 否则新建一个块，由顺序执行进入循环头的放在循环头之前，由跳转进入的改为跳到新块
+*/
+static void placePreheaders(int* beforeOf) {
+    for (int l = 0; l < cfg->loopNum; l++) {
+        LoopInfo* li = &info[l];
+        if (li->num == 0)
+            continue;
+        Block header = cfg->loops[l].header;
+        countLoop(header);
+        Block entry = li->entry;
+        if (entry->succNum == 1) {
+            li->place = PRE_TAIL;
+            continue;
+        }
+        li->label = newLabel();
+        preheaderTotal++;
+        if (entry->succs[1] == header)
+            li->place = PRE_BEFORE;
+        else {
+            // 循环头之前的块如果会顺序执行下来，新块只能放到函数末尾
+            InterCode last = &interCodes[cfg->blocks[header->no - 1].end - 1];
+            li->place = last->kind == GOTO_IR || last->kind == RETURN_IR ? PRE_BEFORE : PRE_APPEND;
+            reorderPhis(header, entry, li->place == PRE_BEFORE ? 2 * header->no - 1 : 2 * (cfg->blockNum + l));
+        }
+        if (li->place == PRE_BEFORE)
+            beforeOf[header->no] = l;
+    }
+}
+
+static void rewriteLoops(int* hoistTo, int* order, int num, int* entryOf) {
+    // 按循环分组，组内保持外提的顺序
+    int* hoisted = (int*)malloc(sizeof(int) * num);
+    int first = 0;
+    for (int l = 0; l < cfg->loopNum; l++) {
+        info[l].first = first;
+        first += info[l].num;
+        info[l].num = 0;
+    }
+    for (int k = 0; k < num; k++) {
+        LoopInfo* li = &info[hoistTo[order[k]]];
+        hoisted[li->first + li->num++] = order[k];
+    }
+    int* beforeOf = (int*)malloc(sizeof(int) * cfg->blockNum);
+    for (int b = 0; b < cfg->blockNum; b++)
+        beforeOf[b] = -1;
+    placePreheaders(beforeOf);
+    beginRewrite(interCodeNum + 3 * cfg->loopNum);
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        if (beforeOf[b] >= 0) {
+            LoopInfo* li = &info[beforeOf[b]];
+            emitJump(LABEL_IR, li->label);
+            emitHoisted(li, hoisted);
+        }
+        LoopInfo* li = entryOf[b] >= 0 && info[entryOf[b]].num > 0 ? &info[entryOf[b]] : NULL;
+        int pending = li != NULL && li->place == PRE_TAIL;
+        for (int i = block->start; i < block->end; i++) {
+            if (hoistTo[i] >= 0)
+                continue;
+            InterCode code = &interCodes[i];
+            // 放在前驱末尾的指令要在跳转之前
+            if (pending && (code->kind == GOTO_IR || code->kind == IF_GOTO_IR)) {
+                emitHoisted(li, hoisted);
+                pending = 0;
+            }
+            InterCode copy = emitInterCode(code);
+            if (li != NULL && li->place != PRE_TAIL && code->kind == IF_GOTO_IR &&
+                block->succs[0] == cfg->loops[entryOf[b]].header)
+                copy->ops[2] = li->label;
+        }
+        if (pending)
+            emitHoisted(li, hoisted);
+    }
+    for (int l = 0; l < cfg->loopNum; l++) {
+        LoopInfo* li = &info[l];
+        if (li->num == 0 || li->place != PRE_APPEND)
+            continue;
+        emitJump(LABEL_IR, li->label);
+        emitHoisted(li, hoisted);
+        emitJump(GOTO_IR, interCodes[cfg->loops[l].header->start].ops[0]);
+    }
+    finishRewrite();
+    free(beforeOf);
+    free(hoisted);
+}
+
+/*
+* 循环不变代码外提：WHILE循环中操作数都在循环外确定的运算（数组基址、下标乘元素大小、条件中的界）
+* 每次迭代的结果都相同，把它们移到循环的前置块中只算一次，嵌套循环中逐层向外移到不再不变为止
+* 读内存的指令只有在循环中没有写解引用、调用和内存变量赋值时才外提，
+* 可能出错的解引用和除法还要求所在块在每次进入循环时都会执行，返回外提的指令数
+*/
+int hoistInvariants() {
+    valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0 || interCodeNum == 0 || !hasBackJump(0, interCodeNum))
+        return 0;
+    cfg = buildCFG(0, interCodeNum);
+    if (cfg->loopNum == 0) {
+        freeCFG(cfg);
+        return 0;
+    }
+    info = (LoopInfo*)calloc(cfg->loopNum, sizeof(LoopInfo));
+    valueLoop = (Loop*)calloc(valueCount, sizeof(Loop));
+    int* entryOf = (int*)malloc(sizeof(int) * cfg->blockNum);
+    for (int b = 0; b < cfg->blockNum; b++)
+        entryOf[b] = -1;
+    collectLoops(entryOf);
+    int* hoistTo = (int*)malloc(sizeof(int) * interCodeNum * 2);
+    int* order = hoistTo + interCodeNum;
+    for (int i = 0; i < interCodeNum; i++)
+        hoistTo[i] = -1;
+    int num = findInvariants(hoistTo, order);
+    if (num > 0)
+        rewriteLoops(hoistTo, order, num, entryOf);
+    hoistTotal += num;
+    for (int l = 0; l < cfg->loopNum; l++)
+        free(info[l].exits);
+    free(hoistTo);
+    free(entryOf);
+    free(valueLoop);
+    free(info);
+    freeCFG(cfg);
+    valueLoop = NULL;
+    info = NULL;
+    cfg = NULL;
+    return num;
+}
+
+// 打印循环不变代码外提的统计信息
+void printLICMStats(FILE* fp) {
+    fprintf(fp, "licm: %d invariant codes hoisted out of %d loops, %d preheaders created\n",
+        hoistTotal, loopTotal, preheaderTotal);
+}
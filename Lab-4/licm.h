@@ -0,0 +1,9 @@
+#ifndef LICM_H
+#define LICM_H
+
+#include "ssa.h"
+
+int hoistInvariants();
+void printLICMStats(FILE* fp);
+
+#endif
@@ -0,0 +1,318 @@
+#include "lvn.h"
+
+extern int tmpVarNo;
+
+// 局部值编号的统计信息
+static int redundantTotal = 0;
+static int loadTotal = 0;
+static int simplifyTotal = 0;
+
+// 表达式的键：运算种类和两个规范化的操作数，读内存的表达式还要带上内存版本
+typedef struct ExprKey_d {
+    int kind;
+    int tag[2];
+    size_t x[2];
+    int epoch;
+} ExprKey;
+
+// 操作数的种类，读取内存的操作数在两次写内存之间才相同
+enum { KEY_NONE, KEY_CONST, KEY_VALUE, KEY_ADDR, KEY_LOAD, KEY_MEMORY, KEY_MEMORY_LOAD };
+
+// 散列表项：按基本块打戳，换块时不需要清空
+typedef struct ExprEntry_d {
+    int stamp;
+    ExprKey key;
+    Operand value;
+} ExprEntry;
+
+static ExprEntry* table = NULL;
+static int tableSize = 0;
+static int stamp = 0;
+static int epoch = 0;
+static int valueCount = 0;
+// 值在本轮中已知等于的另一个值，用来规范化后续表达式的操作数
+static Operand* same = NULL;
+
+// SSA值的代表：被判定为冗余的值用先前的值代替
+static Operand canon(Operand op) {
+    int v = valueNo(op);
+    if (v >= 0 && v < valueCount && same[v] != NULL)
+        return same[v];
+    return op;
+}
+
+// 把操作数编码为键的一部分，读内存时返回1
+static int encodeOp(Operand op, int* tag, size_t* x) {
+    if (op == NULL) {
+        *tag = KEY_NONE;
+        *x = 0;
+        return 0;
+    }
+    op = canon(op);
+    switch (op->kind) {
+        case CONSTANT_OP:
+            *tag = KEY_CONST;
+            *x = (size_t)(unsigned int)op->value;
+            return 0;
+        case GET_ADDR_OP:
+            // 函数中数组和结构体的地址在整个函数内不变
+            *tag = KEY_ADDR;
+            *x = (size_t)op->opr->name;
+            return 0;
+        case GET_VAL_OP: {
+            Operand addr = canon(op->opr);
+            if (valueNo(addr) >= 0) {
+                *tag = KEY_LOAD;
+                *x = (size_t)valueNo(addr);
+            }
+            else {
+                *tag = KEY_MEMORY_LOAD;
+                *x = addr->kind == TEMP_VAR_OP ? (size_t)addr->no : (size_t)addr->name;
+            }
+            return 1;
+        }
+        default:
+            if (valueNo(op) >= 0) {
+                *tag = KEY_VALUE;
+                *x = (size_t)valueNo(op);
+                return 0;
+            }
+            *tag = KEY_MEMORY;
+            *x = op->kind == TEMP_VAR_OP ? (size_t)op->no : (size_t)op->name;
+            return 1;
+    }
+}
+
+static unsigned int keyHash(ExprKey* key) {
+    size_t h = (size_t)key->kind * 31 + (size_t)key->epoch;
+    for (int k = 0; k < 2; k++)
+        h = (h ^ ((size_t)key->tag[k] << 3) ^ key->x[k]) * 2654435761u;
+    return (unsigned int)(h ^ (h >> 16));
+}
+
+static int keyEqual(ExprKey* a, ExprKey* b) {
+    return a->kind == b->kind && a->epoch == b->epoch &&
+        a->tag[0] == b->tag[0] && a->x[0] == b->x[0] &&
+        a->tag[1] == b->tag[1] && a->x[1] == b->x[1];
+}
+
+// 查找表达式，不存在时value非空则插入
+static Operand lookupExpr(ExprKey* key, Operand value) {
+    unsigned int mask = (unsigned int)tableSize - 1;
+    unsigned int h = keyHash(key) & mask;
+    while (table[h].stamp == stamp) {
+        if (keyEqual(&table[h].key, key))
+            return table[h].value;
+        h = (h + 1) & mask;
+    }
+    if (value != NULL) {
+        table[h].stamp = stamp;
+        table[h].key = *key;
+        table[h].value = value;
+    }
+    return NULL;
+}
+
+// 运算表达式的键，可交换的运算把操作数排成固定顺序
+static void makeKey(int kind, Operand a, Operand b, ExprKey* key) {
+    key->kind = kind;
+    int memory = encodeOp(a, &key->tag[0], &key->x[0]);
+    memory |= encodeOp(b, &key->tag[1], &key->x[1]);
+    if ((kind == PLUS_IR || kind == MUL_IR) &&
+        (key->tag[0] > key->tag[1] || (key->tag[0] == key->tag[1] && key->x[0] > key->x[1]))) {
+        int tag = key->tag[0];
+        size_t x = key->x[0];
+        key->tag[0] = key->tag[1];
+        key->x[0] = key->x[1];
+        key->tag[1] = tag;
+        key->x[1] = x;
+    }
+    key->epoch = memory ? epoch : 0;
+}
+
+// 从地址addr读内存的键，地址是SSA值
+static void makeLoadKey(Operand addr, ExprKey* key) {
+    key->kind = ASSIGN_IR;
+    key->tag[0] = KEY_LOAD;
+    key->x[0] = (size_t)valueNo(canon(addr));
+    key->tag[1] = KEY_NONE;
+    key->x[1] = 0;
+    key->epoch = epoch;
+}
+
+// 使用处的解引用如果读的是本块中已知的内存内容，直接换成该值
+static Operand reuseLoad(Operand op) {
+    if (op == NULL || op->kind != GET_VAL_OP || valueNo(op->opr) < 0)
+        return op;
+    ExprKey key;
+    makeLoadKey(op->opr, &key);
+    Operand value = lookupExpr(&key, NULL);
+    if (value == NULL)
+        return op;
+    loadTotal++;
+    return value;
+}
+
+static int isConst(Operand op, int value) {
+    return op->kind == CONSTANT_OP && op->value == value;
+}
+
+// 代数化简：结果等于某个操作数或常量0时返回它，否则返回NULL
+static Operand simplify(InterCode code, Operand a, Operand b) {
+    int plain = valueNo(a) >= 0 || a->kind == CONSTANT_OP;
+    switch (code->kind) {
+        case PLUS_IR:
+            if (isConst(b, 0) && plain)
+                return a;
+            if (isConst(a, 0) && (valueNo(b) >= 0 || b->kind == CONSTANT_OP))
+                return b;
+            return NULL;
+        case SUB_IR:
+            if (isConst(b, 0) && plain)
+                return a;
+            if (valueNo(a) >= 0 && valueNo(a) == valueNo(b))
+                return getValue(0);
+            return NULL;
+        case MUL_IR:
+            if (isConst(a, 0) || isConst(b, 0))
+                return getValue(0);
+            if (isConst(b, 1) && plain)
+                return a;
+            if (isConst(a, 1) && (valueNo(b) >= 0 || b->kind == CONSTANT_OP))
+                return b;
+            return NULL;
+        case DIV_IR:
+            if (isConst(b, 1) && plain)
+                return a;
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
+// 把冗余的运算改成拷贝，交给拷贝传播删除
+static void turnIntoCopy(InterCode code, Operand value) {
+    code->kind = ASSIGN_IR;
+    code->ops[1] = value;
+    code->ops[2] = NULL;
+    int v = valueNo(code->ops[0]);
+    if (valueNo(value) >= 0)
+        same[v] = value;
+}
+
+static void numberCodes() {
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        // 标记和跳转之后的指令开始新的基本块，清空散列表
+        if (i == 0 || code->kind == LABEL_IR || interCodes[i-1].kind == GOTO_IR ||
+            interCodes[i-1].kind == IF_GOTO_IR || interCodes[i-1].kind == RETURN_IR) {
+            stamp++;
+            epoch++;
+        }
+        if (code->kind == PHI_IR || code->kind == LABEL_IR)
+            continue;
+        // 先规范化读取的操作数：冗余的值换成先前的值，已知内容的解引用换成该内容
+        for (int k = code->kind == ASSIGN_IR ? 1 : definesOp(code); k < 3; k++) {
+            Operand op = code->ops[k];
+            if (op == NULL)
+                continue;
+            if (op->kind == GET_VAL_OP && canon(op->opr) != op->opr) {
+                Operand val = allocOperand();
+                val->kind = GET_VAL_OP;
+                val->opr = canon(op->opr);
+                op = val;
+            }
+            else
+                op = canon(op);
+            code->ops[k] = reuseLoad(op);
+        }
+        // 写解引用的目标地址同样规范化
+        if (code->kind == ASSIGN_IR && code->ops[0] != NULL && code->ops[0]->kind == GET_VAL_OP &&
+            canon(code->ops[0]->opr) != code->ops[0]->opr) {
+            Operand val = allocOperand();
+            val->kind = GET_VAL_OP;
+            val->opr = canon(code->ops[0]->opr);
+            code->ops[0] = val;
+        }
+        // 调用和写内存先使内存版本号增加，带返回值的调用也不例外
+        int writes = writesMemory(code);
+        if (writes)
+            epoch++;
+        int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+        if (v >= 0 && v < valueCount) {
+            if (code->kind == PLUS_IR || code->kind == SUB_IR || code->kind == MUL_IR || code->kind == DIV_IR) {
+                Operand result = simplify(code, code->ops[1], code->ops[2]);
+                if (result != NULL) {
+                    turnIntoCopy(code, result);
+                    simplifyTotal++;
+                    continue;
+                }
+                ExprKey key;
+                makeKey(code->kind, code->ops[1], code->ops[2], &key);
+                Operand prev = lookupExpr(&key, code->ops[0]);
+                if (prev != NULL) {
+                    turnIntoCopy(code, prev);
+                    redundantTotal++;
+                }
+                continue;
+            }
+            if (code->kind != ASSIGN_IR)
+                continue;
+            // 值之间的拷贝：后面的表达式直接使用源值
+            if (valueNo(code->ops[1]) >= 0)
+                same[v] = code->ops[1];
+            // 读内存的结果记下来，后面同一地址的读可以复用
+            else if (code->ops[1]->kind == GET_VAL_OP && valueNo(code->ops[1]->opr) >= 0) {
+                ExprKey key;
+                makeLoadKey(code->ops[1]->opr, &key);
+                lookupExpr(&key, code->ops[0]);
+            }
+            continue;
+        }
+        if (!writes)
+            continue;
+        // 写入的值可以转发给之后从同一地址的读
+        Operand addr = NULL;
+        if (code->kind == TO_MEM_IR)
+            addr = code->ops[0];
+        else if (code->kind == ASSIGN_IR && code->ops[0]->kind == GET_VAL_OP)
+            addr = code->ops[0]->opr;
+        Operand stored = code->ops[1];
+        if (addr != NULL && valueNo(addr) >= 0 && (valueNo(stored) >= 0 || stored->kind == CONSTANT_OP)) {
+            ExprKey key;
+            makeLoadKey(addr, &key);
+            lookupExpr(&key, stored);
+        }
+    }
+}
+
+/*
+* 基本块内的值编号：相同运算和相同操作数的表达式只计算一次，后面的改成拷贝交给拷贝传播删除
+* 数组和结构体的地址运算（下标乘元素大小、基址加偏移）因此在同一块中只算一遍
+* 读内存的表达式带有内存版本号，写解引用、调用和对内存变量的赋值都会使版本号增加，
+* 同一地址在两次写之间的读复用第一次的结果，刚写入的值直接转发给之后的读，返回改动的次数
+*/
+int numberValues() {
+    valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0)
+        return 0;
+    int before = redundantTotal + loadTotal + simplifyTotal;
+    if (tableSize < 2 * interCodeNum) {
+        while (tableSize < 2 * interCodeNum)
+            tableSize = tableSize > 0 ? tableSize * 2 : 256;
+        free(table);
+        table = (ExprEntry*)calloc(tableSize, sizeof(ExprEntry));
+        stamp = 0;
+    }
+    same = (Operand*)calloc(valueCount, sizeof(Operand));
+    numberCodes();
+    free(same);
+    same = NULL;
+    return redundantTotal + loadTotal + simplifyTotal - before;
+}
+
+// 打印局部值编号的统计信息
+void printLVNStats(FILE* fp) {
+    fprintf(fp, "lvn: %d redundant computations, %d loads reused, %d algebraic simplifications\n",
+        redundantTotal, loadTotal, simplifyTotal);
+}
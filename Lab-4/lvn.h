@@ -0,0 +1,9 @@
+#ifndef LVN_H
+#define LVN_H
+
+#include "ssa.h"
+
+int numberValues();
+void printLVNStats(FILE* fp);
+
+#endif
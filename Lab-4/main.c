@@ -1,8 +1,13 @@
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
 #include "Tree.h"
 #include "semantic.h"
 #include "intercode.h"
 #include "objectcode.h"
+#include "regalloc.h"
+#include "peephole.h"
+#include "optimize.h"
 
 extern int yyrestart(FILE* f);
 extern int yyparse();
@@ -12,28 +17,77 @@ extern int lexError;
 extern int synError;
 extern int semError;
 
+// 打印某个阶段的耗时，并把计时起点移到当前时刻
+void reportPhase(char* phase, clock_t* start) {
+    clock_t now = clock();
+    fprintf(stderr, "time: %-10s %.3fs\n", phase, (double)(now - *start) / CLOCKS_PER_SEC);
+    *start = now;
+}
+
 int main(int argc, char** argv) {
-    if (argc <= 1)
+    // 选项可以出现在任意位置，其余参数依次为输入文件、目标代码文件、中间代码文件
+    // -v：在标准错误输出打印各阶段的统计信息
+    // -O0：跳过中间代码优化，直接由翻译结果生成目标代码
+    int verbose = 0;
+    int optimize = 1;
+    char* files[3] = { NULL, NULL, NULL };
+    int fileNum = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0)
+            verbose = 1;
+        else if (strcmp(argv[i], "-O0") == 0)
+            optimize = 0;
+        else if (fileNum < 3)
+            files[fileNum++] = argv[i];
+    }
+    if (fileNum == 0)
         return 1;
-    FILE* f = fopen(argv[1], "r");
+    FILE* f = fopen(files[0], "r");
     if (!f) {
-        perror(argv[1]);
+        perror(files[0]);
         return 1;
     }
+    clock_t start = clock();
     yyrestart(f);
     yyparse();
+    if (verbose)
+        reportPhase("parse", &start);
     if (root != NULL && lexError == 0 && synError == 0) {
         // printTree(root, 0);
         semanticAnalyse(root);
+        if (verbose) {
+            reportPhase("semantic", &start);
+            printSymbolTableStats(stderr);
+        }
         if (semError == 0) {
             translateProgram(root);
-            if (argc == 4) {
-                printInterCodes(argv[3]);
-                printObjectCodes(argv[2]);
+            if (verbose) {
+                reportPhase("intercode", &start);
+                printInterCodeStats(stderr);
+            }
+            if (optimize) {
+                optimizeProgram();
+                if (verbose) {
+                    reportPhase("optimize", &start);
+                    printOptimizeStats(stderr);
+                }
+            }
+            if (fileNum == 3)
+                printInterCodes(files[2]);
+            if (fileNum >= 2)
+                printObjectCodes(files[1]);
+            if (verbose) {
+                reportPhase("objectcode", &start);
+                printSimplifyStats(stderr);
+                printCFGStats(stderr);
+                printRegAllocStats(stderr);
+                printObjectCodeStats(stderr);
+                printPeepholeStats(stderr);
+                printOutputStats(stderr);
             }
-            else if (argc == 3)
-                printObjectCodes(argv[2]);
         }
     }
+    // 语法树只在本次编译中使用，统一释放
+    freeTree();
     return 0;
 }
\ No newline at end of file
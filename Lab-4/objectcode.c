@@ -1,18 +1,23 @@
 #include "objectcode.h"
-
-extern InterCode interCodes; // 外部声明中间代码的全局变量
+#include "regalloc.h"
+#include "peephole.h"
 
 RegDes regs[32];        // 寄存器描述符数组
 FrameDes frames;        // 栈帧描述符链表
-char currFuncName[32];  // 当前翻译到的函数的名字
+FrameDes currFrame;     // 当前翻译到的函数的栈帧描述符
+MipsCode mipsCodes = NULL;  // 当前函数的目标代码
+int mipsCodeNum = 0;
+static int mipsCodeCap = 0;
+
+static int tailCallTotal = 0;   // 复用调用者栈帧的尾调用数
+static int mulLowered = 0;      // 改为移位和加减的乘常量
+static int divLowered = 0;      // 改为移位或乘魔数的除常量
 
 // 初始化寄存器描述符数组
 void initRegs() {
     // 循环初始化32个寄存器描述符
     for (int i = 0; i < 32; i++) {
         regs[i] = (RegDes)malloc(sizeof(RegDes_));
-        regs[i]->free = 1;      // 初始时寄存器都可用
-        regs[i]->interval = 0;  // 初始时距离上次访问间隔为0
         // 填写寄存器别名
         // 不使用，值永远为0
         if (i == 0)
@@ -53,33 +58,156 @@ void initRegs() {
     }
 }
 
-// 将所有可操作寄存器的free标记置1，表示不需要阻止抢占
-void freeRegs() {
-    for (int i = 8; i < 26; i++)
-        regs[i]->free = 1;
+// 在当前函数的目标代码末尾追加一条指令，标记和跳转目标由调用者另行填写
+MipsCode emitMips(int kind, int rd, int rs, int rt, int imm) {
+    if (mipsCodeNum == mipsCodeCap) {
+        mipsCodeCap = mipsCodeCap == 0 ? 256 : mipsCodeCap * 2;
+        mipsCodes = (MipsCode)realloc(mipsCodes, sizeof(MipsCode_) * mipsCodeCap);
+    }
+    MipsCode code = &mipsCodes[mipsCodeNum++];
+    code->kind = kind;
+    code->rd = rd;
+    code->rs = rs;
+    code->rt = rt;
+    code->imm = imm;
+    code->label = -1;
+    code->name = NULL;
+    return code;
 }
 
-// 将所有可操作寄存器清空
-void clearRegs() {
-    for (int i = 8; i < 26; i++) {
-        regs[i]->free = 1;           // 将free标记置1，表示寄存器可用
-        regs[i]->var = NULL;         // 将存储在寄存器中的变量描述符指针置空
-        regs[i]->interval = 0;       // 将访问间隔清零
+// 打印一条目标代码，被窥孔优化删除的指令不输出
+void printMipsCode(MipsCode code, OutBuffer out) {
+    static char* branches[] = { "beq", "bne", "bgt", "blt", "bge", "ble",
+        "beqz", "bnez", "bgtz", "bltz", "bgez", "blez" };
+    switch (code->kind) {
+        case LABEL_MIPS:
+            outPrintf(out, "label%d:\n", code->label);
+            break;
+        case FUNC_MIPS:
+            outPrintf(out, "\n%s:\n", code->name);
+            break;
+        case LI_MIPS:
+            outPrintf(out, "  li %s, %d\n", regs[code->rd]->name, code->imm);
+            break;
+        case MOVE_MIPS:
+            outPrintf(out, "  move %s, %s\n", regs[code->rd]->name, regs[code->rs]->name);
+            break;
+        case ADD_MIPS:
+            outPrintf(out, "  add %s, %s, %s\n", regs[code->rd]->name, regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case ADDU_MIPS:
+            outPrintf(out, "  addu %s, %s, %s\n", regs[code->rd]->name, regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case ADDI_MIPS:
+            outPrintf(out, "  addi %s, %s, %d\n", regs[code->rd]->name, regs[code->rs]->name, code->imm);
+            break;
+        case SLTI_MIPS:
+            outPrintf(out, "  slti %s, %s, %d\n", regs[code->rd]->name, regs[code->rs]->name, code->imm);
+            break;
+        case SUB_MIPS:
+            outPrintf(out, "  sub %s, %s, %s\n", regs[code->rd]->name, regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case SUBU_MIPS:
+            outPrintf(out, "  subu %s, %s, %s\n", regs[code->rd]->name, regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case MUL_MIPS:
+            outPrintf(out, "  mul %s, %s, %s\n", regs[code->rd]->name, regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case MULT_MIPS:
+            outPrintf(out, "  mult %s, %s\n", regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case DIV_MIPS:
+            outPrintf(out, "  div %s, %s\n", regs[code->rs]->name, regs[code->rt]->name);
+            break;
+        case MFLO_MIPS:
+            outPrintf(out, "  mflo %s\n", regs[code->rd]->name);
+            break;
+        case MFHI_MIPS:
+            outPrintf(out, "  mfhi %s\n", regs[code->rd]->name);
+            break;
+        case SLL_MIPS:
+            outPrintf(out, "  sll %s, %s, %d\n", regs[code->rd]->name, regs[code->rs]->name, code->imm);
+            break;
+        case SRA_MIPS:
+            outPrintf(out, "  sra %s, %s, %d\n", regs[code->rd]->name, regs[code->rs]->name, code->imm);
+            break;
+        case SRL_MIPS:
+            outPrintf(out, "  srl %s, %s, %d\n", regs[code->rd]->name, regs[code->rs]->name, code->imm);
+            break;
+        case LW_MIPS:
+            outPrintf(out, "  lw %s, %d(%s)\n", regs[code->rd]->name, code->imm, regs[code->rs]->name);
+            break;
+        case SW_MIPS:
+            outPrintf(out, "  sw %s, %d(%s)\n", regs[code->rt]->name, code->imm, regs[code->rs]->name);
+            break;
+        case J_MIPS:
+            if (code->name != NULL)
+                outPrintf(out, "  j %s\n", code->name);
+            else
+                outPrintf(out, "  j label%d\n", code->label);
+            break;
+        case JAL_MIPS:
+            outPrintf(out, "  jal %s\n", code->name);
+            break;
+        case JR_MIPS:
+            outPrintf(out, "  jr %s\n", regs[code->rs]->name);
+            break;
+        case BEQ_MIPS:
+        case BNE_MIPS:
+        case BGT_MIPS:
+        case BLT_MIPS:
+        case BGE_MIPS:
+        case BLE_MIPS:
+            outPrintf(out, "  %s %s, %s, label%d\n", branches[code->kind - BEQ_MIPS],
+                regs[code->rs]->name, regs[code->rt]->name, code->label);
+            break;
+        case BEQZ_MIPS:
+        case BNEZ_MIPS:
+        case BGTZ_MIPS:
+        case BLTZ_MIPS:
+        case BGEZ_MIPS:
+        case BLEZ_MIPS:
+            outPrintf(out, "  %s %s, label%d\n", branches[code->kind - BEQ_MIPS], regs[code->rs]->name, code->label);
+            break;
+        default:
+            break;
     }
 }
 
-// 将所有可操作寄存器压栈
-void pushAllRegs(FILE* fp) {
-    fprintf(fp, "  addi $sp, $sp, -72\n");
-    for (int i = 25; i >= 8; i--)
-        fprintf(fp, "  sw %s, %d($sp)\n", regs[i]->name, 4*(i-8));
+// 栈帧中位于函数入口时$sp之下offset字节处的位置，非叶函数以$fp为基址，叶函数以$sp为基址
+int slotOffset(int offset) {
+    if (currFrame->leaf)
+        return currFrame->size - offset;
+    return -offset;
 }
 
-// 恢复可操作寄存器中的值
-void popAllRegs(FILE* fp) {
-    for (int i = 8; i < 26; i++)
-        fprintf(fp, "  lw %s, %d($sp)\n", regs[i]->name, 4*(i-8));
-    fprintf(fp, "  addi $sp, $sp, 72\n");
+// 栈帧的基址寄存器：叶函数为$sp，其余为$fp
+int slotBase() {
+    return currFrame->leaf ? 29 : 30;
+}
+
+// 保存或恢复mask中的寄存器，kind为SW_MIPS或LW_MIPS
+void saveRegs(unsigned int mask, int kind) {
+    for (int i = 8; i < 24; i++) {
+        if (!(mask & (1u << i)))
+            continue;
+        if (kind == SW_MIPS)
+            emitMips(SW_MIPS, 0, slotBase(), i, slotOffset(currFrame->regOffset[i]));
+        else
+            emitMips(LW_MIPS, i, slotBase(), 0, slotOffset(currFrame->regOffset[i]));
+    }
+}
+
+// 恢复被调用者保存寄存器、$ra和$fp，并释放栈帧
+void restoreFrame(FrameDes frame) {
+    saveRegs(frame->calleeSaved, LW_MIPS);
+    if (!frame->leaf) {
+        emitMips(LW_MIPS, 31, 30, 0, -4);
+        emitMips(MOVE_MIPS, 29, 30, 0, 0);
+        emitMips(LW_MIPS, 30, 29, 0, -8);
+    }
+    else if (frame->size > 0)
+        emitMips(ADDI_MIPS, 29, 29, 0, frame->size);
 }
 
 // 比较两个操作数是否等价
@@ -92,7 +220,7 @@ int opEqual(Operand op1, Operand op2) {
         switch (op1->kind) {
             case VARIABLE_OP:
             case FUNCTION_OP:
-                return strcmp(op1->name, op2->name) == 0;
+                return op1->name == op2->name;
             case TEMP_VAR_OP:
             case LABEL_OP:
                 return op1->no == op2->no;
@@ -106,548 +234,576 @@ int opEqual(Operand op1, Operand op2) {
     return 0;
 }
 
+// 操作数在变量哈希表中的桶号：临时变量按编号，具名变量的名字是驻留字符串，按地址散列
+unsigned int varHash(Operand op, int tableSize) {
+    unsigned int h;
+    if (op->kind == TEMP_VAR_OP)
+        h = (unsigned int)op->no;
+    else
+        h = (unsigned int)((size_t)op->name >> 3) ^ 0x9e3779b9u;
+    h *= 2654435761u;
+    return (h ^ (h >> 16)) & (unsigned int)(tableSize - 1);
+}
+
+// 变量数超过桶数时把哈希表扩大一倍
+void resizeVarTable(FrameDes frame) {
+    int size = frame->tableSize * 2;
+    VarDes* table = (VarDes*)calloc(size, sizeof(VarDes));
+    for (VarDes var = frame->vars; var != NULL; var = var->next) {
+        unsigned int h = varHash(var->op, size);
+        var->hashNext = table[h];
+        table[h] = var;
+    }
+    free(frame->varTable);
+    frame->varTable = table;
+    frame->tableSize = size;
+}
+
 // 为操作数在栈帧描述符中生成变量描述符
 VarDes createVarDes(Operand op, FrameDes frame) {
-    // 首先查找是否已存在对应的变量描述符
-    VarDes var = frame->vars;
-    while (var != NULL) {
+    // 首先在哈希表中查找是否已存在对应的变量描述符
+    unsigned int h = varHash(op, frame->tableSize);
+    for (VarDes var = frame->varTable[h]; var != NULL; var = var->hashNext)
         if (opEqual(op, var->op))
             return var;
-        var = var->next;
-    }
-    // 创建新的变量描述符
-    var = (VarDes)malloc(sizeof(VarDes_));
-    // var->regNo = -1;
-    int extraOffset = 0;
-    // main函数以外的其他函数要现在栈帧中保存全部可操作寄存器的旧值，所以会多出72个字节
-    if (strcmp(frame->name, "main") != 0)
-        extraOffset = 72;
-    if (frame->vars == NULL)
-        var->offset = getSize(op->type) + extraOffset;
-    else
-        var->offset = frame->vars->offset + getSize(op->type);
+    // 创建新的变量描述符，寄存器和栈上的位置在寄存器分配之后才确定
+    VarDes var = (VarDes)malloc(sizeof(VarDes_));
+    var->no = frame->varNum++;
+    var->regNo = -1;
+    var->memory = 0;
+    var->offset = 0;
     var->op = op;
     var->next = frame->vars;
     frame->vars = var;
+    var->hashNext = frame->varTable[h];
+    frame->varTable[h] = var;
+    if (frame->varNum > frame->tableSize)
+        resizeVarTable(frame);
     return var;
 }
 
-// 从头到尾扫描一遍中间代码，然后初始化栈帧描述符表
-void initFrames() {
-    InterCode curr = interCodes;
-    int flag = 1;
-    while (flag == 1 || curr != interCodes) {
-        flag = 0;
-        switch (curr->kind) {
-            case FUNC_IR: {
-                // 创建一个对应该函数的新栈帧描述符并插入到链表首部
-                FrameDes frame = (FrameDes)malloc(sizeof(FrameDes_));
-                strcpy(frame->name, curr->ops[0]->name);
-                frame->next = frames;
-                frames = frame;
-                break;
-            }
-            case ASSIGN_IR:
-            case TO_MEM_IR:
-            case IF_GOTO_IR: {
-                Operand left = curr->ops[0];
-                Operand right = curr->ops[1];
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP)
-                    createVarDes(left, frames);
-                if (right->kind == VARIABLE_OP || right->kind == TEMP_VAR_OP)
-                    createVarDes(right, frames);
-                break;
-            }
-            case PLUS_IR:
-            case SUB_IR:
-            case MUL_IR:
-            case DIV_IR: {
-                Operand left = curr->ops[0];
-                Operand right1 = curr->ops[1];
-                Operand right2 = curr->ops[2];
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP)
-                    createVarDes(left, frames);
-                if (right1->kind == VARIABLE_OP || right1->kind == TEMP_VAR_OP)
-                    createVarDes(right1, frames);
-                if (right2->kind == VARIABLE_OP || right2->kind == TEMP_VAR_OP)
-                    createVarDes(right2, frames);
-                break;
-            }
-            case RETURN_IR:
-            case DEC_IR:
-            case ARG_IR:
-            case CALL_IR:
-            case PARAM_IR:
-            case READ_IR:
-            case WRITE_IR: {
-                if (curr->ops[0]->kind == VARIABLE_OP || curr->ops[0]->kind == TEMP_VAR_OP)
-                    createVarDes(curr->ops[0], frames);
-                break;
-            }
-            default:
-                break;
+// 取得操作数所涉及的变量的描述符，取地址和解引用都落到被操作的变量上
+VarDes baseVarDes(Operand op, FrameDes frame) {
+    if (op == NULL)
+        return NULL;
+    if (op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP)
+        return createVarDes(op, frame);
+    if (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP) {
+        VarDes var = baseVarDes(op->opr, frame);
+        // 被取地址的变量必须放在栈上
+        if (var != NULL && op->kind == GET_ADDR_OP)
+            var->memory = 1;
+        return var;
+    }
+    return NULL;
+}
+
+// 扫描一个函数的中间代码，为其中出现的所有变量建立描述符，opVars记录每条指令各操作数对应的描述符
+FrameDes initFrame(CFG cfg, VarDes* opVars) {
+    FrameDes frame = (FrameDes)malloc(sizeof(FrameDes_));
+    frame->name = cfg->name;
+    frame->vars = NULL;
+    frame->varNum = 0;
+    frame->tableSize = VAR_TABLE_INIT_SIZE;
+    frame->varTable = (VarDes*)calloc(frame->tableSize, sizeof(VarDes));
+    frame->leaf = 1;
+    frame->calleeSaved = 0;
+    frame->callerSaved = 0;
+    frame->size = 0;
+    frame->next = frames;
+    frames = frame;
+    for (int i = cfg->start; i < cfg->end; i++) {
+        InterCode curr = &interCodes[i];
+        VarDes* ov = opVars + 3 * (i - cfg->start);
+        for (int k = 0; k < 3; k++)
+            ov[k] = baseVarDes(curr->ops[k], frame);
+        // 会覆盖$ra的调用（包括read和write）使函数不再是叶函数
+        if (curr->kind == CALL_IR || curr->kind == READ_IR || curr->kind == WRITE_IR)
+            frame->leaf = 0;
+        // DEC声明的数组和结构体放在栈上，用带类型的操作数计算大小
+        if (curr->kind == DEC_IR && ov[0] != NULL) {
+            ov[0]->memory = 1;
+            ov[0]->op = curr->ops[0];
         }
-        curr = curr->next;
     }
+    return frame;
 }
 
-FrameDes findCurrFrame() {
-    FrameDes frame = frames;
-    while (frame != NULL) {
-        if (strcmp(frame->name, currFuncName) == 0)
-            return frame;
-        frame = frame->next;
+/*
+* 安排栈帧布局，位置均以函数入口时的$sp为准向下计算：
+* 非叶函数先保存$ra和$fp，然后是被调用者保存的寄存器、调用点保存的寄存器，最后是没有分配到寄存器的变量
+*/
+void assignOffsets(FrameDes frame) {
+    int offset = frame->leaf ? 0 : 8;
+    for (int i = 8; i < 24; i++) {
+        if ((frame->calleeSaved | frame->callerSaved) & (1u << i)) {
+            offset += 4;
+            frame->regOffset[i] = offset;
+        }
     }
+    for (VarDes var = frame->vars; var != NULL; var = var->next) {
+        if (var->regNo >= 0)
+            continue;
+        offset += var->memory ? getSize(var->op->type) : 4;
+        var->offset = offset;
+    }
+    frame->size = offset;
 }
 
 // 将一些必需的目标代码输入到文件
-void initObjectCode(FILE* fp) {
+void initObjectCode(OutBuffer out) {
     // 数据段标记
-    fputs(".data\n", fp);
+    outStr(out, ".data\n");
     // 输入提示语
-    fputs("_prompt: .asciiz \"Enter an integer:\"\n", fp);
+    outStr(out, "_prompt: .asciiz \"Enter an integer:\"\n");
     // 换行符
-    fputs("_ret: .asciiz \"\\n\"\n", fp);
-    fputs(".globl main\n", fp);
+    outStr(out, "_ret: .asciiz \"\\n\"\n");
+    outStr(out, ".globl main\n");
     // 代码段标记
-    fputs(".text\n", fp);
+    outStr(out, ".text\n");
     // read函数目标代码
-    fputs("read:\n", fp);
+    outStr(out, "read:\n");
     // 打印输入提示语
-    fputs("  li $v0, 4\n", fp);
-    fputs("  la $a0, _prompt\n", fp);
-    fputs("  syscall\n", fp);
+    outStr(out, "  li $v0, 4\n");
+    outStr(out, "  la $a0, _prompt\n");
+    outStr(out, "  syscall\n");
     // 读入一个整型
-    fputs("  li $v0, 5\n", fp);
-    fputs("  syscall\n", fp);
+    outStr(out, "  li $v0, 5\n");
+    outStr(out, "  syscall\n");
     // 跳转返回地址
-    fputs("  jr $ra\n", fp);
-    fputs("\n", fp);
+    outStr(out, "  jr $ra\n");
+    outStr(out, "\n");
     // write函数目标代码
-    fputs("write:\n", fp);
-    fputs("  li $v0, 1\n", fp);
-    fputs("  syscall\n", fp);
-    fputs("  li $v0, 4\n", fp);
-    fputs("  la $a0, _ret\n", fp);
-    fputs("  syscall\n", fp);
-    fputs("  move $v0, $0\n", fp);
-    fputs("  jr $ra\n", fp);
+    outStr(out, "write:\n");
+    outStr(out, "  li $v0, 1\n");
+    outStr(out, "  syscall\n");
+    outStr(out, "  li $v0, 4\n");
+    outStr(out, "  la $a0, _ret\n");
+    outStr(out, "  syscall\n");
+    outStr(out, "  move $v0, $0\n");
+    outStr(out, "  jr $ra\n");
+}
+
+/*
+* 取得存放操作数值的寄存器，var是操作数所涉及的变量的描述符
+* 分配到寄存器的变量直接使用其寄存器，常量0使用$zero，其余情况把值装载到target中
+*/
+int loadOp(Operand op, VarDes var, int target) {
+    switch (op->kind) {
+        case CONSTANT_OP:
+            if (op->value == 0)
+                return 0;
+            emitMips(LI_MIPS, target, 0, 0, op->value);
+            return target;
+        case VARIABLE_OP:
+        case TEMP_VAR_OP:
+            if (var->regNo >= 0)
+                return var->regNo;
+            emitMips(LW_MIPS, target, slotBase(), 0, slotOffset(var->offset));
+            return target;
+        case GET_VAL_OP: {
+            int addr = loadOp(op->opr, var, target);
+            emitMips(LW_MIPS, target, addr, 0, 0);
+            return target;
+        }
+        case GET_ADDR_OP:
+            emitMips(ADDI_MIPS, target, slotBase(), 0, slotOffset(var->offset));
+            return target;
+        default:
+            return 0;
+    }
+}
+
+// 取得运算结果应当写入的寄存器：分配到寄存器的变量直接写入，其余先写入临时寄存器
+int destReg(Operand op, VarDes var) {
+    if ((op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP) && var->regNo >= 0)
+        return var->regNo;
+    return SCRATCH_REG1;
 }
 
-// 将可操作寄存器中的变量保存到栈上
-void spillReg(RegDes reg, FILE* fp) {
-    // 寄存器中的变量已经存储在栈上的某个位置（在预先扫描时已经被安排好了）
-    if (reg->var != NULL && (reg->var->op->kind == VARIABLE_OP || reg->var->op->kind == TEMP_VAR_OP))
-        fprintf(fp, "  sw %s, %d($fp)\n", reg->name, -reg->var->offset);
+// 把寄存器reg中的值写回被定值的操作数，解引用的地址使用第二个临时寄存器
+void storeOp(Operand op, VarDes var, int reg) {
+    if (op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP) {
+        if (var->regNo < 0)
+            emitMips(SW_MIPS, 0, slotBase(), reg, slotOffset(var->offset));
+        else if (var->regNo != reg)
+            emitMips(MOVE_MIPS, var->regNo, reg, 0, 0);
+    }
+    else if (op->kind == GET_VAL_OP) {
+        int addr = loadOp(op->opr, var, SCRATCH_REG2);
+        emitMips(SW_MIPS, 0, addr, reg, 0);
+    }
 }
 
-// 更新寄存器的使用间隔
-void updateInterval(RegDes reg) {
-    for (int i = 8; i < 26; i++)
-        regs[i]->interval++;
-    reg->interval = 0;
+// 2的幂的指数，不是2的幂时返回-1
+int log2Exact(unsigned long long u) {
+    if (u == 0 || (u & (u - 1)) != 0)
+        return -1;
+    int k = 0;
+    while (u > 1) {
+        u >>= 1;
+        k++;
+    }
+    return k;
 }
+
+// 把常量装入寄存器的代价：16位以内一条li，否则展开为lui和ori两条
+static int liCost(int c) {
+    return FITS_IMM(c) ? 1 : 2;
+}
+
+// 乘常量序列的一条指令：结果先放在SCRATCH_REG2中，最后一条写入left；total < 0时只计数不生成
+static void mulStep(int* count, int total, int left, int kind, int rs, int rt, int imm) {
+    if (total >= 0)
+        emitMips(kind, *count == total - 1 ? left : SCRATCH_REG2, rs, rt, imm);
+    (*count)++;
+}
+
 /*
-* 为变量描述符分配寄存器, load用于指示是否需要装载寄存器，
-* 形如 x = y op z 的表达式中，为x分配寄存器就不需要装载，而为y和z分配时都需要
+* 生成乘以常量c的移位和加减序列，返回指令数。|c|写成非相邻形式（NAF）：数位取0、1或-1，
+* 没有相邻的非0位，非0位的个数最少。从最高位起按Horner法则累加：累加值左移到下一个非0位再加减src，
+* 最后左移最低非0位的位数。c为负时各位取反，累加值先存相反数，遇到正的位时用src减去累加值翻回来，
+* 到最后仍是相反数时才取反。src在最后一条指令之前一直可读，left可以与它是同一个寄存器
 */
-int allocateReg(VarDes var, FILE* fp, int load) {
-    // 查找是否有空闲寄存器
-    int i = 8;
-    for (; i < 26; i++)
-        if (regs[i]->var == NULL)
-            break;
-    // 存在空闲寄存器
-    if (i >= 8 && i < 26) {
-        // TODO
-        // 更新寄存器信息
-        regs[i]->var = var;
-        updateInterval(regs[i]);
-        // var->regNo = i;
-        if (load == 1) {
-            // 根据需要装载寄存器的情况生成汇编代码
-            if (var->op->kind == CONSTANT_OP)
-                fprintf(fp, "  li %s, %d\n", regs[i]->name, var->op->value);
-            else if (var->op->kind == VARIABLE_OP || var->op->kind == TEMP_VAR_OP)
-                fprintf(fp, "  lw %s, %d($fp)\n", regs[i]->name, -var->offset);
-        }
-        return i;   // 返回分配的寄存器编号
-    }
-    // 不存在空闲寄存器
-    else if (i == 26) {
-        // 最长时间未使用算法
-        // 先尝试找到一个free并且存放常量的寄存器
-        for (i = 8; i < 26; i++)
-            if (regs[i]->free == 1 && regs[i]->var->op->kind == CONSTANT_OP)
-                break;
-        // 然后找interval最大的那个寄存器
-        if (i == 26) {
-            int max = 0;
-            int res = 8;
-            for (i = 8; i < 26; i++)
-                if (regs[i]->free == 1 && regs[i]->interval >= max) {
-                    max = regs[i]->interval;
-                    res = i;
-                }
-            i = res;
+static int mulSequence(int left, int src, int c, int total) {
+    unsigned long long u = c < 0 ? 0ull - (long long)c : (unsigned long long)c;
+    int pos[33], sign[33], num = 0, count = 0;
+    for (int p = 0; u != 0; p++, u >>= 1) {
+        if ((u & 1) == 0)
+            continue;
+        // 低两位为11时取-1，进位留给高位
+        sign[num] = (u & 3) == 3 ? -1 : 1;
+        pos[num++] = p;
+        u = sign[num - 1] < 0 ? u + 1 : u - 1;
+    }
+    if (num == 0) {
+        mulStep(&count, total, left, MOVE_MIPS, 0, 0, 0);
+        return count;
+    }
+    int acc = src, neg = c < 0;
+    for (int k = num - 1; k >= 0; k--) {
+        if (k < num - 1) {
+            int positive = (sign[k] > 0) != (c < 0);
+            if (neg && positive) {
+                mulStep(&count, total, left, SUBU_MIPS, src, acc, 0);
+                neg = 0;
+            }
+            else
+                mulStep(&count, total, left, positive != neg ? ADDU_MIPS : SUBU_MIPS, acc, src, 0);
+            acc = SCRATCH_REG2;
         }
-        // 这里是个很隐蔽的错误，因为对编译器的翻译而言，寄存器中的变量变化是线性的
-        // 而对于实际的机器执行而言，寄存器中的变量变化存在很多可能的分支，编译器仅能确保在一条语句的翻译过程中的变量正确
-        // 所以这里并不能保存寄存器中的旧值，因为我们不知道在实际运行过程中到达这条语句的该寄存器中存放的是否还是那个变量
-        // spillReg(regs[i], fp);
-        // regs[i]->var->regNo = -1;
-        regs[i]->var = var;
-        updateInterval(regs[i]);
-        // var->regNo = i;
-        if (load == 1) {
-            // 常量装载到寄存器中
-            if (var->op->kind == CONSTANT_OP)
-                fprintf(fp, "  li %s, %d\n", regs[i]->name, var->op->value);
-            // 将栈中存储的变量的值装载到寄存器中
-            else if (var->op->kind == VARIABLE_OP || var->op->kind == TEMP_VAR_OP)
-                fprintf(fp, "  lw %s, %d($fp)\n", regs[i]->name, -var->offset);
+        int shift = k > 0 ? pos[k] - pos[k-1] : pos[0];
+        if (shift > 0 || (num == 1 && !neg)) {
+            mulStep(&count, total, left, shift > 0 ? SLL_MIPS : MOVE_MIPS, acc, 0, shift);
+            acc = SCRATCH_REG2;
         }
-        return i;
     }
+    if (neg)
+        mulStep(&count, total, left, SUBU_MIPS, 0, acc, 0);
+    return count;
 }
 
-// 获取存放操作数的寄存器编号
-int getReg(Operand op, FILE* fp, int load) {
-    if (op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP) {
-        FrameDes frame = findCurrFrame();
-        // 在变量描述符链表中搜索该变量对应的描述符（一定存在）
-        VarDes var = createVarDes(op, frame);
-        if (var == NULL) {
-            printf("Error: Var should exist.\n");
-            exit(1);
-        }
-        // 这里同样是个很隐蔽的错误，正如上面所说，编译器仅能确保在一条语句的翻译过程的变量正确（至少在朴素寄存器分配算法中是这样）
-        // 所以我们必须为每个变量分配新的寄存器而不是使用编译器中保存的信息来推断之前该变量存储在哪个寄存器中，这是绝对不行的
-        // 记住编译器中保存的信息不等于机器运行过程中的实际信息，变量描述符里的这个regNo属性毫无用处
-        // if (var->regNo == -1) {
-        //     int res = allocateReg(var, fp, load);
-        //     regs[res]->free = 0;
-        //     return res;
-        // }
-        // else if (var->regNo >= 0) {
-        //     regs[var->regNo]->free = 0;
-        //     updateInterval(regs[var->regNo]);
-        //     return var->regNo;
-        // }
-        int res = allocateReg(var, fp, load);
-        regs[res]->free = 0;
-        return res;
-    }
-    else if (op->kind == CONSTANT_OP) {
-        // 如果常量为0直接返回0
-        if (op->value == 0)
-            return 0;
-        // 不能去搜索是否已有存储该常量的寄存器，因为目标代码执行的顺序和现在翻译的顺序是不同的，要以机器执行的角度思考
-        // 给该常量分配一个变量描述符，但这个描述符不会加入变量描述符链表
-        VarDes var = (VarDes)malloc(sizeof(VarDes_));
-        // var->regNo = -1;
-        var->offset = -1;
-        var->op = op;
-        int res = allocateReg(var, fp, load);
-        regs[res]->free = 0;
-        return res;
-    }
-    return 0;
+/*
+* 乘以常量c写入left：移位和加减序列的长度不超过li加mul的代价时使用该序列，否则返回0。
+* 中间结果可能溢出，用不会触发异常的addu和subu，模2^32的结果与mul相同
+*/
+int lowerMul(int left, int src, int c) {
+    int length = mulSequence(left, src, c, -1);
+    if (length > liCost(c) + MUL_COST)
+        return 0;
+    mulSequence(left, src, c, length);
+    mulLowered++;
+    return 1;
 }
 
-// 根据操作数的类型完成装载
-int handleOp(Operand op, FILE* fp, int load) {
-    if (op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP || op->kind == CONSTANT_OP)
-        return getReg(op, fp, load);
-    else if (op->kind == GET_VAL_OP) {
-        int reg = getReg(op->opr, fp, load);
-        fprintf(fp, "  lw %s, 0(%s)\n", regs[reg]->name, regs[reg]->name);
-        return reg;
-    }
-    else if (op->kind == GET_ADDR_OP) {
-        // TODO
-        // 为操作数分配一个寄存器
-        int reg = getReg(op->opr, fp, load);
-
-        // 如果操作数是一个变量或临时变量，将其地址加载到寄存器中
-        if (op->opr->kind == VARIABLE_OP || op->opr->kind == TEMP_VAR_OP) {
-            // 获取操作数对应的变量描述符
-            VarDes var = createVarDes(op->opr, findCurrFrame());
-
-            // 计算变量的地址并加载到寄存器
-            fprintf(fp, "  addi %s, $fp, -%d\n", regs[reg]->name, var->offset);
+/*
+* 有符号除数d（2 <= |d| < 2^31且不是2的幂）的魔数和移位量，见Hacker's Delight 10-1：
+* 商等于d与被除数之积的高32位（按魔数的符号修正）右移s位，负数再加1
+*/
+void magicDiv(int d, int* magic, int* shift) {
+    const unsigned int two31 = 0x80000000u;
+    unsigned int ad = d < 0 ? 0u - (unsigned int)d : (unsigned int)d;
+    unsigned int t = two31 + ((unsigned int)d >> 31);
+    unsigned int anc = t - 1 - t % ad;
+    unsigned int q1 = two31 / anc, r1 = two31 - q1 * anc;
+    unsigned int q2 = two31 / ad, r2 = two31 - q2 * ad;
+    unsigned int delta;
+    int p = 31;
+    do {
+        p++;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            q1++;
+            r1 -= anc;
         }
-        // 如果操作数是一个常量，将其立即值加载到寄存器中
-        else if (op->opr->kind == CONSTANT_OP) {
-            fprintf(fp, "  li %s, %d\n", regs[reg]->name, op->opr->value);
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) {
+            q2++;
+            r2 -= ad;
         }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+    *magic = (int)(q2 + 1);
+    if (d < 0)
+        *magic = -*magic;
+    *shift = p - 32;
+}
 
-        return reg;
+/*
+* 除以常量c写入left，商向0取整：|c|是2^k时负数先加上2^k - 1再算术右移k位；
+* 其他除数乘魔数取高32位再移位修正，mult按MUL_COST计。序列的代价不超过li加div和mflo时才使用。
+* c为0时保留div，运行时的行为不变。不使用序列时返回0
+*/
+int lowerDiv(int left, int src, int c) {
+    if (c == 0)
+        return 0;
+    unsigned int u = c < 0 ? 0u - (unsigned int)c : (unsigned int)c;
+    int k = log2Exact(u);
+    int magic = 0, shift = 0, fix = 0, cost;
+    if (k == 0)
+        cost = 1;
+    else if (k > 0)
+        cost = (k == 1 ? 1 : 2) + 2 + (c < 0);
+    else {
+        magicDiv(c, &magic, &shift);
+        fix = (c > 0 && magic < 0) || (c < 0 && magic > 0);
+        cost = liCost(magic) + MUL_COST + 1 + fix + (shift > 0) + 2;
     }
+    if (cost > liCost(c) + DIV_COST + 1)
+        return 0;
+    if (k == 0)
+        emitMips(c < 0 ? SUBU_MIPS : MOVE_MIPS, left, c < 0 ? 0 : src, src, 0);
+    else if (k > 0) {
+        // 被除数为负时SCRATCH_REG2得到2^k - 1，否则为0
+        if (k == 1)
+            emitMips(SRL_MIPS, SCRATCH_REG2, src, 0, 31);
+        else {
+            emitMips(SRA_MIPS, SCRATCH_REG2, src, 0, 31);
+            emitMips(SRL_MIPS, SCRATCH_REG2, SCRATCH_REG2, 0, 32 - k);
+        }
+        emitMips(ADDU_MIPS, SCRATCH_REG2, src, SCRATCH_REG2, 0);
+        emitMips(SRA_MIPS, left, SCRATCH_REG2, 0, k);
+        if (c < 0)
+            emitMips(SUBU_MIPS, left, 0, left, 0);
+    }
+    else {
+        emitMips(LI_MIPS, SCRATCH_REG2, 0, 0, magic);
+        emitMips(MULT_MIPS, 0, src, SCRATCH_REG2, 0);
+        emitMips(MFHI_MIPS, SCRATCH_REG2, 0, 0, 0);
+        if (fix)
+            emitMips(c > 0 ? ADDU_MIPS : SUBU_MIPS, SCRATCH_REG2, SCRATCH_REG2, src, 0);
+        if (shift > 0)
+            emitMips(SRA_MIPS, SCRATCH_REG2, SCRATCH_REG2, 0, shift);
+        // 被除数不再使用，left可以与它是同一个寄存器
+        emitMips(SRL_MIPS, left, SCRATCH_REG2, 0, 31);
+        emitMips(ADDU_MIPS, left, SCRATCH_REG2, left, 0);
+    }
+    divLowered++;
+    return 1;
 }
 
-// 将中间代码翻译为目标代码并向指定文件中打印
-// 同时需要负责协调寄存器的分配，因为同一指令中各个变量分配的寄存器不能相互抢占（某些情况下是可以优化的，暂时不考虑）
-void printObjectCodes(char* name) {
-    FILE* fp = fopen(name, "w");
-    if (fp == NULL) {
-        printf("Cannot open file %s", name);
+// 翻译形如x := y op z的运算指令，kind为对应的目标指令
+void translateArith(InterCode code, VarDes* ov, int kind) {
+    if (code->ops[0] == NULL)
         return;
+    Operand op1 = code->ops[1], op2 = code->ops[2];
+    VarDes var1 = ov[1], var2 = ov[2];
+    // 加法和乘法可以交换，常量放到右边
+    if ((kind == ADD_MIPS || kind == MUL_MIPS) && op1->kind == CONSTANT_OP && op2->kind != CONSTANT_OP) {
+        Operand op = op1; op1 = op2; op2 = op;
+        VarDes var = var1; var1 = var2; var2 = var;
     }
-    // 初始化
-    initRegs();
-    initFrames();
-    initObjectCode(fp);
-    // 
-    InterCode curr = interCodes;
-    int flag = 1;
-    while (flag == 1 || curr != interCodes) {
-        flag = 0;
+    int left = destReg(code->ops[0], ov[0]);
+    // 加上或减去16位以内的常量用addi，减去c即加上-c，不再把常量装入寄存器
+    if (op2->kind == CONSTANT_OP && ((kind == ADD_MIPS && FITS_IMM(op2->value)) ||
+        (kind == SUB_MIPS && op2->value > -32768 && op2->value <= 32768))) {
+        int right1 = loadOp(op1, var1, SCRATCH_REG1);
+        emitMips(ADDI_MIPS, left, right1, 0, kind == ADD_MIPS ? op2->value : -op2->value);
+        storeOp(code->ops[0], ov[0], left);
+        return;
+    }
+    int right1 = loadOp(op1, var1, SCRATCH_REG1);
+    // 乘除常量优先改写为移位、加减和乘魔数，不使用乘法器或除法器
+    if (op2->kind == CONSTANT_OP && ((kind == MUL_MIPS && lowerMul(left, right1, op2->value)) ||
+        (kind == DIV_MIPS && lowerDiv(left, right1, op2->value)))) {
+        storeOp(code->ops[0], ov[0], left);
+        return;
+    }
+    int right2 = loadOp(op2, var2, SCRATCH_REG2);
+    if (kind == DIV_MIPS) {
+        emitMips(DIV_MIPS, 0, right1, right2, 0);
+        emitMips(MFLO_MIPS, left, 0, 0, 0);
+    }
+    else
+        emitMips(kind, left, right1, right2, 0);
+    storeOp(code->ops[0], ov[0], left);
+}
+
+// 比较运算符对应的条件跳转指令
+int branchKind(char* relop) {
+    if (strcmp(relop, "==") == 0)
+        return BEQ_MIPS;
+    else if (strcmp(relop, "!=") == 0)
+        return BNE_MIPS;
+    else if (strcmp(relop, ">") == 0)
+        return BGT_MIPS;
+    else if (strcmp(relop, "<") == 0)
+        return BLT_MIPS;
+    else if (strcmp(relop, ">=") == 0)
+        return BGE_MIPS;
+    return BLE_MIPS;
+}
+
+// 交换比较的两边之后的条件跳转指令
+int mirrorBranch(int kind) {
+    switch (kind) {
+        case BGT_MIPS: return BLT_MIPS;
+        case BLT_MIPS: return BGT_MIPS;
+        case BGE_MIPS: return BLE_MIPS;
+        case BLE_MIPS: return BGE_MIPS;
+        default: return kind;
+    }
+}
+
+/*
+* 翻译条件跳转，常量在左边时交换两边。与0比较用beqz等只有一个寄存器的跳转；
+* 与16位以内的常量比较大小用slti得到x < c，再用bnez或beqz跳转，x <= c即x < c + 1；
+* 其余情况把常量装入寄存器后比较
+*/
+void translateBranch(InterCode code, VarDes* ov) {
+    Operand left = code->ops[0], right = code->ops[1];
+    VarDes leftVar = ov[0], rightVar = ov[1];
+    int kind = branchKind(code->relop);
+    int label = code->ops[2]->no;
+    if (left->kind == CONSTANT_OP && right->kind != CONSTANT_OP) {
+        Operand op = left; left = right; right = op;
+        VarDes var = leftVar; leftVar = rightVar; rightVar = var;
+        kind = mirrorBranch(kind);
+    }
+    if (right->kind == CONSTANT_OP && right->value == 0) {
+        int reg = loadOp(left, leftVar, SCRATCH_REG1);
+        emitMips(kind - BEQ_MIPS + BEQZ_MIPS, 0, reg, 0, 0)->label = label;
+        return;
+    }
+    if (right->kind == CONSTANT_OP && kind != BEQ_MIPS && kind != BNE_MIPS && FITS_IMM(right->value)) {
+        int bound = kind == BLT_MIPS || kind == BGE_MIPS ? right->value : right->value + 1;
+        if (FITS_IMM(bound)) {
+            int reg = loadOp(left, leftVar, SCRATCH_REG1);
+            emitMips(SLTI_MIPS, SCRATCH_REG2, reg, 0, bound);
+            emitMips(kind == BLT_MIPS || kind == BLE_MIPS ? BNEZ_MIPS : BEQZ_MIPS, 0, SCRATCH_REG2, 0, 0)->label = label;
+            return;
+        }
+    }
+    int regLeft = loadOp(left, leftVar, SCRATCH_REG1);
+    int regRight = loadOp(right, rightVar, SCRATCH_REG2);
+    emitMips(kind, 0, regLeft, regRight, 0)->label = label;
+}
+
+// 把[start, end)范围内的一个函数翻译为目标代码，变量优先使用寄存器分配的结果
+void translateFunction(int start, int end, OutBuffer out) {
+    CFG cfg = buildCFG(start, end);
+    recordCFGStats(cfg);
+    VarDes* opVars = (VarDes*)malloc(sizeof(VarDes) * 3 * (end - start));
+    // 每个调用点需要由调用者保存的寄存器
+    unsigned int* callSaves = (unsigned int*)calloc(end - start, sizeof(unsigned int));
+    FrameDes frame = initFrame(cfg, opVars);
+    allocateRegisters(cfg, frame, opVars, callSaves);
+    assignOffsets(frame);
+    currFrame = frame;
+    mipsCodeNum = 0;
+    // 数组、结构体和被取地址的变量的地址可能作为参数传出，有这样的变量时不做尾调用
+    int memoryVars = 0;
+    for (VarDes var = frame->vars; var != NULL; var = var->next)
+        memoryVars |= var->memory;
+    for (int i = start; i < end; i++) {
+        InterCode curr = &interCodes[i];
+        VarDes* ov = opVars + 3 * (i - start);
         switch (curr->kind) {
             case LABEL_IR: {
-                fprintf(fp, "label%d:\n", curr->ops[0]->no);
+                emitMips(LABEL_MIPS, 0, 0, 0, 0)->label = curr->ops[0]->no;
                 break;
             }
             case FUNC_IR: {
-                fprintf(fp, "\n%s:\n", curr->ops[0]->name);
-                // 将$fp的旧值压栈
-                fprintf(fp, "  addi $sp, $sp, -4\n");
-                fprintf(fp, "  sw $fp, 0($sp)\n");
-                // 将$sp的值赋给$fp，该函数的栈帧从$fp开始
-                fprintf(fp, "  move $fp, $sp\n");
-                strcpy(currFuncName, curr->ops[0]->name);
-                FrameDes frame = findCurrFrame();
-                // 如果不是main函数，那么被调用函数需要将所有可操作寄存器保存到栈中并清空可操作寄存器
-                if (strcmp(curr->ops[0]->name, "main") != 0) {
-                    pushAllRegs(fp);
-                    // 为变量和局部变量预留出空间
-                    fprintf(fp, "  addi $sp, $sp, %d\n", -frame->vars->offset+72);
+                emitMips(FUNC_MIPS, 0, 0, 0, 0)->name = curr->ops[0]->name;
+                // 一次性分配整个栈帧
+                if (frame->size > 0)
+                    emitMips(ADDI_MIPS, 29, 29, 0, -frame->size);
+                // 非叶函数保存$ra和$fp的旧值，并让$fp指向函数入口时的$sp
+                if (!frame->leaf) {
+                    emitMips(SW_MIPS, 0, 29, 31, frame->size - 4);
+                    emitMips(SW_MIPS, 0, 29, 30, frame->size - 8);
+                    emitMips(ADDI_MIPS, 30, 29, 0, frame->size);
                 }
-                else
-                    fprintf(fp, "  addi $sp, $sp, %d\n", -frame->vars->offset);
-                clearRegs();
+                // 保存函数中用到的被调用者保存寄存器
+                saveRegs(frame->calleeSaved, SW_MIPS);
                 // 处理函数的参数声明（即FUNC指令后的PARAM指令）
                 int argCount = 0;
-                while (curr->next != NULL && curr->next->kind == PARAM_IR) {
-                    curr = curr->next;
+                while (i + 1 < end && interCodes[i+1].kind == PARAM_IR) {
+                    i++;
                     argCount++;
-                    int reg = handleOp(curr->ops[0], fp, 0);
-                    // 将函数的前四个参数从特定寄存器装载到为形参分配的寄存器中
+                    Operand param = interCodes[i].ops[0];
+                    VarDes var = opVars[3 * (i - start)];
+                    // 函数的前四个参数在特定寄存器中
                     if (argCount <= 4)
-                        fprintf(fp, "  move %s, %s\n", regs[reg]->name, regs[argCount+3]->name);
-                    // 将函数的后几个参数从栈上装载到为形参分配的寄存器中
-                    else
-                        fprintf(fp, "  lw %s, %d($fp)\n", regs[reg]->name, 4*(argCount-4) + 4);
-                    spillReg(regs[reg], fp);
+                        storeOp(param, var, argCount + 3);
+                    // 后几个参数在调用者栈帧的底部，第五个参数就在函数入口时的$sp处
+                    else {
+                        emitMips(LW_MIPS, SCRATCH_REG1, slotBase(), 0, slotOffset(-4*(argCount-5)));
+                        storeOp(param, var, SCRATCH_REG1);
+                    }
                 }
                 break;
             }
             case ASSIGN_IR: {
-                // TODO
-                // 赋值指令处理
-                Operand left = curr->ops[0];      // 获取赋值的左操作数
-                Operand right = curr->ops[1];     // 获取赋值的右操作数
-
-                // 处理右操作数，获取存放值的寄存器编号
-                int regRight = handleOp(right, fp, 1);
-
-                // 处理左值的情况
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) {
-                    // 处理左操作数，获取存放值的寄存器编号
-                    int regLeft = getReg(left, fp, 1);
-
-                    // 生成移动指令，将右操作数的值移动到左操作数
-                    fprintf(fp, "  move %s, %s\n", regs[regLeft]->name, regs[regRight]->name);
-
-                    // 存储寄存器中的值到栈上
-                    spillReg(regs[regLeft], fp);
-                }
-                // 处理间接寻址的情况
-                else if (left->kind == GET_VAL_OP) {
-                    // 处理左操作数，获取存放地址的寄存器编号
-                    int regLeft1 = getReg(left->opr, fp, 1);
-
-                    // 生成移动指令，将右操作数的值移动到左操作数
-                    fprintf(fp, "  move %s, %s\n", regs[regLeft1]->name, regs[regRight]->name);
-
-                    // 处理左操作数，获取存放值的寄存器编号
-                    int regLeft2 = getReg(left->opr, fp, 1);
-
-                    // 将左操作数的值存储到地址中
-                    fprintf(fp, "  sw %s, 0(%s)\n", regs[regLeft1]->name, regs[regLeft2]->name);
-                }
-                break;
-            }
-            case PLUS_IR: {
                 Operand left = curr->ops[0];
-                Operand right1 = curr->ops[1];
-                Operand right2 = curr->ops[2];
-                int regRight1 = handleOp(right1, fp, 1);
-                int regRight2 = handleOp(right2, fp, 1);
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) {
-                    int regLeft = getReg(left, fp, 0);
-                    fprintf(fp, "  add %s, %s, %s\n", regs[regLeft]->name, regs[regRight1]->name, regs[regRight2]->name);
-                    spillReg(regs[regLeft], fp);                
+                Operand right = curr->ops[1];
+                // 条件表达式作为语句时没有结果
+                if (left == NULL)
+                    break;
+                // 左值在寄存器中时右值直接装载到该寄存器
+                if ((left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) && ov[0]->regNo >= 0) {
+                    int reg = loadOp(right, ov[1], ov[0]->regNo);
+                    storeOp(left, ov[0], reg);
                 }
-                else if (left->kind == GET_VAL_OP) {
-                    int regLeft1 = getReg(left->opr, fp, 0);
-                    fprintf(fp, "  add %s, %s, %s\n", regs[regLeft1]->name, regs[regRight1]->name, regs[regRight2]->name);
-                    int regLeft2 = getReg(left->opr, fp, 1);
-                    fprintf(fp, "  sw %s, 0(%s)\n", regs[regLeft1]->name, regs[regLeft2]->name);
+                else {
+                    int reg = loadOp(right, ov[1], SCRATCH_REG1);
+                    storeOp(left, ov[0], reg);
                 }
                 break;
             }
-            case SUB_IR: {
-                // TODO
-                // 减法指令处理
-                Operand left = curr->ops[0];      // 获取减法运算的左操作数
-                Operand right1 = curr->ops[1];    // 获取减法运算的右操作数1
-                Operand right2 = curr->ops[2];    // 获取减法运算的右操作数2
-
-                // 处理右操作数1，获取存放值的寄存器编号
-                int regRight1 = handleOp(right1, fp, 1);
-
-                // 处理右操作数2，获取存放值的寄存器编号
-                int regRight2 = handleOp(right2, fp, 1);
-
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) {
-                    // 处理左操作数，获取存放值的寄存器编号
-                    int regLeft = getReg(left, fp, 0);
-
-                    // 生成减法指令
-                    fprintf(fp, "  sub %s, %s, %s\n", regs[regLeft]->name, regs[regRight1]->name, regs[regRight2]->name);
-
-                    // 存储寄存器中的值到栈上
-                    spillReg(regs[regLeft], fp);
-                }
-                else if (left->kind == GET_VAL_OP) {
-                    // 处理左操作数，获取存放地址的寄存器编号
-                    int regLeft1 = getReg(left->opr, fp, 0);
-
-                    // 生成减法指令
-                    fprintf(fp, "  sub %s, %s, %s\n", regs[regLeft1]->name, regs[regRight1]->name, regs[regRight2]->name);
-
-                    // 处理左操作数，获取存放值的寄存器编号
-                    int regLeft2 = getReg(left->opr, fp, 1);
-
-                    // 将左操作数的值存储到地址中
-                    fprintf(fp, "  sw %s, 0(%s)\n", regs[regLeft1]->name, regs[regLeft2]->name);
-                }
+            case PLUS_IR:
+                translateArith(curr, ov, ADD_MIPS);
                 break;
-            }
-            case MUL_IR: {
-                Operand left = curr->ops[0];
-                Operand right1 = curr->ops[1];
-                Operand right2 = curr->ops[2];
-                int regRight1 = handleOp(right1, fp, 1);
-                int regRight2 = handleOp(right2, fp, 1);
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) {
-                    int regLeft = getReg(left, fp, 0);
-                    fprintf(fp, "  mul %s, %s, %s\n", regs[regLeft]->name, regs[regRight1]->name, regs[regRight2]->name);
-                    spillReg(regs[regLeft], fp);
-                }
-                else if (left->kind == GET_VAL_OP) {
-                    int regLeft1 = getReg(left->opr, fp, 0);
-                    fprintf(fp, "  mul %s, %s, %s\n", regs[regLeft1]->name, regs[regRight1]->name, regs[regRight2]->name);
-                    int regLeft2 = getReg(left->opr, fp, 1);
-                    fprintf(fp, "  sw %s, 0(%s)\n", regs[regLeft1]->name, regs[regLeft2]->name);
-                }
+            case SUB_IR:
+                translateArith(curr, ov, SUB_MIPS);
                 break;
-            }
-            case DIV_IR: {
-                // TODO
-                // 除法指令处理
-                Operand left = curr->ops[0];      // 获取除法运算的左操作数
-                Operand right1 = curr->ops[1];    // 获取除法运算的右操作数1
-                Operand right2 = curr->ops[2];    // 获取除法运算的右操作数2
-
-                // 处理右操作数1，获取存放值的寄存器编号
-                int regRight1 = handleOp(right1, fp, 1);
-
-                // 处理右操作数2，获取存放值的寄存器编号
-                int regRight2 = handleOp(right2, fp, 1);
-
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) {
-                    // 处理左操作数，获取存放值的寄存器编号
-                    int regLeft = getReg(left, fp, 0);
-
-                    // 生成除法指令
-                    fprintf(fp, "  div %s, %s\n", regs[regRight1]->name, regs[regRight2]->name);
-
-                    // 读取商到目标寄存器
-                    fprintf(fp, "  mflo %s\n", regs[regLeft]->name);
-
-                    // 存储寄存器中的值到栈上
-                    spillReg(regs[regLeft], fp);
-                }
-                else if (left->kind == GET_VAL_OP) {
-                    // 处理左操作数，获取存放地址的寄存器编号
-                    int regLeft1 = getReg(left->opr, fp, 0);
-
-                    // 生成除法指令
-                    fprintf(fp, "  div %s, %s\n", regs[regRight1]->name, regs[regRight2]->name);
-
-                    // 读取商到目标寄存器
-                    fprintf(fp, "  mflo %s\n", regs[regLeft1]->name);
-
-                    // 处理左操作数，获取存放值的寄存器编号
-                    int regLeft2 = getReg(left->opr, fp, 1);
-
-                    // 将左操作数的值存储到地址中
-                    fprintf(fp, "  sw %s, 0(%s)\n", regs[regLeft1]->name, regs[regLeft2]->name);
-                }
+            case MUL_IR:
+                translateArith(curr, ov, MUL_MIPS);
+                break;
+            case DIV_IR:
+                translateArith(curr, ov, DIV_MIPS);
                 break;
-            }
             case TO_MEM_IR: {
-                Operand left = curr->ops[0];
-                Operand right = curr->ops[1];
-                int regRight = handleOp(right, fp, 1);
-                if (left->kind == VARIABLE_OP || left->kind == TEMP_VAR_OP) {
-                    int regLeft = getReg(left, fp, 1);
-                    fprintf(fp, "  sw %s, 0(%s)\n", regs[regRight]->name, regs[regLeft]->name);
-                }
+                int regRight = loadOp(curr->ops[1], ov[1], SCRATCH_REG1);
+                int regLeft = loadOp(curr->ops[0], ov[0], SCRATCH_REG2);
+                emitMips(SW_MIPS, 0, regLeft, regRight, 0);
                 break;
             }
             case GOTO_IR: {
-                fprintf(fp, "  j label%d\n", curr->ops[0]->no);
+                emitMips(J_MIPS, 0, 0, 0, 0)->label = curr->ops[0]->no;
                 break;
             }
-            case IF_GOTO_IR: {
-                Operand left = curr->ops[0];
-                Operand right = curr->ops[1];
-                int regLeft = handleOp(left, fp, 1);
-                int regRight = handleOp(right, fp, 1);
-                char relop[4];
-                if (strcmp(curr->relop, "==") == 0)
-                    sprintf(relop, "beq");
-                else if (strcmp(curr->relop, "!=") == 0)
-                    sprintf(relop, "bne");
-                else if (strcmp(curr->relop, ">") == 0)
-                    sprintf(relop, "bgt");
-                else if (strcmp(curr->relop, "<") == 0)
-                    sprintf(relop, "blt");
-                else if (strcmp(curr->relop, ">=") == 0)
-                    sprintf(relop, "bge");
-                else if (strcmp(curr->relop, "<=") == 0)
-                    sprintf(relop, "ble");
-                fprintf(fp, "  %s %s, %s, label%d\n", relop, regs[regLeft]->name, regs[regRight]->name, curr->ops[2]->no);
+            case IF_GOTO_IR:
+                translateBranch(curr, ov);
                 break;
-            }
             case RETURN_IR: {
-                int reg = handleOp(curr->ops[0], fp, 1);
-                fprintf(fp, "  move $v0, %s\n", regs[reg]->name);
-                // 如果不是main函数，那么被调用函数需要将所有可操作寄存器保存到栈中并清空可操作寄存器
-                if (strcmp(currFuncName, "main") != 0) {
-                    // 弹出栈帧中的所有多余项并恢复寄存器的旧值
-                    fprintf(fp, "  addi $sp, $fp, -72\n");
-                    popAllRegs(fp);
-                }
-                else
-                    fprintf(fp, "  move $sp, $fp\n");
-                // 恢复$fp的旧值
-                fprintf(fp, "  lw $fp, 0($sp)\n");
-                fprintf(fp, "  addi $sp, $sp, 4\n");    
-                fprintf(fp, "  jr $ra\n");
+                int reg = loadOp(curr->ops[0], ov[0], 2);
+                if (reg != 2)
+                    emitMips(MOVE_MIPS, 2, reg, 0, 0);
+                restoreFrame(frame);
+                emitMips(JR_MIPS, 0, 31, 0, 0);
                 break;
             }
             case DEC_IR:
@@ -657,83 +813,111 @@ void printObjectCodes(char* name) {
                 // 传参代码一定是在CALL指令之前，所以不单独翻译，在CALL指令部分翻译
                 break;
             case CALL_IR: {
-                // 处理CALL指令之前的ARG指令
-                InterCode preCode = curr->pre;
-                int argCount = 0;
-                // 为前四个之后的参数分配的寄存器编号
-                // TODO: 这个数组的大小可能需要调整，如果存在一个参数特别多的函数的话
-                int regNos[64];
-                while (preCode != NULL && preCode->kind == ARG_IR) {
-                    argCount++;
-                    Operand arg = preCode->ops[0];
-                    int reg = handleOp(arg, fp, 1);
-                    // 函数的前四个存放在特定寄存器中
-                    if (argCount <= 4)
-                        fprintf(fp, "  move %s, %s\n", regs[argCount+3]->name, regs[reg]->name);
-                    // 后面的参数存放在栈上
-                    // 因为这些参数必须要连续存放，中间不能保存其他的东西，所以需要统一分配好寄存器再统一压栈
-                    else
-                        regNos[argCount-5] = reg;
-                    preCode = preCode->pre;
-                }
-                // 将后面的参数连续压栈（参数压栈顺序为从后往前）
-                for (int i = argCount - 5; i >= 0; i--) {
-                    fprintf(fp, "  addi $sp, $sp, -4\n");
-                    fprintf(fp, "  sw %s, 0($sp)\n", regs[regNos[i]]->name);
-                }
-                fputs("  addi $sp, $sp, -4\n", fp);
-		        fputs("  sw $ra, 0($sp)\n", fp);
-                fprintf(fp, "  jal %s\n", curr->ops[1]->name);
-                fputs("  lw $ra, 0($sp)\n", fp);
-		        fputs("  addi $sp, $sp, 4\n", fp);
-                if (curr->ops[0]->kind == VARIABLE_OP || curr->ops[0]->kind == TEMP_VAR_OP) {
-                    int regNo = getReg(curr->ops[0], fp, 0);
-		            fprintf(fp, "  move %s, $v0\n", regs[regNo]->name);
-                    spillReg(regs[regNo], fp);
+                // CALL指令之前连续的ARG指令，离CALL最近的是第一个参数
+                int argNum = 0;
+                while (i - argNum - 1 >= start && interCodes[i-argNum-1].kind == ARG_IR)
+                    argNum++;
+                /*
+                * 尾调用：紧跟的RETURN返回的正是调用结果，参数都在寄存器中，且栈帧中没有可能被传出地址的变量，
+                * 参数装入$a0-$a3后先按RETURN的方式释放栈帧，再直接跳到被调用函数，由它返回到我们的调用者
+                */
+                if (argNum <= 4 && !memoryVars && curr->ops[0] != NULL && i + 1 < end
+                    && interCodes[i+1].kind == RETURN_IR && opEqual(curr->ops[0], interCodes[i+1].ops[0])) {
+                    for (int k = 1; k <= argNum; k++) {
+                        int reg = loadOp(interCodes[i-k].ops[0], opVars[3 * (i - k - start)], k + 3);
+                        if (reg != k + 3)
+                            emitMips(MOVE_MIPS, k + 3, reg, 0, 0);
+                    }
+                    restoreFrame(frame);
+                    emitMips(J_MIPS, 0, 0, 0, 0)->name = curr->ops[1]->name;
+                    tailCallTotal++;
+                    i++;
+                    break;
                 }
-                else if (curr->ops[0]->kind == GET_VAL_OP) {
-                    int regNo = getReg(curr->ops[0]->opr, fp, 1);
-                    fprintf(fp, "  sw $v0, 0(%s)\n", regs[regNo]->name);
+                // 保存调用之后还要使用的调用者保存寄存器
+                saveRegs(callSaves[i - start], SW_MIPS);
+                // 前四个之后的参数按顺序存放在栈上，第五个参数在最低的地址
+                if (argNum > 4)
+                    emitMips(ADDI_MIPS, 29, 29, 0, -4*(argNum-4));
+                for (int k = 1; k <= argNum; k++) {
+                    Operand arg = interCodes[i-k].ops[0];
+                    VarDes var = opVars[3 * (i - k - start)];
+                    // 函数的前四个参数存放在特定寄存器中
+                    if (k <= 4) {
+                        int reg = loadOp(arg, var, k + 3);
+                        if (reg != k + 3)
+                            emitMips(MOVE_MIPS, k + 3, reg, 0, 0);
+                    }
+                    else {
+                        int reg = loadOp(arg, var, SCRATCH_REG1);
+                        emitMips(SW_MIPS, 0, 29, reg, 4*(k-5));
+                    }
                 }
+                // $ra已经在函数入口处保存
+                emitMips(JAL_MIPS, 0, 0, 0, 0)->name = curr->ops[1]->name;
+                // 调用结束后弹出栈上的参数并恢复保存的寄存器
+                if (argNum > 4)
+                    emitMips(ADDI_MIPS, 29, 29, 0, 4*(argNum-4));
+                saveRegs(callSaves[i - start], LW_MIPS);
+                // 函数调用作为语句时没有存放返回值的操作数
+                if (curr->ops[0] != NULL)
+                    storeOp(curr->ops[0], ov[0], 2);
                 break;
             }
             case PARAM_IR:
                 // 声明代码一定是在FUNC指令之后，所以不单独翻译，在FUNC指令部分翻译
                 break;
             case READ_IR: {
-                fputs("  addi $sp, $sp, -4\n", fp);
-		        fputs("  sw $ra, 0($sp)\n", fp);
-		        fputs("  jal read\n", fp);
-		        fputs("  lw $ra, 0($sp)\n", fp);
-		        fputs("  addi $sp, $sp, 4\n", fp);
-		        if (curr->ops[0]->kind == VARIABLE_OP || curr->ops[0]->kind == TEMP_VAR_OP) {
-                    int regNo = getReg(curr->ops[0], fp, 0);
-		            fprintf(fp, "  move %s, $v0\n", regs[regNo]->name);
-                    spillReg(regs[regNo], fp);
-                }
-                else if (curr->ops[0]->kind == GET_VAL_OP) {
-                    int regNo = getReg(curr->ops[0]->opr, fp, 1);
-                    fprintf(fp, "  sw $v0, 0(%s)\n", regs[regNo]->name);
-                }
+                // read和write只使用$v0和$a0，不需要保存其他寄存器
+                emitMips(JAL_MIPS, 0, 0, 0, 0)->name = "read";
+                if (curr->ops[0] != NULL)
+                    storeOp(curr->ops[0], ov[0], 2);
                 break;
             }
             case WRITE_IR: {
-                int regNo = handleOp(curr->ops[0], fp, 1);
-                fprintf(fp, "  move $a0, %s\n", regs[regNo]->name);
-                fputs("  addi $sp, $sp, -4\n", fp);
-		        fputs("  sw $ra, 0($sp)\n", fp);
-		        fputs("  jal write\n", fp);
-		        fputs("  lw $ra, 0($sp)\n", fp);
-		        fputs("  addi $sp, $sp, 4\n", fp);
+                int reg = loadOp(curr->ops[0], ov[0], 4);
+                if (reg != 4)
+                    emitMips(MOVE_MIPS, 4, reg, 0, 0);
+                emitMips(JAL_MIPS, 0, 0, 0, 0)->name = "write";
                 break;
             }
             default:
                 break;
         }
-        fflush(fp);
-        // 多条指令之间应该不存在寄存器分配的抢占问题，所以在处理完一条指令后将所有寄存器的free标记置1
-        freeRegs();
-        curr = curr->next;
     }
-    fclose(fp);
+    // 整个函数生成之后做窥孔优化，再输出留下的指令
+    optimizeMipsCodes();
+    for (int i = 0; i < mipsCodeNum; i++)
+        printMipsCode(&mipsCodes[i], out);
+    free(opVars);
+    free(callSaves);
+    freeCFG(cfg);
+}
+
+// 将中间代码翻译为目标代码并向指定文件中打印，逐个函数进行寄存器分配和翻译
+void printObjectCodes(char* name) {
+    OutBuffer out = openOutBuffer(name);
+    if (out == NULL) {
+        printf("Cannot open file %s", name);
+        return;
+    }
+    initRegs();
+    initObjectCode(out);
+    int start = 0;
+    while (start < interCodeNum) {
+        if (interCodes[start].kind != FUNC_IR) {
+            start++;
+            continue;
+        }
+        int end = findFuncEnd(start);
+        translateFunction(start, end, out);
+        start = end;
+    }
+    closeOutBuffer(out);
+}
+
+// 打印目标代码生成的统计信息
+void printObjectCodeStats(FILE* fp) {
+    fprintf(fp, "objectcode: %d tail calls reuse the caller's frame\n", tailCallTotal);
+    fprintf(fp, "objectcode: %d multiplications and %d divisions by constants lowered\n", mulLowered, divLowered);
 }
\ No newline at end of file
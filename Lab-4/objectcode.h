@@ -3,36 +3,77 @@
 
 #include "intercode.h"
 
+// 能放进16位有符号立即数的值
+#define FITS_IMM(v) ((v) >= -32768 && (v) <= 32767)
+// 乘法和除法的估计代价，以单周期指令为单位，乘除常量时据此在移位和加减序列与mul、div之间选择
+#define MUL_COST 4
+#define DIV_COST 35
+
+// 栈帧中变量哈希表的初始桶数（2的幂），变量数超过桶数时翻倍
+#define VAR_TABLE_INIT_SIZE 16
+
 typedef struct RegDes_d RegDes_;
 typedef RegDes_* RegDes;
 typedef struct VarDes_d VarDes_;
 typedef VarDes_* VarDes;
 typedef struct FrameDes_d FrameDes_;
 typedef FrameDes_* FrameDes;
+typedef struct MipsCode_d MipsCode_;
+typedef MipsCode_* MipsCode;
 
 // 寄存器描述符
 struct RegDes_d {
-    int free;       // 标记是否可用，用来协调寄存器分配的互不抢占
-    int interval;   // 距上次访问的间隔，用于寄存器选择
     char name[6];   // 寄存器别名
-    VarDes var;     // 存储在该寄存器中的变量的描述符
 };
 
 // 变量描述符
 struct VarDes_d {
-    // int regNo;   // 存储该变量的寄存器的编号，-1表示无
-    int offset;     // 该变量相当于当前栈帧底部的偏移量
+    int no;         // 变量在所属函数中的编号
+    int regNo;      // 寄存器分配的结果：分配到的寄存器编号，-1表示存放在栈上
+    int memory;     // 是否必须存放在内存中（数组和结构体需要取地址）
+    int offset;     // 存放在栈上的变量位于函数入口时$sp之下offset字节处
     Operand op;     // 描述的操作数信息
     VarDes next;    // 链接下一个变量描述符
+    VarDes hashNext;    // 哈希表同一个桶中的下一个变量描述符
 };
 
 // 栈帧描述符
 struct FrameDes_d {
-    char name[32];  // 该栈帧对应函数的名称
-    VarDes vars;    // 该栈帧中预定存放对应函数的所有变量/临时变量，通过翻译前对中间代码的扫描预先安排好次序，方便对变量地址的定位
+    char* name;     // 该栈帧对应函数的名称（驻留字符串）
+    VarDes vars;    // 该函数中出现的所有变量/临时变量，由翻译前对中间代码的扫描得到
+    int varNum;     // 变量描述符的个数
+    VarDes* varTable;   // 按临时变量编号或变量名（驻留字符串地址）索引的哈希表
+    int tableSize;      // 哈希表的桶数
+    int leaf;       // 是否是叶函数（不调用其他函数），叶函数不保存$ra和$fp，以$sp为基址访问栈帧
+    unsigned int calleeSaved;   // 函数中用到的需要由被调用者保存的寄存器（$s0-$s7）
+    unsigned int callerSaved;   // 在某个调用点需要由调用者保存的寄存器（$t0-$t7）
+    int regOffset[32];  // 保存寄存器的栈上位置
+    int size;       // 栈帧大小：$ra、$fp、保存的寄存器以及放在栈上的变量
     FrameDes next;  // 链接下一个栈帧描述符
 };
 
+// 单条MIPS指令，一个函数的指令先全部生成在内存中，经过窥孔优化后再输出
+struct MipsCode_d {
+    enum {
+        LABEL_MIPS, FUNC_MIPS, LI_MIPS, MOVE_MIPS, ADD_MIPS, ADDU_MIPS, ADDI_MIPS,
+        SLTI_MIPS, SUB_MIPS, SUBU_MIPS, MUL_MIPS, MULT_MIPS, DIV_MIPS, MFLO_MIPS,
+        MFHI_MIPS, SLL_MIPS, SRA_MIPS, SRL_MIPS, LW_MIPS, SW_MIPS,
+        J_MIPS, JAL_MIPS, JR_MIPS, BEQ_MIPS, BNE_MIPS, BGT_MIPS,
+        BLT_MIPS, BGE_MIPS, BLE_MIPS, BEQZ_MIPS, BNEZ_MIPS, BGTZ_MIPS,
+        BLTZ_MIPS, BGEZ_MIPS, BLEZ_MIPS, NOP_MIPS
+    } kind;
+    int rd;         // 目的寄存器
+    int rs;         // 第一个源寄存器，lw和sw的基址寄存器
+    int rt;         // 第二个源寄存器，sw要存入内存的寄存器
+    int imm;        // 立即数，lw和sw的偏移
+    int label;      // 标记和跳转目标的编号
+    char* name;     // 函数名，j跳到函数名时是尾调用
+};
+
+extern MipsCode mipsCodes;
+extern int mipsCodeNum;
+
 void printObjectCodes(char* name);
+void printObjectCodeStats(FILE* fp);
 
 #endif
\ No newline at end of file
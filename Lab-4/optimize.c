@@ -0,0 +1,170 @@
+#include "optimize.h"
+
+extern int tmpVarNo;
+
+/*
+* SSA上的清理按顺序反复进行到不动点，测试程序和生成的大程序几轮之内就没有改动了
+* 轮数上限只防止两项清理互相撤销对方的改动时不停机，正常情况下达不到
+*/
+#define OPTIMIZE_ROUNDS 64
+
+// 每个函数中拷贝传播减少的拷贝数和临时变量数
+typedef struct FuncStat_d {
+    char* name;
+    int copies;
+    int temps;
+} FuncStat;
+
+static FuncStat* funcStats = NULL;
+static int funcStatNum = 0;
+static int funcStatCap = 0;
+static int copyRemoved = 0;
+static int tempRemoved = 0;
+static int funcCopies = 0;
+static int funcTemps = 0;
+
+// 统计不同临时变量时按函数打戳，数组随临时变量编号增长
+static int* tempStamp = NULL;
+static int tempStampCap = 0;
+static int stampNo = 0;
+
+static void stampTemp(Operand op, int* temps) {
+    if (op != NULL && (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP))
+        op = op->opr;
+    if (op == NULL || op->kind != TEMP_VAR_OP)
+        return;
+    if (tempStamp[op->no] != stampNo) {
+        tempStamp[op->no] = stampNo;
+        (*temps)++;
+    }
+}
+
+// 统计当前函数中变量和临时变量之间的拷贝数，以及出现的不同临时变量数
+static void countCopies(int* copies, int* temps) {
+    if (tempStampCap < tmpVarNo) {
+        int cap = tempStampCap * 2 > tmpVarNo ? tempStampCap * 2 : tmpVarNo;
+        tempStamp = (int*)realloc(tempStamp, sizeof(int) * cap);
+        for (int i = tempStampCap; i < cap; i++)
+            tempStamp[i] = 0;
+        tempStampCap = cap;
+    }
+    stampNo++;
+    *copies = 0;
+    *temps = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind == ASSIGN_IR && code->ops[0] != NULL &&
+            (code->ops[0]->kind == VARIABLE_OP || code->ops[0]->kind == TEMP_VAR_OP) &&
+            (code->ops[1]->kind == VARIABLE_OP || code->ops[1]->kind == TEMP_VAR_OP))
+            (*copies)++;
+        for (int k = 0; k < 3; k++)
+            stampTemp(code->ops[k], temps);
+    }
+}
+
+// 拷贝传播，前后统计当前函数的拷贝数和临时变量数，减少的部分记到当前函数上
+static int countedPropagateCopies() {
+    int copiesBefore, tempsBefore, copiesAfter, tempsAfter;
+    countCopies(&copiesBefore, &tempsBefore);
+    int changes = propagateCopies();
+    countCopies(&copiesAfter, &tempsAfter);
+    funcCopies += copiesBefore - copiesAfter;
+    funcTemps += tempsBefore - tempsAfter;
+    return changes;
+}
+
+typedef int (*CleanupPass)();
+static CleanupPass cleanups[] = { propagateConstants, numberValues, countedPropagateCopies, eliminateDeadCode, hoistInvariants, reduceStrength };
+#define CLEANUP_NUM ((int)(sizeof(cleanups) / sizeof(cleanups[0])))
+
+// 优化一个函数，函数的指令在优化期间单独放在interCodes中
+static void optimizeFunction() {
+    funcCopies = 0;
+    funcTemps = 0;
+    // 内联展开留下的跳转和标记先整理掉，SSA上的化简可能折叠分支，结束后再整理一次
+    simplifyCFG();
+    buildSSA();
+    /*
+    * 各项清理互相创造机会，反复进行到没有改动为止
+    * 每项清理单独重复运行不会再有改动，所以只有在它上次运行之后其他清理改动过代码才需要再运行
+    */
+    int changes = 0;
+    int lastRun[CLEANUP_NUM];
+    for (int p = 0; p < CLEANUP_NUM; p++)
+        lastRun[p] = -1;
+    for (int round = 0; round < OPTIMIZE_ROUNDS; round++) {
+        int ran = 0;
+        for (int p = 0; p < CLEANUP_NUM; p++) {
+            if (lastRun[p] == changes)
+                continue;
+            changes += cleanups[p]();
+            lastRun[p] = changes;
+            ran = 1;
+        }
+        if (!ran)
+            break;
+    }
+    destructSSA();
+    simplifyCFG();
+    copyRemoved += funcCopies;
+    tempRemoved += funcTemps;
+    if (funcStatNum == funcStatCap) {
+        funcStatCap = funcStatCap > 0 ? funcStatCap * 2 : 64;
+        funcStats = (FuncStat*)realloc(funcStats, sizeof(FuncStat) * funcStatCap);
+    }
+    funcStats[funcStatNum].name = interCodes[0].ops[0]->name;
+    funcStats[funcStatNum].copies = funcCopies;
+    funcStats[funcStatNum].temps = funcTemps;
+    funcStatNum++;
+}
+
+/*
+* 先在整个程序上做内联展开，再逐个函数优化中间代码：把函数的指令拷贝出来作为当前的interCodes，
+* 优化结束后按原来的顺序拼接成新的指令数组
+*/
+void optimizeProgram() {
+    inlineCalls();
+    InterCode all = interCodes;
+    int allNum = interCodeNum;
+    int resultCap = allNum > 0 ? allNum : 1;
+    int resultNum = 0;
+    InterCode result = (InterCode)malloc(sizeof(InterCode_) * resultCap);
+    int start = 0;
+    while (start < allNum) {
+        int end = start + 1;
+        while (end < allNum && all[end].kind != FUNC_IR)
+            end++;
+        interCodeNum = end - start;
+        interCodes = (InterCode)malloc(sizeof(InterCode_) * interCodeNum);
+        memcpy(interCodes, all + start, sizeof(InterCode_) * interCodeNum);
+        if (all[start].kind == FUNC_IR)
+            optimizeFunction();
+        if (resultNum + interCodeNum > resultCap) {
+            while (resultNum + interCodeNum > resultCap)
+                resultCap *= 2;
+            result = (InterCode)realloc(result, sizeof(InterCode_) * resultCap);
+        }
+        memcpy(result + resultNum, interCodes, sizeof(InterCode_) * interCodeNum);
+        resultNum += interCodeNum;
+        free(interCodes);
+        start = end;
+    }
+    free(all);
+    interCodes = result;
+    interCodeNum = resultNum;
+}
+
+// 打印优化的统计信息，按程序中的顺序列出每个函数中拷贝传播减少的拷贝数和临时变量数
+void printOptimizeStats(FILE* fp) {
+    printInlineStats(fp);
+    printSSAStats(fp);
+    printSCCPStats(fp);
+    printLVNStats(fp);
+    printCopyStats(fp);
+    printDCEStats(fp);
+    printLICMStats(fp);
+    printIVSRStats(fp);
+    fprintf(fp, "optimize: copy propagation removed %d copies and %d temps in %d functions\n", copyRemoved, tempRemoved, funcStatNum);
+    for (int i = 0; i < funcStatNum; i++)
+        fprintf(fp, "optimize:   %-16s %d copies, %d temps\n", funcStats[i].name, funcStats[i].copies, funcStats[i].temps);
+}
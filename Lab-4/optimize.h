@@ -0,0 +1,17 @@
+#ifndef OPTIMIZE_H
+#define OPTIMIZE_H
+
+#include "ssa.h"
+#include "inliner.h"
+#include "sccp.h"
+#include "lvn.h"
+#include "copyprop.h"
+#include "dce.h"
+#include "licm.h"
+#include "ivsr.h"
+#include "simplify.h"
+
+void optimizeProgram();
+void printOptimizeStats(FILE* fp);
+
+#endif
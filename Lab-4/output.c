@@ -0,0 +1,101 @@
+#include <stdarg.h>
+#include "output.h"
+
+// 统计信息：输出的总字节数和向文件写入的次数
+long outBytes = 0;
+int outWrites = 0;
+
+OutBuffer openOutBuffer(char* name) {
+    FILE* fp = fopen(name, "w");
+    if (fp == NULL)
+        return NULL;
+    // 由缓冲区负责攒数据，文件本身不再缓冲
+    setvbuf(fp, NULL, _IONBF, 0);
+    OutBuffer out = (OutBuffer)malloc(sizeof(OutBuffer_));
+    out->fp = fp;
+    out->data = (char*)malloc(OUT_BUFFER_SIZE);
+    out->len = 0;
+    return out;
+}
+
+// 把缓冲区中的内容写入文件
+void outFlush(OutBuffer out) {
+    if (out->len == 0)
+        return;
+    fwrite(out->data, 1, out->len, out->fp);
+    outBytes += out->len;
+    outWrites++;
+    out->len = 0;
+}
+
+void closeOutBuffer(OutBuffer out) {
+    outFlush(out);
+    fclose(out->fp);
+    free(out->data);
+    free(out);
+}
+
+void outChar(OutBuffer out, char ch) {
+    if (out->len == OUT_BUFFER_SIZE)
+        outFlush(out);
+    out->data[out->len++] = ch;
+}
+
+void outStr(OutBuffer out, char* str) {
+    int len = strlen(str);
+    // 超过剩余空间时先写出，单个字符串比整个缓冲区还大时直接写入文件
+    if (out->len + len > OUT_BUFFER_SIZE) {
+        outFlush(out);
+        if (len > OUT_BUFFER_SIZE) {
+            fwrite(str, 1, len, out->fp);
+            outBytes += len;
+            outWrites++;
+            return;
+        }
+    }
+    memcpy(out->data + out->len, str, len);
+    out->len += len;
+}
+
+// 手动把整数转换为十进制，避免每次都经过sprintf
+void outInt(OutBuffer out, int val) {
+    char digits[12];
+    int n = 0;
+    // 用无符号数处理，INT_MIN取负也不会溢出
+    unsigned int u = val < 0 ? 0u - (unsigned int)val : (unsigned int)val;
+    do {
+        digits[n++] = '0' + u % 10;
+        u /= 10;
+    } while (u != 0);
+    if (out->len + n + 1 > OUT_BUFFER_SIZE)
+        outFlush(out);
+    if (val < 0)
+        out->data[out->len++] = '-';
+    while (n > 0)
+        out->data[out->len++] = digits[--n];
+}
+
+void outPrintf(OutBuffer out, char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    for (char* p = fmt; *p; p++) {
+        if (*p != '%') {
+            outChar(out, *p);
+            continue;
+        }
+        p++;
+        switch (*p) {
+            case 's': outStr(out, va_arg(args, char*)); break;
+            case 'd': outInt(out, va_arg(args, int)); break;
+            case 'c': outChar(out, (char)va_arg(args, int)); break;
+            case '%': outChar(out, '%'); break;
+            // 格式串在编译器内部写死，其他格式不会出现
+            default: p--; break;
+        }
+    }
+    va_end(args);
+}
+
+void printOutputStats(FILE* fp) {
+    fprintf(fp, "output: %ld bytes in %d writes\n", outBytes, outWrites);
+}
@@ -0,0 +1,31 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 输出缓冲区大小，缓冲区写满时才向文件写入一次
+#define OUT_BUFFER_SIZE (1 << 20)
+
+typedef struct OutBuffer_d OutBuffer_;
+typedef OutBuffer_* OutBuffer;
+
+// 输出缓冲区，格式化的结果先写入内存，写满或关闭时再整块写入文件
+struct OutBuffer_d {
+    FILE* fp;       // 目标文件
+    char* data;     // 缓冲区
+    int len;        // 缓冲区中已使用的字节数
+};
+
+OutBuffer openOutBuffer(char* name);
+void closeOutBuffer(OutBuffer out);
+void outFlush(OutBuffer out);
+void outChar(OutBuffer out, char ch);
+void outStr(OutBuffer out, char* str);
+void outInt(OutBuffer out, int val);
+// 只支持%s、%d、%c和%%，足够输出中间代码和目标代码
+void outPrintf(OutBuffer out, char* fmt, ...);
+void printOutputStats(FILE* fp);
+
+#endif
@@ -0,0 +1,520 @@
+#include "peephole.h"
+
+extern int labelNo;
+
+// 窥孔优化的统计信息
+static int forwardTotal = 0;
+static int storeTotal = 0;
+static int copyTotal = 0;
+static int retargetTotal = 0;
+static int deadTotal = 0;
+static int jumpTotal = 0;
+static int beforeTotal = 0;
+static int afterTotal = 0;
+
+// 寄存器集合用32位掩码表示，$zero不参与
+#define REG_BIT(r) (1u << (r))
+// 被调用者保存的寄存器$s0-$s7，函数返回时要保留它们的值
+#define SAVED_REGS 0x00ff0000u
+// 参数寄存器$a0-$a3
+#define ARG_REGS 0x000000f0u
+// 一个基本块内最多同时记住的内存值
+#define MEM_VALUE_NUM 16
+// 窥孔优化的最多轮数，一般两三轮就不再变化
+#define MAX_ROUNDS 4
+
+// 基本块：指令范围、块之间的关系和活跃寄存器
+typedef struct PBlock_d {
+    int start;
+    int end;
+    int succs[2];
+    int succNum;
+    unsigned int use;
+    unsigned int def;
+    unsigned int liveIn;
+    unsigned int liveOut;
+} PBlock;
+
+static PBlock* blocks = NULL;
+static int blockCap = 0;
+static int blockNum = 0;
+// 标记编号到所在块的映射
+static int* labelBlock = NULL;
+static int labelCap = 0;
+
+// 块内记住的值：r等于寄存器copyOf[r]加上copyOffset[r]，memBase/memOffset处的内存与memReg相等
+static int copyOf[32];
+static int copyOffset[32];
+static unsigned int copyDests = 0;      // copyOf有效的寄存器
+static unsigned int copySources = 0;    // 作为复制源出现过的寄存器
+static int memBase[MEM_VALUE_NUM];
+static int memOffset[MEM_VALUE_NUM];
+static int memReg[MEM_VALUE_NUM];
+static int memNum = 0;
+
+static int isBranch(int kind) {
+    return kind >= BEQ_MIPS && kind <= BLEZ_MIPS;
+}
+
+// 跳转、条件跳转和返回之后开始新的基本块
+static int endsBlock(int kind) {
+    return kind == J_MIPS || kind == JR_MIPS || isBranch(kind);
+}
+
+// 没有副作用的指令，写入的寄存器不再被使用时可以删除
+static int isPure(int kind) {
+    switch (kind) {
+        case LI_MIPS:
+        case MOVE_MIPS:
+        case ADD_MIPS:
+        case ADDU_MIPS:
+        case ADDI_MIPS:
+        case SLTI_MIPS:
+        case SUB_MIPS:
+        case SUBU_MIPS:
+        case MUL_MIPS:
+        case MFLO_MIPS:
+        case MFHI_MIPS:
+        case SLL_MIPS:
+        case SRA_MIPS:
+        case SRL_MIPS:
+        case LW_MIPS:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+* 指令读取和写入的寄存器。调用只记$v0和$ra为写入，漏记被调用函数改写的寄存器只会让活跃范围变大，是保守的；
+* 返回和尾调用读取返回值、栈指针以及被调用者保存的寄存器
+*/
+static void useDef(MipsCode code, unsigned int* use, unsigned int* def) {
+    unsigned int u = 0, d = 0;
+    switch (code->kind) {
+        case LI_MIPS:
+        case MFLO_MIPS:
+        case MFHI_MIPS:
+            d = REG_BIT(code->rd);
+            break;
+        case MOVE_MIPS:
+        case ADDI_MIPS:
+        case SLTI_MIPS:
+        case SLL_MIPS:
+        case SRA_MIPS:
+        case SRL_MIPS:
+        case LW_MIPS:
+            u = REG_BIT(code->rs);
+            d = REG_BIT(code->rd);
+            break;
+        case ADD_MIPS:
+        case ADDU_MIPS:
+        case SUB_MIPS:
+        case SUBU_MIPS:
+        case MUL_MIPS:
+            u = REG_BIT(code->rs) | REG_BIT(code->rt);
+            d = REG_BIT(code->rd);
+            break;
+        case MULT_MIPS:
+        case DIV_MIPS:
+        case SW_MIPS:
+        case BEQ_MIPS:
+        case BNE_MIPS:
+        case BGT_MIPS:
+        case BLT_MIPS:
+        case BGE_MIPS:
+        case BLE_MIPS:
+            u = REG_BIT(code->rs) | REG_BIT(code->rt);
+            break;
+        case BEQZ_MIPS:
+        case BNEZ_MIPS:
+        case BGTZ_MIPS:
+        case BLTZ_MIPS:
+        case BGEZ_MIPS:
+        case BLEZ_MIPS:
+            u = REG_BIT(code->rs);
+            break;
+        case J_MIPS:
+            if (code->name != NULL)
+                u = ARG_REGS | SAVED_REGS | REG_BIT(29) | REG_BIT(30) | REG_BIT(31);
+            break;
+        case JAL_MIPS:
+            u = ARG_REGS | REG_BIT(29);
+            d = REG_BIT(2) | REG_BIT(31);
+            break;
+        case JR_MIPS:
+            u = REG_BIT(code->rs) | REG_BIT(2) | SAVED_REGS | REG_BIT(29) | REG_BIT(30);
+            break;
+        default:
+            break;
+    }
+    *use = u & ~1u;
+    *def = d & ~1u;
+}
+
+// 忘记块内记住的所有值
+static void forgetAll() {
+    for (int r = 0; copyDests != 0; r++, copyDests >>= 1)
+        if (copyDests & 1u)
+            copyOf[r] = -1;
+    copySources = 0;
+    memNum = 0;
+}
+
+// 寄存器r被改写，与它有关的复制关系和内存值都失效
+static void forgetReg(int r) {
+    copyOf[r] = -1;
+    copyDests &= ~REG_BIT(r);
+    if (copySources & REG_BIT(r)) {
+        for (int x = 0; x < 32; x++)
+            if (copyOf[x] == r) {
+                copyOf[x] = -1;
+                copyDests &= ~REG_BIT(x);
+            }
+    }
+    int k = 0;
+    for (int m = 0; m < memNum; m++) {
+        if (memBase[m] == r || memReg[m] == r)
+            continue;
+        memBase[k] = memBase[m];
+        memOffset[k] = memOffset[m];
+        memReg[k] = memReg[m];
+        k++;
+    }
+    memNum = k;
+}
+
+static int findMem(int base, int offset) {
+    for (int m = 0; m < memNum; m++)
+        if (memBase[m] == base && memOffset[m] == offset)
+            return m;
+    return -1;
+}
+
+/*
+* 存入base+offset：同一基址不同偏移的字互不重叠，其余记住的内存值都可能被覆盖。
+* 不同基址的寄存器可能指向同一位置（比如指向栈上数组的指针），只能全部忘记
+*/
+static void storeMem(int base, int offset, int reg) {
+    int k = 0;
+    for (int m = 0; m < memNum; m++) {
+        if (memBase[m] != base || memOffset[m] == offset)
+            continue;
+        memBase[k] = memBase[m];
+        memOffset[k] = memOffset[m];
+        memReg[k] = memReg[m];
+        k++;
+    }
+    memNum = k;
+    if (memNum < MEM_VALUE_NUM) {
+        memBase[memNum] = base;
+        memOffset[memNum] = offset;
+        memReg[memNum] = reg;
+        memNum++;
+    }
+}
+
+// 把读取的寄存器换成与之相等的复制源
+static void propagate(int* reg) {
+    if ((copyDests & REG_BIT(*reg)) && copyOffset[*reg] == 0) {
+        *reg = copyOf[*reg];
+        copyTotal++;
+    }
+}
+
+// 基址寄存器或addi的源等于另一个寄存器加常量时，直接使用那个寄存器，常量并入偏移
+static void propagateOffset(int* reg, int* imm) {
+    if ((copyDests & REG_BIT(*reg)) && FITS_IMM((long long)*imm + copyOffset[*reg])) {
+        *imm += copyOffset[*reg];
+        *reg = copyOf[*reg];
+        copyTotal++;
+    }
+}
+
+/*
+* 顺序扫描每个基本块：加零和装载0改写为move，读取的寄存器换成复制源以消除move链，
+* addi算出的地址并入访存的偏移，lw从块内前面存入或读出同一位置的寄存器直接取值，存回相同值的sw删除
+*/
+static int forwardPass() {
+    int changed = copyTotal + forwardTotal + storeTotal + deadTotal;
+    for (int r = 0; r < 32; r++)
+        copyOf[r] = -1;
+    copyDests = 0;
+    forgetAll();
+    for (int i = 0; i < mipsCodeNum; i++) {
+        MipsCode code = &mipsCodes[i];
+        switch (code->kind) {
+            case LABEL_MIPS:
+            case FUNC_MIPS:
+                forgetAll();
+                continue;
+            case LI_MIPS:
+                if (code->imm == 0) {
+                    code->kind = MOVE_MIPS;
+                    code->rs = 0;
+                }
+                break;
+            case ADD_MIPS:
+                if (code->rt == 0 || code->rs == 0) {
+                    code->rs = code->rs == 0 ? code->rt : code->rs;
+                    code->kind = MOVE_MIPS;
+                }
+                break;
+            case ADDI_MIPS:
+                if (code->imm == 0)
+                    code->kind = MOVE_MIPS;
+                break;
+            default:
+                break;
+        }
+        switch (code->kind) {
+            case ADDI_MIPS:
+            case LW_MIPS:
+                propagateOffset(&code->rs, &code->imm);
+                break;
+            case MOVE_MIPS:
+            case SLTI_MIPS:
+            case SLL_MIPS:
+            case SRA_MIPS:
+            case SRL_MIPS:
+            case JR_MIPS:
+            case BEQZ_MIPS:
+            case BNEZ_MIPS:
+            case BGTZ_MIPS:
+            case BLTZ_MIPS:
+            case BGEZ_MIPS:
+            case BLEZ_MIPS:
+                propagate(&code->rs);
+                break;
+            case SW_MIPS:
+                propagateOffset(&code->rs, &code->imm);
+                propagate(&code->rt);
+                break;
+            case ADD_MIPS:
+            case ADDU_MIPS:
+            case SUB_MIPS:
+            case SUBU_MIPS:
+            case MUL_MIPS:
+            case MULT_MIPS:
+            case DIV_MIPS:
+            case BEQ_MIPS:
+            case BNE_MIPS:
+            case BGT_MIPS:
+            case BLT_MIPS:
+            case BGE_MIPS:
+            case BLE_MIPS:
+                propagate(&code->rs);
+                propagate(&code->rt);
+                break;
+            default:
+                break;
+        }
+        if (code->kind == LW_MIPS) {
+            int m = findMem(code->rs, code->imm);
+            if (m >= 0) {
+                forwardTotal++;
+                code->kind = MOVE_MIPS;
+                code->rs = memReg[m];
+            }
+        }
+        if (code->kind == MOVE_MIPS && code->rd == code->rs) {
+            code->kind = NOP_MIPS;
+            deadTotal++;
+            continue;
+        }
+        if (code->kind == SW_MIPS) {
+            int m = findMem(code->rs, code->imm);
+            if (m >= 0 && memReg[m] == code->rt) {
+                code->kind = NOP_MIPS;
+                storeTotal++;
+                continue;
+            }
+            storeMem(code->rs, code->imm, code->rt);
+            continue;
+        }
+        if (code->kind == JAL_MIPS || endsBlock(code->kind)) {
+            forgetAll();
+            continue;
+        }
+        unsigned int use, def;
+        useDef(code, &use, &def);
+        for (int r = 1; r < 32; r++)
+            if (def & REG_BIT(r))
+                forgetReg(r);
+        // 只记录通用寄存器之间的复制，$sp、$fp和$ra保持原样，函数的入口和出口代码不受影响
+        if ((code->kind == MOVE_MIPS || code->kind == ADDI_MIPS) && code->rd >= 2 && code->rd <= 25 && code->rd != code->rs) {
+            copyOf[code->rd] = code->rs;
+            copyOffset[code->rd] = code->kind == ADDI_MIPS ? code->imm : 0;
+            copyDests |= REG_BIT(code->rd);
+            copySources |= REG_BIT(code->rs);
+        }
+        else if (code->kind == LW_MIPS && code->rd != code->rs && memNum < MEM_VALUE_NUM) {
+            memBase[memNum] = code->rs;
+            memOffset[memNum] = code->imm;
+            memReg[memNum] = code->rd;
+            memNum++;
+        }
+    }
+    return copyTotal + forwardTotal + storeTotal + deadTotal != changed;
+}
+
+// 划分基本块并求出每个块出口处活跃的寄存器
+static void computeLiveness() {
+    if (blockCap < mipsCodeNum) {
+        blockCap = mipsCodeNum;
+        blocks = (PBlock*)realloc(blocks, sizeof(PBlock) * blockCap);
+    }
+    if (labelCap < labelNo) {
+        labelCap = labelCap * 2 > labelNo ? labelCap * 2 : labelNo;
+        labelBlock = (int*)realloc(labelBlock, sizeof(int) * labelCap);
+    }
+    blockNum = 0;
+    for (int i = 0; i < mipsCodeNum; i++) {
+        int kind = mipsCodes[i].kind;
+        if (i == 0 || (kind == LABEL_MIPS && mipsCodes[i-1].kind != LABEL_MIPS) || endsBlock(mipsCodes[i-1].kind)) {
+            if (blockNum > 0)
+                blocks[blockNum-1].end = i;
+            blocks[blockNum].start = i;
+            blockNum++;
+        }
+        if (kind == LABEL_MIPS)
+            labelBlock[mipsCodes[i].label] = blockNum - 1;
+    }
+    blocks[blockNum-1].end = mipsCodeNum;
+    for (int b = 0; b < blockNum; b++) {
+        PBlock* block = &blocks[b];
+        MipsCode last = &mipsCodes[block->end-1];
+        block->succNum = 0;
+        if ((last->kind == J_MIPS && last->name == NULL) || isBranch(last->kind))
+            block->succs[block->succNum++] = labelBlock[last->label];
+        if (last->kind != J_MIPS && last->kind != JR_MIPS && b + 1 < blockNum)
+            block->succs[block->succNum++] = b + 1;
+        block->use = 0;
+        block->def = 0;
+        for (int i = block->end - 1; i >= block->start; i--) {
+            unsigned int use, def;
+            useDef(&mipsCodes[i], &use, &def);
+            block->use = (block->use & ~def) | use;
+            block->def |= def;
+        }
+        block->liveIn = block->use;
+        block->liveOut = 0;
+    }
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int b = blockNum - 1; b >= 0; b--) {
+            PBlock* block = &blocks[b];
+            unsigned int out = 0;
+            for (int k = 0; k < block->succNum; k++)
+                out |= blocks[block->succs[k]].liveIn;
+            unsigned int in = block->use | (out & ~block->def);
+            if (out != block->liveOut || in != block->liveIn) {
+                block->liveOut = out;
+                block->liveIn = in;
+                changed = 1;
+            }
+        }
+    }
+}
+
+/*
+* 逆序扫描每个基本块：写入的寄存器之后不再使用的无副作用指令删除；
+* 紧跟move d, t且t之后不再使用时，前一条指令直接写入d，删去这条move
+*/
+static int backwardPass() {
+    int changed = retargetTotal + deadTotal;
+    computeLiveness();
+    for (int b = 0; b < blockNum; b++) {
+        unsigned int live = blocks[b].liveOut;
+        for (int i = blocks[b].end - 1; i >= blocks[b].start; i--) {
+            MipsCode code = &mipsCodes[i];
+            if (isPure(code->kind) && !(live & REG_BIT(code->rd))) {
+                code->kind = NOP_MIPS;
+                deadTotal++;
+                continue;
+            }
+            if (code->kind == MOVE_MIPS && code->rd != code->rs && !(live & REG_BIT(code->rs)) && code->rs != 0) {
+                int j = i - 1;
+                while (j >= blocks[b].start && mipsCodes[j].kind == NOP_MIPS)
+                    j--;
+                if (j >= blocks[b].start && isPure(mipsCodes[j].kind) && mipsCodes[j].rd == code->rs) {
+                    mipsCodes[j].rd = code->rd;
+                    code->kind = NOP_MIPS;
+                    retargetTotal++;
+                    continue;
+                }
+            }
+            unsigned int use, def;
+            useDef(code, &use, &def);
+            live = (live & ~def) | use;
+        }
+    }
+    return retargetTotal + deadTotal != changed;
+}
+
+// 删除跳到紧接着的标记的跳转，条件跳转两个方向都到同一处，也可以删除
+static int removeJumps() {
+    int changed = 0;
+    for (int i = 0; i < mipsCodeNum; i++) {
+        MipsCode code = &mipsCodes[i];
+        if (!(code->kind == J_MIPS && code->name == NULL) && !isBranch(code->kind))
+            continue;
+        for (int k = i + 1; k < mipsCodeNum; k++) {
+            int kind = mipsCodes[k].kind;
+            if (kind == LABEL_MIPS && mipsCodes[k].label == code->label) {
+                code->kind = NOP_MIPS;
+                jumpTotal++;
+                changed = 1;
+                break;
+            }
+            if (kind != LABEL_MIPS && kind != NOP_MIPS)
+                break;
+        }
+    }
+    return changed;
+}
+
+// 去掉已删除的指令
+static void compactMipsCodes() {
+    int num = 0;
+    for (int i = 0; i < mipsCodeNum; i++)
+        if (mipsCodes[i].kind != NOP_MIPS)
+            mipsCodes[num++] = mipsCodes[i];
+    mipsCodeNum = num;
+}
+
+static int countInstrs() {
+    int num = 0;
+    for (int i = 0; i < mipsCodeNum; i++)
+        if (mipsCodes[i].kind != LABEL_MIPS && mipsCodes[i].kind != FUNC_MIPS)
+            num++;
+    return num;
+}
+
+/*
+* 对当前函数的目标代码做窥孔优化，多种模式反复应用直到不再变化：
+* 存入后立即读出的值直接转发，move链改为使用最初的来源，无用的move和运算删除，跳到下一条的跳转删除
+*/
+void optimizeMipsCodes() {
+    if (mipsCodeNum == 0)
+        return;
+    beforeTotal += countInstrs();
+    for (int round = 0; round < MAX_ROUNDS; round++) {
+        int changed = forwardPass();
+        changed |= backwardPass();
+        changed |= removeJumps();
+        compactMipsCodes();
+        if (!changed)
+            break;
+    }
+    afterTotal += countInstrs();
+}
+
+// 打印窥孔优化的统计信息
+void printPeepholeStats(FILE* fp) {
+    fprintf(fp, "peephole: %d loads forwarded, %d stores removed, %d operands copy-propagated, %d moves folded\n",
+        forwardTotal, storeTotal, copyTotal, retargetTotal);
+    fprintf(fp, "peephole: %d dead instructions removed, %d jumps removed, %d -> %d instructions\n",
+        deadTotal, jumpTotal, beforeTotal, afterTotal);
+}
\ No newline at end of file
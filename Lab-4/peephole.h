@@ -0,0 +1,9 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include "objectcode.h"
+
+void optimizeMipsCodes();
+void printPeepholeStats(FILE* fp);
+
+#endif
\ No newline at end of file
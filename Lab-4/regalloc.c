@@ -0,0 +1,335 @@
+#include "regalloc.h"
+
+// 可分配的寄存器：$t0-$t7（8-15）由调用者保存，$s0-$s7（16-23）由被调用者保存
+#define CALLER_SAVED_MASK 0x0000ff00u
+#define CALLEE_SAVED_MASK 0x00ff0000u
+
+// 寄存器分配的统计信息
+static int funcNum = 0;
+static int varTotal = 0;
+static int regVarNum = 0;
+static int spillVarNum = 0;
+static int memVarNum = 0;
+static int globalVarTotal = 0;
+static int leafNum = 0;
+static int calleeSaveNum = 0;
+static int callerSaveNum = 0;
+
+// 活跃区间，位置按指令编号的两倍计算：使用在2p，定值在2p+1，
+// 这样一条指令中最后一次使用的变量和被定值的变量可以共用同一个寄存器
+typedef struct Interval_d {
+    int start;
+    int end;
+    int weight;     // 溢出代价：每次定值和使用按所在循环的嵌套深度加权
+    VarDes var;
+} Interval;
+
+// 循环中的一次访问按每层8倍计入溢出代价，深度超过4层时不再增加
+static int depthWeight(int depth) {
+    return 1 << (3 * (depth < 4 ? depth : 4));
+}
+
+// 指令的第0个操作数是否是被定值的变量
+static int isDef(InterCode code) {
+    Operand op = code->ops[0];
+    if (op == NULL || (op->kind != VARIABLE_OP && op->kind != TEMP_VAR_OP))
+        return 0;
+    switch (code->kind) {
+        case ASSIGN_IR:
+        case PLUS_IR:
+        case SUB_IR:
+        case MUL_IR:
+        case DIV_IR:
+        case PARAM_IR:
+        case CALL_IR:
+        case READ_IR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int compareInterval(const void* a, const void* b) {
+    const Interval* x = (const Interval*)a;
+    const Interval* y = (const Interval*)b;
+    if (x->start != y->start)
+        return x->start < y->start ? -1 : 1;
+    return x->var->no - y->var->no;
+}
+
+// 取mask中编号最小的寄存器
+static int lowestReg(unsigned int mask) {
+    int r = 0;
+    while (!(mask & (1u << r)))
+        r++;
+    return r;
+}
+
+// 区间是否跨过某个调用点，calls是按顺序排列的CALL指令下标（相对函数开头）
+static int crossesCall(Interval* interval, int* calls, int callNum) {
+    int lo = 0, hi = callNum;
+    // 找到第一个位置不早于区间起点的调用
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (2 * calls[mid] < interval->start)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < callNum && 2 * calls[lo] + 1 < interval->end;
+}
+
+static void extend(Interval* interval, int pos) {
+    if (pos < interval->start)
+        interval->start = pos;
+    if (pos > interval->end)
+        interval->end = pos;
+}
+
+/*
+* 基于活跃变量分析的线性扫描寄存器分配
+* 只有在某个基本块中先使用后定值（向上暴露）的变量才可能跨基本块活跃，活跃分析的位向量只为这些变量分配，
+* 其余变量（绝大多数临时变量）的活跃范围局限在单个基本块内，直接由定值和使用的位置得到
+* 跨过调用的区间优先使用被调用者保存的寄存器（每个函数只需保存一次），其余优先使用调用者保存的寄存器，
+* 最后为每个调用点记录需要由调用者保存的寄存器
+*/
+void allocateRegisters(CFG cfg, FrameDes frame, VarDes* opVars, unsigned int* callSaves) {
+    int varNum = frame->varNum;
+    VarDes* vars = (VarDes*)malloc(sizeof(VarDes) * (varNum > 0 ? varNum : 1));
+    for (VarDes var = frame->vars; var != NULL; var = var->next)
+        vars[var->no] = var;
+    // 找出跨基本块活跃的变量并为它们编号
+    int* globalNo = (int*)malloc(sizeof(int) * (varNum > 0 ? varNum : 1));
+    int* defBlock = (int*)malloc(sizeof(int) * (varNum > 0 ? varNum : 1));
+    for (int v = 0; v < varNum; v++) {
+        globalNo[v] = -1;
+        defBlock[v] = -1;
+    }
+    int globalNum = 0;
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        for (int i = block->start; i < block->end; i++) {
+            VarDes* ov = opVars + 3 * (i - cfg->start);
+            int def = isDef(&interCodes[i]);
+            for (int k = def; k < 3; k++)
+                if (ov[k] != NULL && !ov[k]->memory && defBlock[ov[k]->no] != b && globalNo[ov[k]->no] == -1)
+                    globalNo[ov[k]->no] = globalNum++;
+            if (def)
+                defBlock[ov[0]->no] = b;
+        }
+    }
+    // 每个基本块的use/def/in/out位向量
+    int words = (globalNum + 31) / 32;
+    if (words == 0)
+        words = 1;
+    unsigned int* sets = (unsigned int*)calloc((size_t)cfg->blockNum * words * 4, sizeof(unsigned int));
+    unsigned int* useSet = sets;
+    unsigned int* defSet = sets + (size_t)cfg->blockNum * words;
+    unsigned int* inSet = sets + (size_t)cfg->blockNum * words * 2;
+    unsigned int* outSet = sets + (size_t)cfg->blockNum * words * 3;
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        unsigned int* use = useSet + (size_t)b * words;
+        unsigned int* def = defSet + (size_t)b * words;
+        for (int i = block->start; i < block->end; i++) {
+            VarDes* ov = opVars + 3 * (i - cfg->start);
+            int isd = isDef(&interCodes[i]);
+            for (int k = isd; k < 3; k++) {
+                if (ov[k] == NULL || globalNo[ov[k]->no] < 0)
+                    continue;
+                int g = globalNo[ov[k]->no];
+                if (!(def[g / 32] & (1u << (g % 32))))
+                    use[g / 32] |= 1u << (g % 32);
+            }
+            if (isd && globalNo[ov[0]->no] >= 0) {
+                int g = globalNo[ov[0]->no];
+                def[g / 32] |= 1u << (g % 32);
+            }
+        }
+    }
+    // 逆序迭代求解活跃变量数据流方程直到不动点
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int b = cfg->blockNum - 1; b >= 0; b--) {
+            Block block = &cfg->blocks[b];
+            unsigned int* out = outSet + (size_t)b * words;
+            unsigned int* in = inSet + (size_t)b * words;
+            unsigned int* use = useSet + (size_t)b * words;
+            unsigned int* def = defSet + (size_t)b * words;
+            for (int w = 0; w < words; w++) {
+                unsigned int o = 0;
+                for (int s = 0; s < block->succNum; s++)
+                    o |= inSet[(size_t)block->succs[s]->no * words + w];
+                unsigned int n = use[w] | (o & ~def[w]);
+                out[w] = o;
+                if (n != in[w]) {
+                    in[w] = n;
+                    changed = 1;
+                }
+            }
+        }
+    }
+    // 由定值、使用的位置和基本块边界处的活跃信息得到每个变量的活跃区间
+    Interval* intervals = (Interval*)malloc(sizeof(Interval) * (varNum > 0 ? varNum : 1));
+    for (int v = 0; v < varNum; v++) {
+        intervals[v].start = 1 << 30;
+        intervals[v].end = -1;
+        intervals[v].weight = 0;
+        intervals[v].var = vars[v];
+    }
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        int weight = depthWeight(block->loopDepth);
+        for (int i = block->start; i < block->end; i++) {
+            VarDes* ov = opVars + 3 * (i - cfg->start);
+            int pos = 2 * (i - cfg->start);
+            int isd = isDef(&interCodes[i]);
+            for (int k = isd; k < 3; k++)
+                if (ov[k] != NULL) {
+                    extend(&intervals[ov[k]->no], pos);
+                    intervals[ov[k]->no].weight += weight;
+                }
+            if (isd) {
+                extend(&intervals[ov[0]->no], pos + 1);
+                intervals[ov[0]->no].weight += weight;
+            }
+        }
+    }
+    int* globalVar = (int*)malloc(sizeof(int) * (globalNum > 0 ? globalNum : 1));
+    for (int v = 0; v < varNum; v++)
+        if (globalNo[v] >= 0)
+            globalVar[globalNo[v]] = v;
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        unsigned int* in = inSet + (size_t)b * words;
+        unsigned int* out = outSet + (size_t)b * words;
+        for (int g = 0; g < globalNum; g++) {
+            if (in[g / 32] & (1u << (g % 32)))
+                extend(&intervals[globalVar[g]], 2 * (block->start - cfg->start));
+            if (out[g / 32] & (1u << (g % 32)))
+                extend(&intervals[globalVar[g]], 2 * (block->end - 1 - cfg->start) + 1);
+        }
+    }
+    // 按起点排序，只有不需要放在内存中的变量参与分配
+    int intervalNum = 0;
+    for (int v = 0; v < varNum; v++) {
+        vars[v]->regNo = -1;
+        if (vars[v]->memory)
+            memVarNum++;
+        else if (intervals[v].end >= 0)
+            intervals[intervalNum++] = intervals[v];
+    }
+    qsort(intervals, intervalNum, sizeof(Interval), compareInterval);
+    // 函数中的调用点，read和write只使用$v0和$a0，不影响其他寄存器
+    int* calls = (int*)malloc(sizeof(int) * (cfg->end - cfg->start));
+    int callNum = 0;
+    for (int i = cfg->start; i < cfg->end; i++)
+        if (interCodes[i].kind == CALL_IR)
+            calls[callNum++] = i - cfg->start;
+    // 线性扫描：active按终点升序保存当前占用寄存器的区间
+    Interval* active[ALLOC_REG_NUM];
+    int activeNum = 0;
+    unsigned int freeMask = CALLER_SAVED_MASK | CALLEE_SAVED_MASK;
+    for (int n = 0; n < intervalNum; n++) {
+        Interval* curr = &intervals[n];
+        // 释放已经结束的区间占用的寄存器
+        int keep = 0;
+        for (int a = 0; a < activeNum; a++) {
+            if (active[a]->end < curr->start)
+                freeMask |= 1u << active[a]->var->regNo;
+            else
+                active[keep++] = active[a];
+        }
+        activeNum = keep;
+        Interval* victim = curr;
+        if (freeMask != 0) {
+            unsigned int prefer = crossesCall(curr, calls, callNum) ? CALLEE_SAVED_MASK : CALLER_SAVED_MASK;
+            int reg = lowestReg((freeMask & prefer) != 0 ? (freeMask & prefer) : freeMask);
+            freeMask &= ~(1u << reg);
+            curr->var->regNo = reg;
+        }
+        // 没有空闲寄存器时溢出代价最小的区间，代价相同时溢出终点最远的
+        else {
+            int index = -1;
+            for (int a = 0; a < activeNum; a++)
+                if (active[a]->weight < victim->weight ||
+                    (active[a]->weight == victim->weight && active[a]->end > victim->end)) {
+                    victim = active[a];
+                    index = a;
+                }
+            if (victim != curr) {
+                for (int a = index; a < activeNum - 1; a++)
+                    active[a] = active[a+1];
+                activeNum--;
+                curr->var->regNo = victim->var->regNo;
+                victim->var->regNo = -1;
+            }
+        }
+        if (curr->var->regNo < 0) {
+            spillVarNum++;
+            continue;
+        }
+        // 被换下的区间溢出，寄存器中的变量数不变
+        if (victim != curr)
+            spillVarNum++;
+        else
+            regVarNum++;
+        // 插入active并保持按终点有序
+        int a = activeNum++;
+        while (a > 0 && active[a-1]->end > curr->end) {
+            active[a] = active[a-1];
+            a--;
+        }
+        active[a] = curr;
+    }
+    // 用到的被调用者保存寄存器，main函数不需要为调用者保存寄存器
+    frame->calleeSaved = 0;
+    for (int n = 0; n < intervalNum && strcmp(frame->name, "main") != 0; n++)
+        if (intervals[n].var->regNo >= 0)
+            frame->calleeSaved |= (1u << intervals[n].var->regNo) & CALLEE_SAVED_MASK;
+    // 按顺序扫描调用点，holder[r]是起点不晚于调用的区间中最后一个分配到r的，
+    // 同一寄存器上的区间互不重叠，所以只有它可能在调用之后仍然活跃
+    Interval* holder[32] = { NULL };
+    frame->callerSaved = 0;
+    int next = 0;
+    for (int c = 0; c < callNum; c++) {
+        int pos = 2 * calls[c];
+        while (next < intervalNum && intervals[next].start <= pos) {
+            int reg = intervals[next].var->regNo;
+            if (reg >= 0 && ((1u << reg) & CALLER_SAVED_MASK))
+                holder[reg] = &intervals[next];
+            next++;
+        }
+        unsigned int mask = 0;
+        for (int r = 8; r < 16; r++)
+            if (holder[r] != NULL && holder[r]->var->regNo == r && holder[r]->end > pos + 1) {
+                mask |= 1u << r;
+                callerSaveNum++;
+            }
+        callSaves[calls[c]] = mask;
+        frame->callerSaved |= mask;
+    }
+    if (frame->leaf)
+        leafNum++;
+    for (int r = 16; r < 24; r++)
+        if (frame->calleeSaved & (1u << r))
+            calleeSaveNum++;
+    funcNum++;
+    varTotal += varNum;
+    globalVarTotal += globalNum;
+    free(vars);
+    free(globalNo);
+    free(defBlock);
+    free(sets);
+    free(intervals);
+    free(globalVar);
+    free(calls);
+}
+
+// 打印寄存器分配的统计信息
+void printRegAllocStats(FILE* fp) {
+    fprintf(fp, "regalloc: %d functions, %d variables (%d live across blocks)\n", funcNum, varTotal, globalVarTotal);
+    fprintf(fp, "regalloc: %d in registers, %d spilled, %d kept in memory\n", regVarNum, spillVarNum, memVarNum);
+    fprintf(fp, "regalloc: %d leaf functions, %d callee-saved registers, %d caller saves at call sites\n", leafNum, calleeSaveNum, callerSaveNum);
+}
\ No newline at end of file
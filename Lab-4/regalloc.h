@@ -0,0 +1,16 @@
+#ifndef REGALLOC_H
+#define REGALLOC_H
+
+#include "objectcode.h"
+#include "cfg.h"
+
+// 参与分配的寄存器数：$t0-$t7和$s0-$s7
+#define ALLOC_REG_NUM 16
+// $t8和$t9不参与分配，留给溢出到栈上的变量、常量和地址运算临时使用
+#define SCRATCH_REG1 24
+#define SCRATCH_REG2 25
+
+void allocateRegisters(CFG cfg, FrameDes frame, VarDes* opVars, unsigned int* callSaves);
+void printRegAllocStats(FILE* fp);
+
+#endif
@@ -0,0 +1,394 @@
+#include <limits.h>
+#include "sccp.h"
+
+extern int tmpVarNo;
+
+// 常量传播的格：还没有求出值、常量、不是常量，只会从前往后下降
+enum { LATTICE_TOP, LATTICE_CONST, LATTICE_BOTTOM };
+
+static CFG cfg = NULL;
+static int valueCount = 0;
+static char* state = NULL;
+static int* constVal = NULL;
+static char* pinned = NULL;     // 值被解引用或取地址，使用处不能换成常量，定值也不能删除
+static int* blockOf = NULL;
+// 每个值的使用者（包括PHI指令），按值编号分段存放指令下标
+static int* useStart = NULL;
+static int* useList = NULL;
+// 可执行的基本块和控制流边，边按它在cfg->preds中的位置编号
+static char* blockExec = NULL;
+static char* edgeExec = NULL;
+static Block* edgeTarget = NULL;
+static int* flowWork = NULL;
+static int flowTop = 0;
+static int* ssaWork = NULL;
+static int ssaTop = 0;
+
+// 常量传播的统计信息
+static int constTotal = 0;
+static int replaceTotal = 0;
+static int foldTotal = 0;
+static int removeTotal = 0;
+
+// 基本块block的第k条出边的编号
+static int edgeId(Block block, int k) {
+    Block succ = block->succs[k];
+    return (int)(succ->preds - cfg->preds) + block->predIndex[k];
+}
+
+static void markEdge(Block block, int k) {
+    int e = edgeId(block, k);
+    if (!edgeExec[e]) {
+        edgeExec[e] = 1;
+        flowWork[flowTop++] = e;
+    }
+}
+
+// 操作数的格值，常量时通过value返回
+static int evalOp(Operand op, int* value) {
+    if (op->kind == CONSTANT_OP) {
+        *value = op->value;
+        return LATTICE_CONST;
+    }
+    int v = valueNo(op);
+    if (v < 0 || v >= valueCount)
+        return LATTICE_BOTTOM;
+    *value = constVal[v];
+    return state[v];
+}
+
+// 降低值v的格值，改变时把v加入SSA工作表
+static void lower(int v, int s, int value) {
+    if (s < state[v] || (s == state[v] && (s != LATTICE_CONST || constVal[v] == value)))
+        return;
+    // 同一个值先后求出两个不同的常量，只能是不确定
+    if (s == LATTICE_CONST && state[v] == LATTICE_CONST)
+        s = LATTICE_BOTTOM;
+    state[v] = s;
+    constVal[v] = value;
+    ssaWork[ssaTop++] = v;
+}
+
+// 按32位补码折叠运算，除数为0和溢出的除法留到运行时
+static int foldArith(int kind, int a, int b, int* result) {
+    unsigned int x = (unsigned int)a, y = (unsigned int)b;
+    switch (kind) {
+        case PLUS_IR:
+            *result = (int)(x + y);
+            return 1;
+        case SUB_IR:
+            *result = (int)(x - y);
+            return 1;
+        case MUL_IR:
+            *result = (int)(x * y);
+            return 1;
+        case DIV_IR:
+            if (b == 0 || (a == INT_MIN && b == -1))
+                return 0;
+            *result = a / b;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int evalRelop(char* relop, int a, int b) {
+    if (strcmp(relop, "==") == 0)
+        return a == b;
+    if (strcmp(relop, "!=") == 0)
+        return a != b;
+    if (strcmp(relop, ">") == 0)
+        return a > b;
+    if (strcmp(relop, "<") == 0)
+        return a < b;
+    if (strcmp(relop, ">=") == 0)
+        return a >= b;
+    return a <= b;
+}
+
+// PHI的值是可执行入边上各参数的交汇，未定义的参数不参与
+static void visitPhi(int i) {
+    InterCode code = &interCodes[i];
+    Block block = &cfg->blocks[blockOf[i]];
+    int base = (int)(block->preds - cfg->preds);
+    int s = LATTICE_TOP, value = 0;
+    for (int j = 0; j < code->argNum; j++) {
+        if (!edgeExec[base + j] || code->args[j] == NULL)
+            continue;
+        int a;
+        int sa = evalOp(code->args[j], &a);
+        if (sa == LATTICE_TOP)
+            continue;
+        if (sa == LATTICE_BOTTOM || (s == LATTICE_CONST && a != value)) {
+            s = LATTICE_BOTTOM;
+            break;
+        }
+        s = LATTICE_CONST;
+        value = a;
+    }
+    lower(valueNo(code->ops[0]), s, value);
+}
+
+// 条件跳转：两个操作数都是常量时只有一条出边可执行
+static void visitBranch(int i) {
+    InterCode code = &interCodes[i];
+    Block block = &cfg->blocks[blockOf[i]];
+    if (block->succNum < 2)
+        return;
+    int a, b;
+    int sa = evalOp(code->ops[0], &a);
+    int sb = evalOp(code->ops[1], &b);
+    if (sa == LATTICE_BOTTOM || sb == LATTICE_BOTTOM) {
+        markEdge(block, 0);
+        markEdge(block, 1);
+    }
+    else if (sa == LATTICE_CONST && sb == LATTICE_CONST)
+        markEdge(block, evalRelop(code->relop, a, b) ? 0 : 1);
+}
+
+static void visitCode(int i) {
+    InterCode code = &interCodes[i];
+    if (code->kind == PHI_IR) {
+        visitPhi(i);
+        return;
+    }
+    if (code->kind == IF_GOTO_IR) {
+        visitBranch(i);
+        return;
+    }
+    int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+    if (v < 0)
+        return;
+    int s, value = 0;
+    switch (code->kind) {
+        case ASSIGN_IR:
+            s = evalOp(code->ops[1], &value);
+            break;
+        case PLUS_IR:
+        case SUB_IR:
+        case MUL_IR:
+        case DIV_IR: {
+            int a, b;
+            int sa = evalOp(code->ops[1], &a);
+            int sb = evalOp(code->ops[2], &b);
+            // 乘数有一个是0时结果一定是0
+            if (code->kind == MUL_IR && ((sa == LATTICE_CONST && a == 0) || (sb == LATTICE_CONST && b == 0)))
+                s = LATTICE_CONST;
+            else if (sa == LATTICE_BOTTOM || sb == LATTICE_BOTTOM)
+                s = LATTICE_BOTTOM;
+            else if (sa == LATTICE_TOP || sb == LATTICE_TOP)
+                s = LATTICE_TOP;
+            else
+                s = foldArith(code->kind, a, b, &value) ? LATTICE_CONST : LATTICE_BOTTOM;
+            break;
+        }
+        // 参数、函数返回值和读入的值都不是常量
+        default:
+            s = LATTICE_BOTTOM;
+            break;
+    }
+    lower(v, s, value);
+}
+
+// 基本块第一次变为可执行：求值其中的全部指令，除了条件跳转以外的出边都可执行
+static void visitBlock(Block block) {
+    for (int i = block->start; i < block->end; i++)
+        visitCode(i);
+    InterCode last = &interCodes[block->end - 1];
+    if (last->kind != IF_GOTO_IR || block->succNum < 2)
+        for (int k = 0; k < block->succNum; k++)
+            markEdge(block, k);
+}
+
+// 建立每个值的使用者列表，同时找出被解引用或取地址使用的值
+static void collectUses() {
+    useStart = (int*)calloc(valueCount + 1, sizeof(int));
+    useList = NULL;
+    int* useFill = NULL;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < interCodeNum; i++) {
+            InterCode code = &interCodes[i];
+            int num = code->kind == PHI_IR ? code->argNum : 3;
+            for (int k = code->kind == PHI_IR ? 0 : definesOp(code); k < num; k++) {
+                Operand op = code->kind == PHI_IR ? code->args[k] : code->ops[k];
+                if (op == NULL)
+                    continue;
+                int wrapped = op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP;
+                int v = valueNo(wrapped ? op->opr : op);
+                if (v < 0 || v >= valueCount)
+                    continue;
+                if (pass == 0) {
+                    useStart[v+1]++;
+                    if (wrapped)
+                        pinned[v] = 1;
+                }
+                else
+                    useList[useFill[v]++] = i;
+            }
+        }
+        if (pass == 0) {
+            for (int v = 0; v < valueCount; v++)
+                useStart[v+1] += useStart[v];
+            useList = (int*)malloc(sizeof(int) * (useStart[valueCount] > 0 ? useStart[valueCount] : 1));
+            useFill = (int*)malloc(sizeof(int) * (valueCount + 1));
+            for (int v = 0; v < valueCount; v++)
+                useFill[v] = useStart[v];
+        }
+    }
+    free(useFill);
+}
+
+// 值是常量时换成常量操作数，同一个值的所有使用共享一个常量操作数
+static Operand constOf(Operand op, Operand* constOps) {
+    int v = valueNo(op);
+    if (v < 0 || v >= valueCount || state[v] != LATTICE_CONST || pinned[v])
+        return op;
+    if (constOps[v] == NULL)
+        constOps[v] = getValue(constVal[v]);
+    replaceTotal++;
+    return constOps[v];
+}
+
+// 按分析结果改写：删除常量的定值和不可执行的基本块，常量替换使用处，折叠条件跳转，返回改动的次数
+static int rewriteCodes() {
+    int changes = constTotal + replaceTotal + foldTotal + removeTotal;
+    Operand* constOps = (Operand*)calloc(valueCount, sizeof(Operand));
+    beginRewrite(interCodeNum);
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        if (!blockExec[b]) {
+            removeTotal += block->end - block->start;
+            continue;
+        }
+        int base = (int)(block->preds - cfg->preds);
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+            if (v >= 0 && v < valueCount && state[v] == LATTICE_CONST && !pinned[v]) {
+                switch (code->kind) {
+                    case ASSIGN_IR:
+                    case PLUS_IR:
+                    case SUB_IR:
+                    case MUL_IR:
+                    case DIV_IR:
+                    case PHI_IR:
+                        constTotal++;
+                        continue;
+                    default:
+                        break;
+                }
+            }
+            if (code->kind == PHI_IR) {
+                // 只保留可执行入边上的参数，顺序和删除不可执行块后的前驱一致
+                int num = 0;
+                for (int j = 0; j < code->argNum; j++)
+                    if (edgeExec[base + j])
+                        code->args[num++] = code->args[j] != NULL ? constOf(code->args[j], constOps) : NULL;
+                code->argNum = num;
+                emitInterCode(code);
+                continue;
+            }
+            if (code->kind == IF_GOTO_IR && block->succNum == 2) {
+                int jump = edgeExec[edgeId(block, 0)];
+                int fall = edgeExec[edgeId(block, 1)];
+                if (jump && !fall) {
+                    InterCode_ jumpCode;
+                    memset(&jumpCode, 0, sizeof(InterCode_));
+                    jumpCode.kind = GOTO_IR;
+                    jumpCode.ops[0] = code->ops[2];
+                    emitInterCode(&jumpCode);
+                    foldTotal++;
+                    continue;
+                }
+                if (fall && !jump) {
+                    foldTotal++;
+                    continue;
+                }
+            }
+            InterCode copy = emitInterCode(code);
+            for (int k = definesOp(code); k < 3; k++)
+                if (copy->ops[k] != NULL)
+                    copy->ops[k] = constOf(copy->ops[k], constOps);
+        }
+    }
+    finishRewrite();
+    free(constOps);
+    return constTotal + replaceTotal + foldTotal + removeTotal - changes;
+}
+
+/*
+* 稀疏条件常量传播（Wegman-Zadeck）：同时维护控制流边和SSA值两个工作表，
+* 只沿可执行的边传播，PHI只合并可执行入边上的参数，因此常量条件下不会执行的分支不影响结果
+* 分析结束后删除常量的定值和不可执行的代码，条件确定的跳转变成无条件跳转或直接删除，返回改动的次数
+*/
+int propagateConstants() {
+    valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0 || interCodeNum == 0)
+        return 0;
+    cfg = buildCFG(0, interCodeNum);
+    state = (char*)calloc(valueCount, 1);
+    constVal = (int*)calloc(valueCount, sizeof(int));
+    pinned = (char*)calloc(valueCount, 1);
+    blockOf = (int*)malloc(sizeof(int) * interCodeNum);
+    for (int b = 0; b < cfg->blockNum; b++)
+        for (int i = cfg->blocks[b].start; i < cfg->blocks[b].end; i++)
+            blockOf[i] = b;
+    collectUses();
+    blockExec = (char*)calloc(cfg->blockNum, 1);
+    edgeExec = (char*)calloc(cfg->edgeNum > 0 ? cfg->edgeNum : 1, 1);
+    edgeTarget = (Block*)malloc(sizeof(Block) * (cfg->edgeNum > 0 ? cfg->edgeNum : 1));
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        for (int j = 0; j < block->predNum; j++)
+            edgeTarget[block->preds - cfg->preds + j] = block;
+    }
+    flowWork = (int*)malloc(sizeof(int) * (cfg->edgeNum > 0 ? cfg->edgeNum : 1));
+    flowTop = 0;
+    // 每个值的格值最多下降两次
+    ssaWork = (int*)malloc(sizeof(int) * 2 * valueCount);
+    ssaTop = 0;
+    blockExec[0] = 1;
+    visitBlock(&cfg->blocks[0]);
+    while (flowTop > 0 || ssaTop > 0) {
+        if (flowTop > 0) {
+            Block block = edgeTarget[flowWork[--flowTop]];
+            if (!blockExec[block->no]) {
+                blockExec[block->no] = 1;
+                visitBlock(block);
+            }
+            else {
+                // 已经执行过的块多了一条入边，只需重新求值PHI
+                for (int i = block->start; i < block->end; i++)
+                    if (interCodes[i].kind == PHI_IR)
+                        visitPhi(i);
+            }
+        }
+        else {
+            int v = ssaWork[--ssaTop];
+            for (int u = useStart[v]; u < useStart[v+1]; u++)
+                if (blockExec[blockOf[useList[u]]])
+                    visitCode(useList[u]);
+        }
+    }
+    int changes = rewriteCodes();
+    free(state);
+    free(constVal);
+    free(pinned);
+    free(blockOf);
+    free(useStart);
+    free(useList);
+    free(blockExec);
+    free(edgeExec);
+    free(edgeTarget);
+    free(flowWork);
+    free(ssaWork);
+    freeCFG(cfg);
+    cfg = NULL;
+    return changes;
+}
+
+// 打印常量传播的统计信息
+void printSCCPStats(FILE* fp) {
+    fprintf(fp, "sccp: %d constant definitions removed, %d uses replaced, %d branches folded, %d unreachable codes removed\n",
+        constTotal, replaceTotal, foldTotal, removeTotal);
+}
@@ -0,0 +1,9 @@
+#ifndef SCCP_H
+#define SCCP_H
+
+#include "ssa.h"
+
+int propagateConstants();
+void printSCCPStats(FILE* fp);
+
+#endif
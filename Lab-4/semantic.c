@@ -3,16 +3,23 @@
 // 语义错误数
 int semError = 0;
 
-// 用散列表实现符号表
-Entry symbolTable[HASH_SIZE];
+// 用链式散列表实现符号表，槽位数为2的幂，按装载因子动态扩容
+Entry* symbolTable = NULL;
+int symbolTableSize = 0;
 Entry layersHead;
+// 当前层次的深度
+int layerDepth = 0;
+// 统计信息
+SymbolTableStats symbolStats;
 
 // 初始化符号表
 void initSymbolTable() {
-    for (int i = 0; i < HASH_SIZE; i++) {
-        // 散列表的每个槽位都初始化为空指针
-        symbolTable[i] = NULL;
-    }
+    // 散列表的每个槽位都初始化为空指针
+    free(symbolTable);
+    symbolTableSize = HASH_INIT_SIZE;
+    symbolTable = (Entry*)calloc(symbolTableSize, sizeof(Entry));
+    memset(&symbolStats, 0, sizeof(symbolStats));
+    layerDepth = 0;
     // 初始化层次链表头节点
     layersHead = (Entry)malloc(sizeof(Entry_));
     layersHead->hashNext = NULL;
@@ -24,11 +31,11 @@ void initSymbolTable() {
     layersHead->hashNext = globalLayer;
     // 添加 int read() 函数
     Entry read = (Entry)malloc(sizeof(Entry_));
-    strcpy(read->name, "read");
+    read->name = intern("read");
     read->type = (Type)malloc(sizeof(Type_));
     read->type->kind = ENUM_FUNC;
 	read->type->func = (Function)malloc(sizeof(Function_));
-    strcpy(read->type->func->name, "read");
+    read->type->func->name = read->name;
     read->type->func->returnType = (Type)malloc(sizeof(Type_));
     read->type->func->returnType->kind = ENUM_BASIC;
     read->type->func->returnType->basic = INT_TYPE;
@@ -39,17 +46,17 @@ void initSymbolTable() {
     insertSymbol(read);
     // 添加 int write(int num) 函数
     Entry write = (Entry)malloc(sizeof(Entry_));
-    strcpy(write->name, "write");
+    write->name = intern("write");
     write->type = (Type)malloc(sizeof(Type_));
     write->type->kind = ENUM_FUNC;
 	write->type->func = (Function)malloc(sizeof(Function_));
-    strcpy(write->type->func->name, "write");
+    write->type->func->name = write->name;
     write->type->func->returnType = (Type)malloc(sizeof(Type_));
     write->type->func->returnType->kind = ENUM_BASIC;
     write->type->func->returnType->basic = INT_TYPE;
     write->type->func->parmNum = 0;
     FieldList field = (FieldList)malloc(sizeof(FieldList_));
-    strcpy(field->name, "num");
+    field->name = intern("num");
     field->type = (Type)malloc(sizeof(Type_));
     field->type->kind = ENUM_BASIC;
     field->type->basic = INT_TYPE;
@@ -60,91 +67,108 @@ void initSymbolTable() {
     insertSymbol(write);
 }
 
-// 散列函数
-unsigned int hash_pjw(char* name) {
-    unsigned int val = 0, i;
-    for (; *name; ++name) {
-        val = (val << 2) + *name;
-        if (i = val & ~HASH_SIZE) {
-            val = (val ^ (i >> 12)) & HASH_SIZE;
+// 槽位数翻倍，并把所有条目重新分配到新的槽位
+void resizeSymbolTable() {
+    int newSize = symbolTableSize * 2;
+    Entry* newTable = (Entry*)calloc(newSize, sizeof(Entry));
+    for (int i = 0; i < symbolTableSize; i++) {
+        Entry tail = symbolTable[i];
+        if (tail == NULL)
+            continue;
+        while (tail->hashNext != NULL)
+            tail = tail->hashNext;
+        // 从链尾向链头逐个头插，保证同名条目之间新的在前，遮蔽关系不变
+        while (tail != NULL) {
+            Entry pre = tail->hashPre;
+            unsigned int slot = tail->hashVal & (newSize - 1);
+            tail->hashPre = NULL;
+            tail->hashNext = newTable[slot];
+            if (newTable[slot] != NULL)
+                newTable[slot]->hashPre = tail;
+            newTable[slot] = tail;
+            tail = pre;
         }
     }
-    return val;
+    free(symbolTable);
+    symbolTable = newTable;
+    symbolTableSize = newSize;
+    symbolStats.resizes++;
 }
 
 // 向符号表中插入符号
 void insertSymbol(Entry symbol) {
+    // 装载因子超过3/4时扩容
+    if ((symbolStats.count + 1) * 4 > symbolTableSize * 3)
+        resizeSymbolTable();
     // 计算散列值
-    unsigned int hash = hash_pjw(symbol->name);
+    symbol->hashVal = internHash(symbol->name);
+    symbol->depth = layerDepth;
     // 插入对应槽位的链表头
-    Entry tail = symbolTable[hash];
-    symbolTable[hash] = symbol;
+    unsigned int slot = symbol->hashVal & (symbolTableSize - 1);
+    Entry tail = symbolTable[slot];
+    symbolTable[slot] = symbol;
     symbol->hashNext = tail;
+    symbol->hashPre = NULL;
+    if (tail != NULL)
+        tail->hashPre = symbol;
     // 插入对应层次的链表头
     Entry currentLayer = layersHead->hashNext;
     tail = currentLayer->layerNext;
     currentLayer->layerNext = symbol;
     symbol->layerNext = tail;
+    symbolStats.count++;
+    if (symbolStats.count > symbolStats.maxCount)
+        symbolStats.maxCount = symbolStats.count;
 }
 
-// 从符号表中查找符号
-Entry findSymbolAll(char* name) {
-    unsigned int hash = hash_pjw(name);
-    Entry tmp = symbolTable[hash];
+// 在散列表中查找名字相同的符号，name必须是驻留字符串，isFunc指明查找函数还是其他符号
+Entry lookupSymbol(char* name, int isFunc) {
+    unsigned int hash = internHash(name);
+    Entry tmp = symbolTable[hash & (symbolTableSize - 1)];
+    int probe = 0;
     while (tmp != NULL) {
-        if (strcmp(tmp->name, name) == 0 && tmp->type != NULL && tmp->type->kind != ENUM_FUNC ) {
+        probe++;
+        if (tmp->name == name && tmp->type != NULL &&
+            (tmp->type->kind == ENUM_FUNC) == isFunc) {
             break;
         }
         tmp = tmp->hashNext;
     }
+    symbolStats.lookups++;
+    symbolStats.probes += probe;
+    if (probe > symbolStats.maxProbe)
+        symbolStats.maxProbe = probe;
     return tmp;
 }
 
+// 从符号表中查找符号
+Entry findSymbolAll(char* name) {
+    return lookupSymbol(name, 0);
+}
+
 // 查找同一层次的符号
 Entry findSymbolLayer(char* name) {
-    Entry currentLayer = layersHead->hashNext;
-    Entry symbol = currentLayer->layerNext;
-    while (symbol != NULL) {
-        if (strcmp(symbol->name, name) == 0 && symbol->type->kind != ENUM_FUNC) {
-            break;
-        }
-        symbol = symbol->layerNext;
-    }
+    // 同名符号中新插入的在前，若最近的一个不在当前层次，当前层次就没有该符号
+    Entry symbol = lookupSymbol(name, 0);
+    if (symbol != NULL && symbol->depth != layerDepth)
+        return NULL;
     return symbol;
 }
 
 // 查找函数
 Entry findSymbolFunc(char* name) {
-    unsigned int hash = hash_pjw(name);
-    Entry tmp = symbolTable[hash];
-    while (tmp != NULL) {
-        if (strcmp(tmp->name, name) == 0 && tmp->type->kind == ENUM_FUNC) {
-            break;
-        }
-        tmp = tmp->hashNext;
-    }
-    return tmp;
+    return lookupSymbol(name, 1);
 }
 
-// 从符号表中删除符号
-void delSymbol(char* name) {
-    unsigned int hash = hash_pjw(name);
-    Entry pre = NULL;
-    Entry tmp = symbolTable[hash];
-    while (tmp != NULL) {
-        if (strcmp(tmp->name, name) == 0) {
-            break;
-        }
-        pre = tmp;
-        tmp = tmp->hashNext;
-    }
-    // 说明要删除的符号节点是链表的头节点
-    if (tmp != NULL && pre == NULL) {
-        symbolTable[hash] = tmp->hashNext;
-    }
-    else if (tmp != NULL && pre != NULL) {
-        pre->hashNext = tmp->hashNext;
-    }
+// 从符号表中删除符号，直接摘除节点
+void delSymbol(Entry symbol) {
+    if (symbol->hashPre != NULL)
+        symbol->hashPre->hashNext = symbol->hashNext;
+    else
+        symbolTable[symbol->hashVal & (symbolTableSize - 1)] = symbol->hashNext;
+    if (symbol->hashNext != NULL)
+        symbol->hashNext->hashPre = symbol->hashPre;
+    symbolStats.count--;
 }
 
 // 插入一个层次
@@ -155,6 +179,7 @@ void pushLayer() {
     Entry tail = layersHead->hashNext;
     layersHead->hashNext = currentLayer;
     currentLayer->hashNext = tail;
+    layerDepth++;
 }
 
 // 弹出一个层次，同时删除该层次对应的所有符号
@@ -163,9 +188,38 @@ void popLayer() {
     layersHead->hashNext = currentLayer->hashNext;
     Entry symbol = currentLayer->layerNext;
     while (symbol != NULL) {
-        delSymbol(symbol->name);
+        delSymbol(symbol);
         symbol = symbol->layerNext;
     }
+    free(currentLayer);
+    layerDepth--;
+}
+
+// 获取符号表统计信息
+SymbolTableStats getSymbolTableStats() {
+    SymbolTableStats res = symbolStats;
+    res.size = symbolTableSize;
+    return res;
+}
+
+// 打印符号表的装载因子和查找长度
+void printSymbolTableStats(FILE* fp) {
+    SymbolTableStats stats = getSymbolTableStats();
+    int longest = 0;
+    int used = 0;
+    for (int i = 0; i < symbolTableSize; i++) {
+        int len = 0;
+        for (Entry tmp = symbolTable[i]; tmp != NULL; tmp = tmp->hashNext)
+            len++;
+        if (len > 0)
+            used++;
+        if (len > longest)
+            longest = len;
+    }
+    fprintf(fp, "symbol table: %d buckets (%d used), %d entries (peak %d), load factor %.2f, %d resizes\n",
+            stats.size, used, stats.count, stats.maxCount, (double)stats.count / stats.size, stats.resizes);
+    fprintf(fp, "symbol table: %ld lookups, average probe %.2f, max probe %d, longest chain %d\n",
+            stats.lookups, stats.lookups ? (double)stats.probes / stats.lookups : 0.0, stats.maxProbe, longest);
 }
 
 // 类型等价判断函数
@@ -237,19 +291,24 @@ void Program(Node* root) {
 }
 
 void check() {
-    for (int i = 0; i < HASH_SIZE; i++) {
-        if (symbolTable[i] != NULL) {
-            Entry entry = symbolTable[i];
-            while (entry != NULL) {
-                if (entry->type->kind == ENUM_FUNC && entry->type->func->hasDefined == 0) {
-                    printf("Error type 18 at line %d: Undefined function \"%s\".\n", entry->type->func->lineno, 
-                    entry->name);
-                    semError++;
-                }
-                entry = entry->hashNext;
-            }
+    // 全局层次的链表中新插入的在前，先倒序收集再按声明顺序报告
+    Entry globalLayer = layersHead->hashNext;
+    int num = 0;
+    for (Entry entry = globalLayer->layerNext; entry != NULL; entry = entry->layerNext)
+        num++;
+    Entry* entries = (Entry*)malloc(sizeof(Entry) * (num + 1));
+    int i = num;
+    for (Entry entry = globalLayer->layerNext; entry != NULL; entry = entry->layerNext)
+        entries[--i] = entry;
+    for (i = 0; i < num; i++) {
+        Entry entry = entries[i];
+        if (entry->type != NULL && entry->type->kind == ENUM_FUNC && entry->type->func->hasDefined == 0) {
+            printf("Error type 18 at line %d: Undefined function \"%s\".\n", entry->type->func->lineno, 
+            entry->name);
+            semError++;
         }
     }
+    free(entries);
 }
 
 void ExtDefList(Node* root) {
@@ -265,95 +324,105 @@ void ExtDef(Node* root) {
     if (type == NULL)
         return;
     // 结构体定义，是结构体，不是匿名类型，域定义没有产生错误
-    if (type->kind == ENUM_STRUCT && type->structure->name != "" && type->structure->head != NULL) {
+    if (type->kind == ENUM_STRUCT && type->structure->name[0] != '\0' && type->structure->head != NULL) {
         Entry res = (Entry)malloc(sizeof(Entry_));
-        strcpy(res->name, type->structure->name);
+        res->name = type->structure->name;
         // 需要保证对res->type->kind的改动不会影响到type
         res->type = (Type)malloc(sizeof(Type_));
         res->type->structure = type->structure;
         res->type->kind = ENUM_STRUCT_DEF;
         insertSymbol(res);
     }
-    // 全局变量定义
-    if (strcmp(root->children[1]->name, "ExtDecList") == 0) {
-        ExtDecList(root->children[1], type);
-    }
-    // 函数定义
-    if (strcmp(root->children[1]->name, "FunDec") == 0) {
-        Function func = FunDec(root->children[1]);
-        func->returnType = type;
-        func->hasDefined = 0;
-        Type newType = (Type)malloc(sizeof(Type_));
-        newType->kind = ENUM_FUNC;
-        newType->func = func;
-        Entry sym = findSymbolFunc(func->name);
-        // 存在同名函数声明/定义
-        if (sym != NULL) {
-            // 是函数定义
-            if (sym->type->func->hasDefined == 1) {
-                // 重复定义
-                if (strcmp(root->children[2]->name, "CompSt") == 0) {
-                    printf("Error type 4 at line %d: Redefined function \"%s\".\n", root->lineno, sym->name);
-                    semError++;
-                }
-                // 声明和定义冲突
-                else if (strcmp(root->children[2]->name, "SEMI") == 0 && !typeEqual(newType, sym->type)) {
-                    printf("Error type 19 at line %d: Inconsistent declaration of function \"%s\".\n", root->lineno, sym->name);
-                    semError++;
-                }
-                return;
-            }
-            // 是函数声明
-            if (sym->type->func->hasDefined == 0) {
-                if (strcmp(root->children[2]->name, "CompSt") == 0) {
-                    // 定义和声明冲突
-                    if (!typeEqual(newType, sym->type)) {
-                        printf("Error type 19 at line %d: Inconsistent declaration of function \"%s\".\n", root->lineno, sym->name);
+    switch (root->kind) {
+        // 全局变量定义
+        case ENUM_EXTDEF_VAR:
+            ExtDecList(root->children[1], type);
+            return;
+        // 函数声明/定义
+        case ENUM_EXTDEF_FUNDEC:
+        case ENUM_EXTDEF_FUNDEF: {
+            Function func = FunDec(root->children[1]);
+            func->returnType = type;
+            func->hasDefined = 0;
+            Type newType = (Type)malloc(sizeof(Type_));
+            newType->kind = ENUM_FUNC;
+            newType->func = func;
+            Entry sym = findSymbolFunc(func->name);
+            // 存在同名函数声明/定义
+            if (sym != NULL) {
+                // 是函数定义
+                if (sym->type->func->hasDefined == 1) {
+                    // 重复定义
+                    if (root->kind == ENUM_EXTDEF_FUNDEF) {
+                        printf("Error type 4 at line %d: Redefined function \"%s\".\n", root->lineno, sym->name);
                         semError++;
-                        return;
                     }
-                    // 为已声明的函数添加定义
-                    else {
-                        sym->type->func->hasDefined = 1;
-                        return;
-                    }
-                }
-                else {
-                    // 声明和声明冲突
-                    if (!typeEqual(newType, sym->type)) {
+                    // 声明和定义冲突
+                    else if (root->kind == ENUM_EXTDEF_FUNDEC && !typeEqual(newType, sym->type)) {
                         printf("Error type 19 at line %d: Inconsistent declaration of function \"%s\".\n", root->lineno, sym->name);
                         semError++;
                     }
                     return;
                 }
+                // 是函数声明
+                if (sym->type->func->hasDefined == 0) {
+                    if (root->kind == ENUM_EXTDEF_FUNDEF) {
+                        // 定义和声明冲突
+                        if (!typeEqual(newType, sym->type)) {
+                            printf("Error type 19 at line %d: Inconsistent declaration of function \"%s\".\n", root->lineno, sym->name);
+                            semError++;
+                            return;
+                        }
+                        // 为已声明的函数添加定义，参数名以定义为准
+                        else {
+                            func->hasDefined = 1;
+                            sym->type->func = func;
+                            root->children[1]->entry = sym;
+                            pushLayer();
+                            CompSt(root->children[2], func->name, func->returnType);
+                            popLayer();
+                            return;
+                        }
+                    }
+                    else {
+                        // 声明和声明冲突
+                        if (!typeEqual(newType, sym->type)) {
+                            printf("Error type 19 at line %d: Inconsistent declaration of function \"%s\".\n", root->lineno, sym->name);
+                            semError++;
+                        }
+                        return;
+                    }
+                }
             }
+            // 是首次出现的函数声明/定义
+            if (root->kind == ENUM_EXTDEF_FUNDEC) {
+                Entry res = (Entry)malloc(sizeof(Entry_));
+                res->name = func->name;
+                res->type = newType;
+                insertSymbol(res);
+            }
+            else {
+                Entry res = (Entry)malloc(sizeof(Entry_));
+                func->hasDefined = 1;
+                res->name = func->name;
+                res->type = newType;
+                insertSymbol(res);
+                root->children[1]->entry = res;
+                pushLayer();
+                CompSt(root->children[2], func->name, func->returnType);
+                popLayer();
+            }
+            return;
         }
-        // 是首次出现的函数声明/定义
-        if (strcmp(root->children[2]->name, "SEMI") == 0) {
-            Entry res = (Entry)malloc(sizeof(Entry_));
-            strcpy(res->name, func->name);
-            res->type = newType;
-            insertSymbol(res);
-        }
-        else {
-            Entry res = (Entry)malloc(sizeof(Entry_));
-            func->hasDefined = 1;
-            strcpy(res->name, func->name);
-            res->type = newType;
-            insertSymbol(res);
-            pushLayer();
-            CompSt(root->children[2], func->name, func->returnType);
-            popLayer();
-        }
-        return;
+        default:
+            return;
     }
-    return;
 }
 
 // 类型描述符
 Type Specifier(Node* root) {
-    root = root->children[0];
-    if (strcmp(root->name, "TYPE") == 0) {
+    if (root->kind == ENUM_SPECIFIER_TYPE) {
+        root = root->children[0];
         Type res = (Type)malloc(sizeof(Type_));
         res->kind = ENUM_BASIC;
         if (strcmp(root->strVal, "int") == 0)
@@ -362,8 +431,8 @@ Type Specifier(Node* root) {
             res->basic = FLOAT_TYPE;
         return res;
     }
-    else if (strcmp(root->name, "StructSpecifier") == 0)
-        return StructSpecifier(root);
+    else
+        return StructSpecifier(root->children[0]);
 }
 
 // 全局变量名称列表
@@ -379,7 +448,7 @@ void ExtDecList(Node* root, Type type) {
 // 函数名和参数列表（不检查错误）
 Function FunDec(Node* root) {
     Function res = (Function)malloc(sizeof(Function_));
-    strcpy(res->name, root->children[0]->strVal);
+    res->name = root->children[0]->strVal;
     res->parmNum = 0;
     res->lineno = root->lineno;
     if (root->childNum == 3)
@@ -405,7 +474,7 @@ void CompSt(Node* root, char* funcName, Type reType) {
         FieldList parms = sym->type->func->head;
         while (parms != NULL) {
             Entry parm = (Entry)malloc(sizeof(Entry_));
-            strcpy(parm->name, parms->name);
+            parm->name = parms->name;
             parm->type = parms->type;
             parm->isArg = 1;
             insertSymbol(parm);
@@ -424,9 +493,9 @@ Type StructSpecifier(Node* root) {
     res->structure = (Structure)malloc(sizeof(Structure_));
     for (int i = 0; i < root->childNum; i++) {
         Node* child = root->children[i];
-        if (strcmp(child->name, "OptTag") == 0) {
+        if (child->kind == ENUM_OPTTAG) {
             if (child->childNum == 0)
-                strcpy(res->structure->name, "");
+                res->structure->name = intern("");
             else {
                 // 结构体名字全局唯一
                 Entry sym = findSymbolAll(child->children[0]->strVal);
@@ -436,11 +505,11 @@ Type StructSpecifier(Node* root) {
                     semError++;
                     return NULL;
                 }
-                strcpy(res->structure->name, child->children[0]->strVal);
+                res->structure->name = child->children[0]->strVal;
             }
         }
         // 这里是要使用一个已经定义的结构体类型，可能会产生错误
-        else if (strcmp(child->name, "Tag") == 0) {
+        else if (child->kind == ENUM_TAG) {
             Entry sym = findSymbolAll(child->children[0]->strVal);
             // 该结构体的名称不在符号表中，或查找出的条目不属于结构体定义类型
             if (sym == NULL || sym->type->kind != ENUM_STRUCT_DEF) {
@@ -451,7 +520,7 @@ Type StructSpecifier(Node* root) {
             res->structure = sym->type->structure;
             return res;
         }
-        else if (strcmp(child->name, "DefList") == 0) {
+        else if (child->kind == ENUM_DEFLIST) {
             pushLayer();
             res->structure->head = DefList(child, ENUM_FIELD);
             popLayer();
@@ -534,13 +603,16 @@ FieldList VarDec(Node* root, Type type, IdType class) {
             return NULL;
         }
         FieldList res = (FieldList)malloc(sizeof(FieldList_));
-        strcpy(res->name, root->children[0]->strVal);
+        res->name = root->children[0]->strVal;
         res->type = type;
+        res->next = NULL;
         // 域也要加符号表
         Entry tmp = (Entry)malloc(sizeof(Entry_));
-        strcpy(tmp->name, root->children[0]->strVal);
+        tmp->name = root->children[0]->strVal;
         tmp->type = type;
+        tmp->isArg = 0;
         insertSymbol(tmp); 
+        root->entry = tmp;
         return res;
     }
     // 数组
@@ -549,7 +621,10 @@ FieldList VarDec(Node* root, Type type, IdType class) {
         newType->kind = ENUM_ARRAY;
         newType->array.elem = type;
         newType->array.size = root->children[2]->intVal;
-        return VarDec(root->children[0], newType, class);
+        FieldList res = VarDec(root->children[0], newType, class);
+        // 标注向上传递，使每一层VarDec都能直接取到变量的条目
+        root->entry = root->children[0]->entry;
+        return res;
     }
 }
 
@@ -578,38 +653,44 @@ void StmtList(Node* root, Type reType) {
 }
 
 void Stmt(Node* root, Type reType) {
-    if (strcmp(root->children[0]->name, "RETURN") == 0) {
-        Type type = Exp(root->children[1]);
-        if (!typeEqual(reType, type)) {
-            printf("Error type 8 at line %d: Type mismatched for return.\n", root->lineno);
-            semError++;
+    switch (root->kind) {
+        case ENUM_STMT_RETURN: {
+            Type type = Exp(root->children[1]);
+            if (!typeEqual(reType, type)) {
+                printf("Error type 8 at line %d: Type mismatched for return.\n", root->lineno);
+                semError++;
+            }
+            break;
         }
-    }
-    else if (strcmp(root->children[0]->name, "CompSt") == 0) {
-        pushLayer();
-        CompSt(root->children[0], NULL, reType);
-        popLayer();
-    }
-    else if (strcmp(root->children[0]->name, "Exp") == 0) {
-        Exp(root->children[0]);
-    }
-    else if (strcmp(root->children[0]->name, "WHILE") == 0) {
-        Exp(root->children[2]);
-        Stmt(root->children[4], reType);
-    }
-    else if (strcmp(root->children[0]->name, "IF") == 0) {
-        Exp(root->children[2]);
-        Stmt(root->children[4], reType);
-        if (root->childNum == 7)
-            Stmt(root->children[6], reType);
+        case ENUM_STMT_COMPST:
+            pushLayer();
+            CompSt(root->children[0], NULL, reType);
+            popLayer();
+            break;
+        case ENUM_STMT_EXP:
+            Exp(root->children[0]);
+            break;
+        case ENUM_STMT_WHILE:
+            Exp(root->children[2]);
+            Stmt(root->children[4], reType);
+            break;
+        case ENUM_STMT_IF:
+        case ENUM_STMT_IF_ELSE:
+            Exp(root->children[2]);
+            Stmt(root->children[4], reType);
+            if (root->kind == ENUM_STMT_IF_ELSE)
+                Stmt(root->children[6], reType);
+            break;
+        default:
+            break;
     }
     return;
 }
 
 Type Exp(Node* root) {
-    if (strcmp(root->children[0]->name, "Exp") == 0) {
+    switch (root->kind) {
         // 对结构体使用.操作符
-        if (strcmp(root->children[1]->name, "DOT") == 0) {
+        case ENUM_EXP_DOT: {
             Type res = Exp(root->children[0]);
             if (res != NULL) {
                 if (res->kind != ENUM_STRUCT) {
@@ -617,13 +698,12 @@ Type Exp(Node* root) {
                     semError++;
                     return NULL;
                 }
-                char field[32];
-                strcpy(field, root->children[2]->strVal);
+                char* field = root->children[2]->strVal;
                 // 检测域名是否有效
                 FieldList head = res->structure->head;
                 Type ans = NULL;
                 while (head != NULL) {
-                    if (strcmp(field, head->name) == 0) {
+                    if (head->name == field) {
                         ans = head->type;
                         break;
                     }
@@ -640,7 +720,7 @@ Type Exp(Node* root) {
             return res;
         }
         // 数组取地址操作
-        else if (strcmp(root->children[1]->name, "LB") == 0) {
+        case ENUM_EXP_INDEX: {
             Type pre = Exp(root->children[0]);
             if (pre != NULL) {
                 if (pre->kind != ENUM_ARRAY) {
@@ -652,14 +732,14 @@ Type Exp(Node* root) {
                 if (index == NULL || index->kind != ENUM_BASIC || index->basic != INT_TYPE) {
                     printf("Error type 12 at line %d: Expect an integer in [...].\n", root->lineno);
                     semError++;
-				    return NULL;
+                    return NULL;
                 }
                 return pre->array.elem;
             }
             return pre;
         }
         // 赋值操作
-        else if (strcmp(root->children[1]->name, "ASSIGNOP") == 0) {
+        case ENUM_EXP_ASSIGNOP: {
             // 左值只有三种情况
             // 1、变量
             // 2、域
@@ -668,12 +748,10 @@ Type Exp(Node* root) {
             Node* right = root->children[2];
             Type leftType = NULL;
             Type rightType = Exp(right);
-            if ((left->childNum == 1 && strcmp(left->children[0]->name, "ID") == 0) ||
-				(left->childNum == 4 && strcmp(left->children[1]->name, "LB") == 0) ||
-			    (left->childNum == 3 && strcmp(left->children[1]->name, "DOT") == 0))
-				leftType = Exp(left);
-			else {
-				printf("Error type 6 at line %d: The left-hand side of an assignment must be a variable.\n", root->lineno);
+            if (left->kind == ENUM_EXP_ID || left->kind == ENUM_EXP_INDEX || left->kind == ENUM_EXP_DOT)
+                leftType = Exp(left);
+            else {
+                printf("Error type 6 at line %d: The left-hand side of an assignment must be a variable.\n", root->lineno);
                 semError++;
                 return NULL;
             }
@@ -685,7 +763,13 @@ Type Exp(Node* root) {
             return leftType;
         }
         // 普通二元运算操作
-        else {
+        case ENUM_EXP_AND:
+        case ENUM_EXP_OR:
+        case ENUM_EXP_RELOP:
+        case ENUM_EXP_PLUS:
+        case ENUM_EXP_MINUS:
+        case ENUM_EXP_STAR:
+        case ENUM_EXP_DIV: {
             Type pre = Exp(root->children[0]);
             Type aft = Exp(root->children[2]);
             if (pre == NULL || aft == NULL)
@@ -693,45 +777,41 @@ Type Exp(Node* root) {
             if (!typeEqual(pre, aft)) {
                 printf("Error type 7 at line %d: Type mismatched for operands.\n", root->lineno);
                 semError++;
-				return NULL;
+                return NULL;
             }
-            if (strcmp(root->children[1]->name, "RELOP") == 0) {
+            if (root->kind == ENUM_EXP_RELOP) {
                 Type res = (Type)malloc(sizeof(Type_));
                 res->kind = ENUM_BASIC;
                 res->basic = INT_TYPE;
-                return res;  
+                return res;
             }
             return pre;
         }
-    }
-    else if (strcmp(root->children[0]->name, "LP") == 0) {
-        Type res = Exp(root->children[1]);
-        return res;
-    }
-    else if (strcmp(root->children[0]->name, "MINUS") == 0) {
-        Type res = Exp(root->children[1]);
-        // 如果res为NULL应该是Exp有错，这里就不再报连锁错误
-        if (res != NULL)
-            if (res->kind != ENUM_BASIC) {
-                printf("Error type 7 at line %d: Operands type mismatched.\n", root->lineno);
-                semError++;
-                return NULL;
-            }
-        return res;
-    }
-    else if (strcmp(root->children[0]->name, "NOT") == 0) {
-        Type res = Exp(root->children[1]);
-        if (res != NULL)
-            if (res->kind != ENUM_BASIC || res->basic != INT_TYPE) {
-                printf("Error type 7 at line %d: Operands type mismatched.\n", root->lineno);
-                semError++;
-                return NULL;
-            }
-        return res;
-    }
-    else if (strcmp(root->children[0]->name, "ID") == 0) {
+        case ENUM_EXP_PAREN:
+            return Exp(root->children[1]);
+        case ENUM_EXP_NEG: {
+            Type res = Exp(root->children[1]);
+            // 如果res为NULL应该是Exp有错，这里就不再报连锁错误
+            if (res != NULL)
+                if (res->kind != ENUM_BASIC) {
+                    printf("Error type 7 at line %d: Operands type mismatched.\n", root->lineno);
+                    semError++;
+                    return NULL;
+                }
+            return res;
+        }
+        case ENUM_EXP_NOT: {
+            Type res = Exp(root->children[1]);
+            if (res != NULL)
+                if (res->kind != ENUM_BASIC || res->basic != INT_TYPE) {
+                    printf("Error type 7 at line %d: Operands type mismatched.\n", root->lineno);
+                    semError++;
+                    return NULL;
+                }
+            return res;
+        }
         // ID是一个变量
-        if (root->childNum == 1) {
+        case ENUM_EXP_ID: {
             Entry sym = findSymbolAll(root->children[0]->strVal);
             // 使用不存在的变量
             if (sym == NULL) {
@@ -739,10 +819,11 @@ Type Exp(Node* root) {
                 semError++;
                 return NULL;
             }
+            root->entry = sym;
             return sym->type;
         }
         // ID是一个函数名
-        else {
+        case ENUM_EXP_CALL: {
             Entry sym = findSymbolFunc(root->children[0]->strVal);
             if (sym == NULL) {
                 sym = findSymbolAll(root->children[0]->strVal);
@@ -788,32 +869,36 @@ Type Exp(Node* root) {
                 flag = 0;
             if (flag == 0) {
                 printf("Error type 9 at line %d: The method \"%s(", root->lineno, sym->name);
-				printArgs(sym->type->func->head);
-				printf(")\" is not applicable for the arguments \"(");
+                printArgs(sym->type->func->head);
+                printf(")\" is not applicable for the arguments \"(");
                 printArgs(args_);
                 printf(")\".\n");
                 semError++;
             }
+            root->entry = sym;
             return sym->type->func->returnType;
         }
-    }
-    else if (strcmp(root->children[0]->name, "INT") == 0) {
-        Type res = (Type)malloc(sizeof(Type_));
-        res->kind = ENUM_BASIC;
-        res->basic = INT_TYPE;
-        return res;
-    }
-    else if (strcmp(root->children[0]->name, "FLOAT") == 0) {
-        Type res = (Type)malloc(sizeof(Type_));
-        res->kind = ENUM_BASIC;
-        res->basic = FLOAT_TYPE;
-        return res;
+        case ENUM_EXP_INT: {
+            Type res = (Type)malloc(sizeof(Type_));
+            res->kind = ENUM_BASIC;
+            res->basic = INT_TYPE;
+            return res;
+        }
+        case ENUM_EXP_FLOAT: {
+            Type res = (Type)malloc(sizeof(Type_));
+            res->kind = ENUM_BASIC;
+            res->basic = FLOAT_TYPE;
+            return res;
+        }
+        default:
+            return NULL;
     }
 }
 
 FieldList Args(Node* root) {
     FieldList res = (FieldList)malloc(sizeof(FieldList_));
     res->type = Exp(root->children[0]);
+    res->next = NULL;
     if (root->childNum == 3)
         res->next = Args(root->children[2]);
     return res;
@@ -4,13 +4,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "Tree.h"
+#include "intern.h"
 
 // 两个基本类型
 #define INT_TYPE 0
 #define FLOAT_TYPE 1
 
-// 哈希表大小
-#define HASH_SIZE 31
+// 哈希表初始槽位数（必须是2的幂），装载因子超过3/4时翻倍扩容
+#define HASH_INIT_SIZE 64
 
 typedef struct Type_d Type_;
 typedef Type_* Type;
@@ -55,8 +56,8 @@ struct Type_d {
 
 // 结构体域链表节点
 struct FieldList_d {
-    // 域的名字
-    char name[32];
+    // 域的名字（驻留字符串）
+    char* name;
     // 域的类型
     Type type;
     // 指向下一个域的指针
@@ -65,13 +66,15 @@ struct FieldList_d {
 
 // 结构体类型
 struct Structure_d {
-    char name[32];
+    // 结构体名（驻留字符串），匿名结构体为空串
+    char* name;
     FieldList head;
 };
 
 // 函数类型
 struct Function_d {
-    char name[32];
+    // 函数名（驻留字符串）
+    char* name;
     // 返回值类型
     Type returnType;
     // 参数个数
@@ -86,22 +89,47 @@ struct Function_d {
 
 // 符号表条目类型
 struct Entry_d {
-    char name[32];
+    // 符号名（驻留字符串），查找时直接比较指针
+    char* name;
     Type type;
+    // 名字的散列值，扩容时无需重新计算
+    unsigned int hashVal;
     // 指向同一槽位的下一个条目
     Entry hashNext;
+    // 指向同一槽位的上一个条目，用于O(1)删除
+    Entry hashPre;
+    // 所在层次的深度，全局层次为0
+    int depth;
     // 指向同一层次的下一个条目
     Entry layerNext;
     // 在Lab3中区分该条目是否为函数的参数，默认为0（不是）
     int isArg;
 };
 
+// 符号表统计信息
+typedef struct SymbolTableStats_d {
+    // 槽位数
+    int size;
+    // 当前条目数与峰值条目数
+    int count;
+    int maxCount;
+    // 扩容次数
+    int resizes;
+    // 查找次数与查找过程中比较的条目总数
+    long lookups;
+    long probes;
+    // 单次查找比较的最多条目数
+    int maxProbe;
+} SymbolTableStats;
+
 void insertSymbol(Entry symbol);
 Entry findSymbolAll(char* name);
 Entry findSymbolFunc(char* name);
 void pushLayer();
 void popLayer();
 void initSymbolTable();
+SymbolTableStats getSymbolTableStats();
+void printSymbolTableStats(FILE* fp);
 
 void semanticAnalyse(Node* root);
 void Program(Node* root);
@@ -0,0 +1,259 @@
+#include "simplify.h"
+
+extern int labelNo;
+
+// 化简的统计信息
+static int unreachableTotal = 0;
+static int threadTotal = 0;
+static int jumpTotal = 0;
+static int invertTotal = 0;
+static int labelTotal = 0;
+static int moveTotal = 0;
+
+// 化简时的基本块，只记录指令范围和块之间的关系
+typedef struct SBlock_d {
+    int first;      // 第一条指令，可能是若干连续的LABEL
+    int body;       // 开头的LABEL之后的第一条指令，只有标记的块等于end
+    int end;        // 最后一条指令之后
+    int target;     // 末尾的GOTO或IF_GOTO穿透后的目标块，-1表示没有跳转
+    int reach;      // 从函数入口可达
+    int refs;       // 可达块中跳到这里的次数
+    int fallPred;   // 有可达的前一块落入
+    int chainNext;  // 排列时紧接在后面的块，-1表示没有
+    int chainPred;  // 被某个块的GOTO接到后面
+    int placed;
+    int state;      // 穿透跳转链时的状态：0未访问，1在当前链上，2已求出resolved
+    int resolved;
+} SBlock;
+
+static SBlock* blocks = NULL;
+static int blockCap = 0;
+static int blockNum = 0;
+static int* order = NULL;
+static int* stack = NULL;
+
+// 标记编号到所在块的映射，按全局标记数分配，只查本次出现过的标记
+static int* labelBlock = NULL;
+static int labelCap = 0;
+
+static int lastKind(int b) {
+    return interCodes[blocks[b].end-1].kind;
+}
+
+// 末尾是否会落入下一块
+static int fallsThrough(int b) {
+    int kind = lastKind(b);
+    return kind != GOTO_IR && kind != RETURN_IR && b + 1 < blockNum && interCodes[blocks[b+1].first].kind != FUNC_IR;
+}
+
+// 只有标记和一条GOTO的块，跳到这里等于跳到GOTO的目标
+static int isForwarder(int b) {
+    return blocks[b].first < blocks[b].body && blocks[b].body == blocks[b].end - 1 && lastKind(b) == GOTO_IR;
+}
+
+static Operand jumpLabel(InterCode code) {
+    return code->kind == GOTO_IR ? code->ops[0] : code->ops[2];
+}
+
+/*
+* 沿只含GOTO的块一直前进，得到最终的目标块，途经的块都记下结果，所以总的代价是线性的；
+* 遇到GOTO构成的环时停在环上
+*/
+static int resolve(int b) {
+    int cur = b;
+    while (blocks[cur].state == 0 && isForwarder(cur)) {
+        blocks[cur].state = 1;
+        cur = labelBlock[interCodes[blocks[cur].body].ops[0]->no];
+    }
+    int dest = blocks[cur].state == 2 ? blocks[cur].resolved : cur;
+    for (int k = b; blocks[k].state == 1; k = labelBlock[interCodes[blocks[k].body].ops[0]->no]) {
+        blocks[k].state = 2;
+        blocks[k].resolved = dest;
+    }
+    return dest;
+}
+
+// 划分基本块：FUNC、一串LABEL的第一个以及跳转和RETURN之后的指令开始新的块
+static void splitBlocks() {
+    if (blockCap < interCodeNum) {
+        blockCap = interCodeNum;
+        blocks = (SBlock*)realloc(blocks, sizeof(SBlock) * blockCap);
+        order = (int*)realloc(order, sizeof(int) * blockCap);
+        stack = (int*)realloc(stack, sizeof(int) * blockCap);
+    }
+    if (labelCap < labelNo) {
+        labelCap = labelCap * 2 > labelNo ? labelCap * 2 : labelNo;
+        labelBlock = (int*)realloc(labelBlock, sizeof(int) * labelCap);
+    }
+    blockNum = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        int kind = interCodes[i].kind;
+        int prev = i > 0 ? interCodes[i-1].kind : FUNC_IR;
+        if (i == 0 || kind == FUNC_IR || (kind == LABEL_IR && prev != LABEL_IR) ||
+            prev == GOTO_IR || prev == IF_GOTO_IR || prev == RETURN_IR) {
+            if (blockNum > 0)
+                blocks[blockNum-1].end = i;
+            memset(&blocks[blockNum], 0, sizeof(SBlock));
+            blocks[blockNum].first = i;
+            blocks[blockNum].target = -1;
+            blocks[blockNum].chainNext = -1;
+            blockNum++;
+        }
+        if (kind == LABEL_IR)
+            labelBlock[interCodes[i].ops[0]->no] = blockNum - 1;
+    }
+    blocks[blockNum-1].end = interCodeNum;
+    for (int b = 0; b < blockNum; b++) {
+        int body = blocks[b].first;
+        while (body < blocks[b].end && interCodes[body].kind == LABEL_IR)
+            body++;
+        blocks[b].body = body;
+    }
+}
+
+// 从各函数入口出发求可达的块，统计可达块之间的跳转次数
+static void markReachable() {
+    int top = 0;
+    for (int b = 0; b < blockNum; b++)
+        if (b == 0 || interCodes[blocks[b].first].kind == FUNC_IR) {
+            blocks[b].reach = 1;
+            stack[top++] = b;
+        }
+    while (top > 0) {
+        int b = stack[--top];
+        int succs[2], succNum = 0;
+        if (blocks[b].target >= 0)
+            succs[succNum++] = blocks[b].target;
+        if (fallsThrough(b)) {
+            succs[succNum++] = b + 1;
+            blocks[b+1].fallPred = 1;
+        }
+        for (int k = 0; k < succNum; k++)
+            if (!blocks[succs[k]].reach) {
+                blocks[succs[k]].reach = 1;
+                stack[top++] = succs[k];
+            }
+        if (blocks[b].target >= 0)
+            blocks[blocks[b].target].refs++;
+    }
+}
+
+/*
+* 排列块的顺序：只被一条GOTO跳到、不会从前一块落入、自身也不落入后一块的块接到这条GOTO所在的块后面，
+* 这样的块没有其他入口，接上之后GOTO和标记都可以删掉。其余的块保持原来的顺序
+*/
+static int layoutBlocks() {
+    for (int b = 0; b < blockNum; b++) {
+        // 只有一条GOTO的块留给条件跳转取反处理
+        if (!blocks[b].reach || lastKind(b) != GOTO_IR || blocks[b].body == blocks[b].end - 1)
+            continue;
+        int c = blocks[b].target;
+        int kind = lastKind(c);
+        if (c != b && blocks[c].refs == 1 && !blocks[c].fallPred && !blocks[c].chainPred &&
+            (kind == GOTO_IR || kind == RETURN_IR) && c != b + 1) {
+            blocks[b].chainNext = c;
+            blocks[c].chainPred = 1;
+            moveTotal++;
+        }
+    }
+    int num = 0;
+    for (int b = 0; b < blockNum; b++) {
+        if (!blocks[b].reach || blocks[b].chainPred || blocks[b].placed)
+            continue;
+        for (int c = b; c >= 0 && !blocks[c].placed; c = blocks[c].chainNext) {
+            blocks[c].placed = 1;
+            order[num++] = c;
+        }
+    }
+    return num;
+}
+
+static void emitJump(InterCode code, int target, char* relop) {
+    InterCode copy = emitInterCode(code);
+    Operand label = interCodes[blocks[target].first].ops[0];
+    if (copy->kind == GOTO_IR)
+        copy->ops[0] = label;
+    else {
+        copy->ops[2] = label;
+        copy->relop = relop;
+    }
+}
+
+/*
+* 按排列好的顺序输出：跳到紧接着的块的跳转删去，IF_GOTO之后紧跟只有GOTO的块、再之后是IF_GOTO的目标时，
+* 条件取反后直接跳到GOTO的目标，没有跳转到达的块不再输出标记
+*/
+static void emitBlocks(int num) {
+    beginRewrite(interCodeNum);
+    for (int k = 0; k < num; k++) {
+        int b = order[k];
+        SBlock* block = &blocks[b];
+        int next = k + 1 < num ? order[k+1] : -1;
+        labelTotal += block->body - block->first - (block->refs > 0);
+        if (block->refs > 0)
+            emitInterCode(&interCodes[block->first]);
+        int kind = block->body < block->end ? lastKind(b) : LABEL_IR;
+        int last = kind == GOTO_IR || kind == IF_GOTO_IR ? block->end - 1 : block->end;
+        for (int i = block->body; i < last; i++)
+            emitInterCode(&interCodes[i]);
+        if (last == block->end)
+            continue;
+        InterCode jump = &interCodes[last];
+        int t = block->target;
+        if (t == next) {
+            blocks[t].refs--;
+            jumpTotal++;
+            continue;
+        }
+        if (kind == IF_GOTO_IR && next >= 0 && blocks[next].refs == 0 && blocks[next].body == blocks[next].end - 1 &&
+            lastKind(next) == GOTO_IR && k + 2 < num && order[k+2] == t) {
+            // 跳过只有GOTO的下一块
+            int u = blocks[next].target;
+            labelTotal += blocks[next].body - blocks[next].first;
+            blocks[t].refs--;
+            k++;
+            invertTotal++;
+            if (u == t) {
+                blocks[t].refs--;
+                jumpTotal++;
+            }
+            else
+                emitJump(jump, u, invertRelop(jump->relop));
+            continue;
+        }
+        emitJump(jump, t, jump->relop);
+    }
+    finishRewrite();
+}
+
+/*
+* 线性时间的控制流化简：删除不可达的块（包括RETURN之后的代码），穿透GOTO到GOTO的跳转链，
+* 把只有一个入口的块接到前驱后面，合并顺序执行的块，删除无用的标记，IF_GOTO加GOTO取反为一次跳转。
+* 可以处理多个函数，函数之间互不落入
+*/
+void simplifyCFG() {
+    if (interCodeNum == 0)
+        return;
+    splitBlocks();
+    for (int b = 0; b < blockNum; b++) {
+        int kind = lastKind(b);
+        if (kind != GOTO_IR && kind != IF_GOTO_IR)
+            continue;
+        int dest = labelBlock[jumpLabel(&interCodes[blocks[b].end-1])->no];
+        blocks[b].target = resolve(dest);
+        if (blocks[b].target != dest)
+            threadTotal++;
+    }
+    markReachable();
+    for (int b = 0; b < blockNum; b++)
+        if (!blocks[b].reach)
+            unreachableTotal += blocks[b].end - blocks[b].first;
+    emitBlocks(layoutBlocks());
+}
+
+// 打印控制流化简的统计信息
+void printSimplifyStats(FILE* fp) {
+    fprintf(fp, "simplify: %d unreachable codes removed, %d jumps threaded, %d jumps removed, %d branches inverted\n",
+        unreachableTotal, threadTotal, jumpTotal, invertTotal);
+    fprintf(fp, "simplify: %d labels removed, %d blocks moved after their only predecessor\n", labelTotal, moveTotal);
+}
\ No newline at end of file
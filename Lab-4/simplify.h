@@ -0,0 +1,9 @@
+#ifndef SIMPLIFY_H
+#define SIMPLIFY_H
+
+#include "intercode.h"
+
+void simplifyCFG();
+void printSimplifyStats(FILE* fp);
+
+#endif
@@ -0,0 +1,1225 @@
+#include "ssa.h"
+
+extern int tmpVarNo;
+
+// 当前函数SSA值的起始编号，在buildSSA时确定
+int ssaBase = 0;
+
+// SSA值来自的原变量，按值编号（临时变量编号减去ssaBase）索引，优化中新建的值没有原变量
+static Operand* valueOrigin = NULL;
+static int originCap = 0;
+
+// PHI参数按块分配，和操作数一样在目标代码生成结束前一直有效
+#define PHI_ARG_CHUNK 4096
+// 离开SSA时合并PHI结果与参数所在的类，两个类的成员总数超过这个值时不再合并
+#define MERGE_LIMIT 4096
+static Operand* argChunk = NULL;
+static int argChunkUsed = PHI_ARG_CHUNK;
+
+// 构造SSA时的变量表：变量和临时变量按操作数散列到编号
+static Operand* varOps = NULL;      // 每个变量的代表操作数，离开SSA时作为该变量的名字
+static char* varMemory = NULL;      // 被取地址或用DEC声明的变量只能放在内存中，不参与SSA
+static int varNum = 0;
+static int* varTable = NULL;
+static int varTableSize = 0;
+
+// SSA的统计信息
+static int ssaFuncNum = 0;
+static int valueTotal = 0;
+static int phiTotal = 0;
+static int deadPhiTotal = 0;
+static int copyTotal = 0;
+static int splitTotal = 0;
+static int invertTotal = 0;
+static int apartTotal = 0;
+
+// 指令是否对第0个操作数（变量或临时变量）定值
+int definesOp(InterCode code) {
+    Operand op = code->ops[0];
+    if (op == NULL || (op->kind != VARIABLE_OP && op->kind != TEMP_VAR_OP))
+        return 0;
+    switch (code->kind) {
+        case ASSIGN_IR:
+        case PLUS_IR:
+        case SUB_IR:
+        case MUL_IR:
+        case DIV_IR:
+        case PARAM_IR:
+        case CALL_IR:
+        case READ_IR:
+        case PHI_IR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// 指令是否可能写内存：写解引用、调用以及对不参与SSA的变量赋值
+int writesMemory(InterCode code) {
+    switch (code->kind) {
+        case TO_MEM_IR:
+        case CALL_IR:
+            return 1;
+        case ASSIGN_IR:
+        case PLUS_IR:
+        case SUB_IR:
+        case MUL_IR:
+        case DIV_IR:
+        case READ_IR:
+            return code->ops[0] != NULL && valueNo(code->ops[0]) < 0;
+        default:
+            return 0;
+    }
+}
+
+// 操作数是当前函数的SSA值时返回值编号，否则返回-1
+int valueNo(Operand op) {
+    if (op != NULL && op->kind == TEMP_VAR_OP && op->no >= ssaBase)
+        return op->no - ssaBase;
+    return -1;
+}
+
+// 操作数读取的SSA值（包括解引用的地址），没有时返回-1
+static int usedValue(Operand op) {
+    if (op == NULL)
+        return -1;
+    if (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP)
+        return valueNo(op->opr);
+    return valueNo(op);
+}
+
+// 为一条PHI指令分配num个清零的参数
+Operand* allocPhiArgs(int num) {
+    if (num > PHI_ARG_CHUNK / 4)
+        return (Operand*)calloc(num, sizeof(Operand));
+    if (argChunkUsed + num > PHI_ARG_CHUNK) {
+        argChunk = (Operand*)calloc(PHI_ARG_CHUNK, sizeof(Operand));
+        argChunkUsed = 0;
+    }
+    Operand* args = argChunk + argChunkUsed;
+    argChunkUsed += num;
+    return args;
+}
+
+// 就地删除当前指令数组中的空指令
+void compactCodes() {
+    int num = 0;
+    for (int i = 0; i < interCodeNum; i++)
+        if (interCodes[i].kind != NULL_IR)
+            interCodes[num++] = interCodes[i];
+    interCodeNum = num;
+}
+
+static void setOrigin(Operand value, Operand origin) {
+    int v = value->no - ssaBase;
+    if (v >= originCap) {
+        int cap = originCap * 2 > v + 1 ? originCap * 2 : v + 64;
+        valueOrigin = (Operand*)realloc(valueOrigin, sizeof(Operand) * cap);
+        for (int i = originCap; i < cap; i++)
+            valueOrigin[i] = NULL;
+        originCap = cap;
+    }
+    valueOrigin[v] = origin;
+}
+
+static Operand originOf(int v) {
+    return v < originCap ? valueOrigin[v] : NULL;
+}
+
+static unsigned int opHash(Operand op) {
+    unsigned int h;
+    if (op->kind == TEMP_VAR_OP)
+        h = (unsigned int)op->no;
+    else
+        h = (unsigned int)((size_t)op->name >> 3) ^ 0x9e3779b9u;
+    h *= 2654435761u;
+    return h ^ (h >> 16);
+}
+
+// 在变量表中查找变量或临时变量，不存在时insert为真则新建，否则返回-1
+static int lookupVar(Operand op, int insert) {
+    unsigned int mask = (unsigned int)varTableSize - 1;
+    unsigned int h = opHash(op) & mask;
+    while (varTable[h] >= 0) {
+        Operand key = varOps[varTable[h]];
+        if (key->kind == op->kind && (op->kind == TEMP_VAR_OP ? key->no == op->no : key->name == op->name))
+            return varTable[h];
+        h = (h + 1) & mask;
+    }
+    if (!insert)
+        return -1;
+    varOps[varNum] = op;
+    varMemory[varNum] = 0;
+    varTable[h] = varNum;
+    return varNum++;
+}
+
+// 操作数直接或通过解引用读取的、参与SSA的变量，没有时返回-1
+static int usedVar(Operand op) {
+    if (op == NULL)
+        return -1;
+    if (op->kind == GET_VAL_OP)
+        op = op->opr;
+    if (op->kind != VARIABLE_OP && op->kind != TEMP_VAR_OP)
+        return -1;
+    int v = lookupVar(op, 0);
+    return v >= 0 && !varMemory[v] ? v : -1;
+}
+
+// 指令定值的、参与SSA的变量，没有时返回-1
+static int definedVar(InterCode code) {
+    if (!definesOp(code))
+        return -1;
+    int v = lookupVar(code->ops[0], 0);
+    return v >= 0 && !varMemory[v] ? v : -1;
+}
+
+// 建立变量表，找出只能放在内存中的变量
+static void collectVars() {
+    int maxVars = 4 * interCodeNum + 1;
+    varOps = (Operand*)malloc(sizeof(Operand) * maxVars);
+    varMemory = (char*)malloc(maxVars);
+    varTableSize = 16;
+    while (varTableSize < 2 * maxVars)
+        varTableSize *= 2;
+    varTable = (int*)malloc(sizeof(int) * varTableSize);
+    for (int i = 0; i < varTableSize; i++)
+        varTable[i] = -1;
+    varNum = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        for (int k = 0; k < 3; k++) {
+            Operand op = code->ops[k];
+            if (op == NULL)
+                continue;
+            if (op->kind == VARIABLE_OP || op->kind == TEMP_VAR_OP)
+                lookupVar(op, 1);
+            else if ((op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP) &&
+                     (op->opr->kind == VARIABLE_OP || op->opr->kind == TEMP_VAR_OP)) {
+                int v = lookupVar(op->opr, 1);
+                if (op->kind == GET_ADDR_OP)
+                    varMemory[v] = 1;
+            }
+        }
+        if (code->kind == DEC_IR)
+            varMemory[lookupVar(code->ops[0], 1)] = 1;
+    }
+}
+
+/*
+* 条件跳转落入的块前面是否需要补一个标记：没有标记的块中的指令被优化删光后块就不存在了，
+* 条件跳转的两条出边可能合并成一条，汇合点的PHI参数就和前驱对不上；
+* 落入的是循环头时补上的标记单独成块，作为只有一个后继的前置块
+*/
+static int needsLabel(CFG cfg, int b) {
+    Block block = &cfg->blocks[b];
+    if (b == 0 || block->rpoNo < 0)
+        return 0;
+    Block prev = &cfg->blocks[b-1];
+    if (prev->rpoNo < 0 || interCodes[prev->end - 1].kind != IF_GOTO_IR || prev->succNum < 2)
+        return 0;
+    if (interCodes[block->start].kind != LABEL_IR)
+        return 1;
+    return block->loop != NULL && block->loop->header == block && !inLoop(prev->loop, block->loop);
+}
+
+// 删除从入口不可达的基本块，支配关系只对可达部分有意义，同时补上needsLabel要求的标记
+static void prepareBlocks() {
+    CFG cfg = buildCFG(0, interCodeNum);
+    int labels = 0;
+    for (int b = 0; b < cfg->blockNum; b++)
+        labels += needsLabel(cfg, b);
+    if (cfg->rpoNum < cfg->blockNum || labels > 0) {
+        beginRewrite(interCodeNum + labels);
+        for (int b = 0; b < cfg->blockNum; b++) {
+            Block block = &cfg->blocks[b];
+            if (block->rpoNo < 0)
+                continue;
+            if (needsLabel(cfg, b)) {
+                InterCode_ code;
+                memset(&code, 0, sizeof(InterCode_));
+                code.kind = LABEL_IR;
+                code.ops[0] = newLabel();
+                emitInterCode(&code);
+            }
+            for (int i = block->start; i < block->end; i++)
+                emitInterCode(&interCodes[i]);
+        }
+        finishRewrite();
+    }
+    freeCFG(cfg);
+}
+
+/*
+* 用Cooper-Harvey-Kennedy的方法计算支配边界：从汇合点的每个前驱沿支配树向上走到汇合点的直接支配者，
+* 途经的基本块的支配边界都包含该汇合点，结果按基本块存放在dfStart/dfBlocks中
+*/
+static void computeFrontiers(CFG cfg, int** dfStart, Block** dfBlocks) {
+    int blockNum = cfg->blockNum;
+    int* start = (int*)calloc(blockNum + 1, sizeof(int));
+    int* last = (int*)malloc(sizeof(int) * blockNum);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int b = 0; b < blockNum; b++)
+            last[b] = -1;
+        for (int b = 0; b < blockNum; b++) {
+            Block block = &cfg->blocks[b];
+            if (block->predNum < 2 || block->rpoNo < 0)
+                continue;
+            for (int j = 0; j < block->predNum; j++) {
+                Block runner = block->preds[j];
+                while (runner->rpoNo >= 0 && runner != block->idom) {
+                    // 同一个汇合点只加入一次
+                    if (last[runner->no] != b) {
+                        last[runner->no] = b;
+                        if (pass == 0)
+                            start[runner->no + 1]++;
+                        else
+                            (*dfBlocks)[start[runner->no]++] = block;
+                    }
+                    runner = runner->idom;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int b = 0; b < blockNum; b++)
+                start[b+1] += start[b];
+            *dfBlocks = (Block*)malloc(sizeof(Block) * (start[blockNum] > 0 ? start[blockNum] : 1));
+        }
+    }
+    // 第二遍填充时start[b]移到了下一块的起点，整体后移一位复原
+    for (int b = blockNum; b > 0; b--)
+        start[b] = start[b-1];
+    start[0] = 0;
+    free(last);
+    *dfStart = start;
+}
+
+/*
+* 半剪枝SSA的PHI放置：只有在某个基本块中先使用后定值的变量才可能在汇合点需要PHI，
+* 对每个这样的变量用工作表求定值块集合的迭代支配边界，标记数组按变量编号打戳，不必每个变量清空一次，
+* 总工作量与支配边界的大小和放置的PHI数成正比
+*/
+static int placePhis(CFG cfg, int** phiVarOut) {
+    int blockNum = cfg->blockNum;
+    char* global = (char*)calloc(varNum > 0 ? varNum : 1, 1);
+    int* stamp = (int*)malloc(sizeof(int) * (varNum > 0 ? varNum : 1));
+    for (int v = 0; v < varNum; v++)
+        stamp[v] = -1;
+    for (int b = 0; b < blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            int def = definesOp(code);
+            for (int k = def; k < 3; k++) {
+                int v = usedVar(code->ops[k]);
+                if (v >= 0 && stamp[v] != b)
+                    global[v] = 1;
+            }
+            int v = definedVar(code);
+            if (v >= 0)
+                stamp[v] = b;
+        }
+    }
+    // 按变量收集全局变量的定值块：先计数再填充
+    int* defStart = (int*)calloc(varNum + 1, sizeof(int));
+    int* defFill = (int*)malloc(sizeof(int) * (varNum + 1));
+    Block* defBlocks = NULL;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int v = 0; v < varNum; v++)
+            stamp[v] = -1;
+        for (int b = 0; b < blockNum; b++) {
+            Block block = &cfg->blocks[b];
+            for (int i = block->start; i < block->end; i++) {
+                int v = definedVar(&interCodes[i]);
+                if (v < 0 || !global[v] || stamp[v] == b)
+                    continue;
+                stamp[v] = b;
+                if (pass == 0)
+                    defStart[v+1]++;
+                else
+                    defBlocks[defFill[v]++] = block;
+            }
+        }
+        if (pass == 0) {
+            for (int v = 0; v < varNum; v++)
+                defStart[v+1] += defStart[v];
+            for (int v = 0; v < varNum; v++)
+                defFill[v] = defStart[v];
+            defBlocks = (Block*)malloc(sizeof(Block) * (defStart[varNum] > 0 ? defStart[varNum] : 1));
+        }
+    }
+    int* dfStart;
+    Block* dfBlocks;
+    computeFrontiers(cfg, &dfStart, &dfBlocks);
+    // 工作表求迭代支配边界，phiPairs记录(基本块, 变量)
+    int* hasPhi = (int*)malloc(sizeof(int) * blockNum);
+    int* inWork = (int*)malloc(sizeof(int) * blockNum);
+    Block* work = (Block*)malloc(sizeof(Block) * blockNum);
+    for (int b = 0; b < blockNum; b++) {
+        hasPhi[b] = -1;
+        inWork[b] = -1;
+    }
+    int pairCap = 64, pairNum = 0;
+    int* pairs = (int*)malloc(sizeof(int) * 2 * pairCap);
+    for (int v = 0; v < varNum; v++) {
+        if (!global[v])
+            continue;
+        int top = 0;
+        for (int d = defStart[v]; d < defFill[v]; d++) {
+            Block block = defBlocks[d];
+            inWork[block->no] = v;
+            work[top++] = block;
+        }
+        while (top > 0) {
+            Block x = work[--top];
+            for (int d = dfStart[x->no]; d < dfStart[x->no+1]; d++) {
+                Block y = dfBlocks[d];
+                if (hasPhi[y->no] == v)
+                    continue;
+                hasPhi[y->no] = v;
+                if (pairNum == pairCap) {
+                    pairCap *= 2;
+                    pairs = (int*)realloc(pairs, sizeof(int) * 2 * pairCap);
+                }
+                pairs[2*pairNum] = y->no;
+                pairs[2*pairNum+1] = v;
+                pairNum++;
+                if (inWork[y->no] != v) {
+                    inWork[y->no] = v;
+                    work[top++] = y;
+                }
+            }
+        }
+    }
+    // 按基本块分桶后把PHI插到每块开头的标记之后
+    int* phiStart = (int*)calloc(blockNum + 1, sizeof(int));
+    for (int p = 0; p < pairNum; p++)
+        phiStart[pairs[2*p] + 1]++;
+    for (int b = 0; b < blockNum; b++)
+        phiStart[b+1] += phiStart[b];
+    int* phiVars = (int*)malloc(sizeof(int) * (pairNum > 0 ? pairNum : 1));
+    for (int p = 0; p < pairNum; p++)
+        phiVars[phiStart[pairs[2*p]]++] = pairs[2*p+1];
+    for (int b = blockNum; b > 0; b--)
+        phiStart[b] = phiStart[b-1];
+    phiStart[0] = 0;
+    int* phiVar = (int*)malloc(sizeof(int) * (interCodeNum + pairNum));
+    int pos = 0;
+    beginRewrite(interCodeNum + pairNum);
+    for (int b = 0; b < blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        int i = block->start;
+        if (interCodes[i].kind == LABEL_IR) {
+            emitInterCode(&interCodes[i++]);
+            phiVar[pos++] = -1;
+        }
+        for (int p = phiStart[b]; p < phiStart[b+1]; p++) {
+            InterCode_ phi;
+            memset(&phi, 0, sizeof(InterCode_));
+            phi.kind = PHI_IR;
+            phi.ops[0] = varOps[phiVars[p]];
+            phi.argNum = block->predNum;
+            phi.args = allocPhiArgs(block->predNum);
+            emitInterCode(&phi);
+            phiVar[pos++] = phiVars[p];
+        }
+        for (; i < block->end; i++) {
+            emitInterCode(&interCodes[i]);
+            phiVar[pos++] = -1;
+        }
+    }
+    finishRewrite();
+    phiTotal += pairNum;
+    free(global);
+    free(stamp);
+    free(defStart);
+    free(defFill);
+    free(defBlocks);
+    free(dfStart);
+    free(dfBlocks);
+    free(hasPhi);
+    free(inWork);
+    free(work);
+    free(pairs);
+    free(phiStart);
+    free(phiVars);
+    *phiVarOut = phiVar;
+    return pairNum;
+}
+
+// 重命名时每个变量的当前版本，以及按支配树回溯时恢复旧版本用的日志
+static Operand* current = NULL;
+static int* logVar = NULL;
+static Operand* logPrev = NULL;
+static int logTop = 0;
+
+// 为变量v创建一个新版本并压入日志
+static Operand newVersion(int v) {
+    Operand op = newTemp();
+    setOrigin(op, varOps[v]);
+    logVar[logTop] = v;
+    logPrev[logTop++] = current[v];
+    current[v] = op;
+    valueTotal++;
+    return op;
+}
+
+// 把读取变量的操作数换成变量的当前版本，从未定值的变量按0处理
+static Operand renameUse(Operand op) {
+    int v = usedVar(op);
+    if (v < 0)
+        return op;
+    Operand value = current[v] != NULL ? current[v] : getValue(0);
+    if (op->kind == GET_VAL_OP) {
+        Operand val = allocOperand();
+        val->kind = GET_VAL_OP;
+        val->opr = value;
+        return val;
+    }
+    return value;
+}
+
+// 重命名一个基本块，并填写后继块中PHI指令来自本块的参数
+static void renameBlock(Block block, int* phiVar) {
+    for (int i = block->start; i < block->end; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind == PHI_IR) {
+            code->ops[0] = newVersion(phiVar[i]);
+            continue;
+        }
+        int def = definesOp(code);
+        for (int k = def; k < 3; k++)
+            code->ops[k] = renameUse(code->ops[k]);
+        int v = definedVar(code);
+        if (v >= 0)
+            code->ops[0] = newVersion(v);
+    }
+    for (int k = 0; k < block->succNum; k++) {
+        Block succ = block->succs[k];
+        int j = block->predIndex[k];
+        for (int i = succ->start; i < succ->end; i++) {
+            if (interCodes[i].kind == LABEL_IR)
+                continue;
+            if (interCodes[i].kind != PHI_IR)
+                break;
+            interCodes[i].args[j] = current[phiVar[i]];
+        }
+    }
+}
+
+/*
+* 把当前函数（interCodes中的全部指令）转换为SSA形式：
+* 删除不可达代码，在迭代支配边界上放置PHI，沿支配树重命名，最后删除没有被使用的PHI
+* 每个定值都得到一个新的临时变量作为SSA值，被取地址的变量和DEC声明的数组、结构体保持不变
+*/
+void buildSSA() {
+    prepareBlocks();
+    ssaBase = tmpVarNo;
+    ssaFuncNum++;
+    collectVars();
+    CFG cfg = buildCFG(0, interCodeNum);
+    int* phiVar;
+    placePhis(cfg, &phiVar);
+    freeCFG(cfg);
+    // 插入PHI后基本块的划分不变，只是下标移动了
+    cfg = buildCFG(0, interCodeNum);
+    int blockNum = cfg->blockNum;
+    current = (Operand*)calloc(varNum > 0 ? varNum : 1, sizeof(Operand));
+    logVar = (int*)malloc(sizeof(int) * (interCodeNum + 1));
+    logPrev = (Operand*)malloc(sizeof(Operand) * (interCodeNum + 1));
+    logTop = 0;
+    int* logMark = (int*)malloc(sizeof(int) * blockNum);
+    char* visited = (char*)calloc(blockNum, 1);
+    Block* stack = (Block*)malloc(sizeof(Block) * blockNum);
+    int top = 0;
+    stack[top++] = &cfg->blocks[0];
+    while (top > 0) {
+        Block block = stack[top-1];
+        if (!visited[block->no]) {
+            visited[block->no] = 1;
+            logMark[block->no] = logTop;
+            renameBlock(block, phiVar);
+            for (Block child = block->domChild; child != NULL; child = child->domSibling)
+                stack[top++] = child;
+        }
+        else {
+            // 离开支配子树时恢复进入前各变量的版本
+            top--;
+            while (logTop > logMark[block->no]) {
+                logTop--;
+                current[logVar[logTop]] = logPrev[logTop];
+            }
+        }
+    }
+    free(current);
+    free(logVar);
+    free(logPrev);
+    free(logMark);
+    free(visited);
+    free(stack);
+    free(phiVar);
+    free(varOps);
+    free(varMemory);
+    free(varTable);
+    freeCFG(cfg);
+    pruneDeadPhis();
+}
+
+// 删除结果没有被非PHI指令（直接或经由其他有用的PHI）使用的PHI指令
+void pruneDeadPhis() {
+    int valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0)
+        return;
+    int* phiAt = (int*)malloc(sizeof(int) * valueCount);
+    char* live = (char*)calloc(valueCount, 1);
+    int* work = (int*)malloc(sizeof(int) * valueCount);
+    int top = 0;
+    for (int v = 0; v < valueCount; v++)
+        phiAt[v] = -1;
+    for (int i = 0; i < interCodeNum; i++)
+        if (interCodes[i].kind == PHI_IR && valueNo(interCodes[i].ops[0]) >= 0)
+            phiAt[valueNo(interCodes[i].ops[0])] = i;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind == PHI_IR)
+            continue;
+        for (int k = definesOp(code); k < 3; k++) {
+            int v = usedValue(code->ops[k]);
+            if (v >= 0 && phiAt[v] >= 0 && !live[v]) {
+                live[v] = 1;
+                work[top++] = v;
+            }
+        }
+    }
+    while (top > 0) {
+        InterCode phi = &interCodes[phiAt[work[--top]]];
+        for (int j = 0; j < phi->argNum; j++) {
+            int v = valueNo(phi->args[j]);
+            if (v >= 0 && phiAt[v] >= 0 && !live[v]) {
+                live[v] = 1;
+                work[top++] = v;
+            }
+        }
+    }
+    int removed = 0;
+    for (int i = 0; i < interCodeNum; i++) {
+        InterCode code = &interCodes[i];
+        if (code->kind == PHI_IR && !live[valueNo(code->ops[0])]) {
+            code->kind = NULL_IR;
+            removed++;
+        }
+    }
+    if (removed > 0)
+        compactCodes();
+    deadPhiTotal += removed;
+    free(phiAt);
+    free(live);
+    free(work);
+}
+
+/*
+* 离开SSA时的分析数据：每个值的定值位置、非PHI使用位置（按指令下标升序）以及跨基本块活跃的值的活跃出口集合
+* 值之间的干涉按Budimlic的方法判断：a的定值支配b的定值，并且a在b的定值之后仍然活跃
+*/
+static Block* defBlock = NULL;
+static int* defPos = NULL;
+static Operand* valueOps = NULL;
+static int* useStart = NULL;
+static int* useList = NULL;
+static int* outStart = NULL;    // 每个基本块出口处活跃的值，按值编号升序存放在outList中
+static int* outList = NULL;
+// 合并类：并查集加上按支配序排列的成员链表
+static int* classParent = NULL;
+static int* classNext = NULL;
+static int* classTail = NULL;
+static int* classSize = NULL;
+static Operand* className = NULL;
+static int* forest = NULL;
+static char* forestSide = NULL;
+
+static int findClass(int v) {
+    while (classParent[v] != v) {
+        classParent[v] = classParent[classParent[v]];
+        v = classParent[v];
+    }
+    return v;
+}
+
+// 值a的定值是否在支配序中先于值b（支配树先序编号，同一块内按指令位置）
+static int defBefore(int a, int b) {
+    if (defBlock[a] != defBlock[b])
+        return defBlock[a]->domPre < defBlock[b]->domPre;
+    return defPos[a] < defPos[b];
+}
+
+static int defDominates(int a, int b) {
+    if (defBlock[a] == defBlock[b])
+        return defPos[a] < defPos[b];
+    return dominates(defBlock[a], defBlock[b]);
+}
+
+// 值a在基本块block中下标为pos的指令之后是否仍然活跃（a的定值支配该位置）
+static int liveAfter(int a, Block block, int pos) {
+    int lo = outStart[block->no], hi = outStart[block->no + 1];
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (outList[mid] < a)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < outStart[block->no + 1] && outList[lo] == a)
+        return 1;
+    // 二分查找pos之后的第一次使用，看它是否还在本块内
+    lo = useStart[a];
+    hi = useStart[a+1];
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (useList[mid] <= pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < useStart[a+1] && useList[lo] < block->end;
+}
+
+// a的定值支配b的定值时，两者是否干涉
+static int interferes(int a, int b) {
+    return liveAfter(a, defBlock[b], defPos[b]);
+}
+
+/*
+* 尝试合并两个无干涉的类：按支配序归并两个成员链表，用栈维护支配森林，
+* 只需检查每个值和它在森林中最近的、来自另一个类的祖先是否干涉
+*/
+static int mergeClasses(int a, int b) {
+    // 合并的代价与两个类的大小之和成正比，类太大时放弃合并，改为在前驱出口处拷贝
+    if (classSize[a] + classSize[b] > MERGE_LIMIT)
+        return 0;
+    int top = 0;
+    int x = a, y = b;
+    while (x >= 0 || y >= 0) {
+        int v, side;
+        if (y < 0 || (x >= 0 && defBefore(x, y))) {
+            v = x;
+            side = 0;
+            x = classNext[x];
+        }
+        else {
+            v = y;
+            side = 1;
+            y = classNext[y];
+        }
+        while (top > 0 && !defDominates(forest[top-1], v))
+            top--;
+        if (top > 0 && forestSide[top-1] != side && interferes(forest[top-1], v))
+            return 0;
+        forest[top] = v;
+        forestSide[top++] = side;
+    }
+    // 没有干涉，把b的成员归并进a的链表
+    int head = -1, tail = -1;
+    x = a;
+    y = b;
+    while (x >= 0 || y >= 0) {
+        int v;
+        if (y < 0 || (x >= 0 && defBefore(x, y))) {
+            v = x;
+            x = classNext[x];
+        }
+        else {
+            v = y;
+            y = classNext[y];
+        }
+        if (tail < 0)
+            head = v;
+        else
+            classNext[tail] = v;
+        tail = v;
+    }
+    classNext[tail] = -1;
+    // 类的代表总是链表头，保证从代表开始遍历能得到全部成员
+    int root = head;
+    int other = root == a ? b : a;
+    classParent[other] = root;
+    classParent[root] = root;
+    classTail[root] = tail;
+    classSize[root] = classSize[a] + classSize[b];
+    if (className[root] == NULL)
+        className[root] = className[other];
+    return 1;
+}
+
+// 离开SSA后值的名字，解引用的地址换名时生成新的操作数
+static Operand nameOf(Operand op) {
+    int v = valueNo(op);
+    if (v >= 0) {
+        int root = findClass(v);
+        if (className[root] == NULL)
+            className[root] = newTemp();
+        return className[root];
+    }
+    if ((op != NULL) && (op->kind == GET_VAL_OP || op->kind == GET_ADDR_OP) && valueNo(op->opr) >= 0) {
+        Operand wrap = allocOperand();
+        wrap->kind = op->kind;
+        wrap->opr = nameOf(op->opr);
+        return wrap;
+    }
+    return op;
+}
+
+static InterCode emitRenamed(InterCode code) {
+    InterCode copy = emitInterCode(code);
+    for (int k = 0; k < 3; k++)
+        copy->ops[k] = nameOf(copy->ops[k]);
+    // 合并后变成自己给自己赋值的拷贝直接丢弃
+    if (copy->kind == ASSIGN_IR && copy->ops[0] == copy->ops[1])
+        copy->kind = NULL_IR;
+    return copy;
+}
+
+static void emitCopy(Operand dest, Operand src) {
+    InterCode_ copy;
+    memset(&copy, 0, sizeof(InterCode_));
+    copy.kind = ASSIGN_IR;
+    copy.ops[0] = dest;
+    copy.ops[1] = src;
+    emitInterCode(&copy);
+    copyTotal++;
+}
+
+// 收集边block->succs[k]上PHI需要的拷贝（并行语义），返回拷贝数
+static int collectCopies(Block block, int k, Operand* dests, Operand* srcs) {
+    Block succ = block->succs[k];
+    int j = block->predIndex[k];
+    int num = 0;
+    for (int i = succ->start; i < succ->end; i++) {
+        if (interCodes[i].kind == LABEL_IR)
+            continue;
+        if (interCodes[i].kind != PHI_IR)
+            break;
+        Operand arg = interCodes[i].args[j];
+        if (arg == NULL)
+            continue;
+        Operand dest = nameOf(interCodes[i].ops[0]);
+        Operand src = nameOf(arg);
+        if (dest != src) {
+            dests[num] = dest;
+            srcs[num] = src;
+            num++;
+        }
+    }
+    return num;
+}
+
+// 把并行拷贝排成顺序执行的拷贝：先写不再被读取的目标，剩下的环用一个新临时变量打断
+static void emitParallelCopies(Operand* dests, Operand* srcs, int num) {
+    while (num > 0) {
+        int progress = 0;
+        for (int i = 0; i < num; i++) {
+            int blocked = 0;
+            for (int j = 0; j < num && !blocked; j++)
+                if (j != i && srcs[j] == dests[i])
+                    blocked = 1;
+            if (blocked)
+                continue;
+            emitCopy(dests[i], srcs[i]);
+            num--;
+            dests[i] = dests[num];
+            srcs[i] = srcs[num];
+            i--;
+            progress = 1;
+        }
+        if (!progress) {
+            Operand tmp = newTemp();
+            emitCopy(tmp, dests[0]);
+            for (int j = 0; j < num; j++)
+                if (srcs[j] == dests[0])
+                    srcs[j] = tmp;
+        }
+    }
+}
+
+static void emitEdgeCopies(Block block, int k, Operand* dests, Operand* srcs) {
+    int num = collectCopies(block, k, dests, srcs);
+    emitParallelCopies(dests, srcs, num);
+}
+
+// 活跃分析反向遍历用的临时数据
+static int* inStamp = NULL;
+static int* outStamp = NULL;
+static Block* liveWork = NULL;
+static int workTop = 0;
+static int* livePairs = NULL;
+static int livePairNum = 0;
+static int livePairCap = 0;
+
+// 值v在前驱pred的出口处活跃；pred不是定值块时v在它的入口处也活跃，需要继续向前遍历
+static void reachPred(Block pred, int v, Block def) {
+    if (pred->rpoNo < 0)
+        return;
+    if (outStamp[pred->no] != v) {
+        outStamp[pred->no] = v;
+        if (livePairNum == livePairCap) {
+            livePairCap *= 2;
+            livePairs = (int*)realloc(livePairs, sizeof(int) * 2 * livePairCap);
+        }
+        livePairs[2*livePairNum] = pred->no;
+        livePairs[2*livePairNum+1] = v;
+        livePairNum++;
+    }
+    if (pred != def && inStamp[pred->no] != v) {
+        inStamp[pred->no] = v;
+        liveWork[workTop++] = pred;
+    }
+}
+
+/*
+* 离开SSA时的活跃分析：对每个值从它的使用处沿前驱反向走到定值块，经过的基本块出口处该值都活跃，
+* PHI参数在对应前驱的出口处使用；总工作量与各值活跃范围覆盖的基本块数之和成正比，
+* 不需要为大函数分配基本块数乘以值个数的位向量
+*/
+static void computeLiveness(CFG cfg, int valueCount) {
+    int blockNum = cfg->blockNum;
+    int* blockOf = (int*)malloc(sizeof(int) * (interCodeNum > 0 ? interCodeNum : 1));
+    for (int b = 0; b < blockNum; b++)
+        for (int i = cfg->blocks[b].start; i < cfg->blocks[b].end; i++)
+            blockOf[i] = b;
+    // 按值收集作为PHI参数时对应的前驱块
+    int* phiStart = (int*)calloc(valueCount + 1, sizeof(int));
+    int* phiPred = NULL;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int b = 0; b < blockNum; b++) {
+            Block block = &cfg->blocks[b];
+            if (block->rpoNo < 0)
+                continue;
+            for (int i = block->start; i < block->end; i++) {
+                InterCode code = &interCodes[i];
+                if (code->kind != PHI_IR)
+                    continue;
+                for (int j = 0; j < code->argNum; j++) {
+                    int v = valueNo(code->args[j]);
+                    if (v < 0 || defBlock[v] == NULL || block->preds[j]->rpoNo < 0)
+                        continue;
+                    if (pass == 0)
+                        phiStart[v+1]++;
+                    else
+                        phiPred[phiStart[v]++] = block->preds[j]->no;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int v = 0; v < valueCount; v++)
+                phiStart[v+1] += phiStart[v];
+            phiPred = (int*)malloc(sizeof(int) * (phiStart[valueCount] > 0 ? phiStart[valueCount] : 1));
+        }
+    }
+    for (int v = valueCount; v > 0; v--)
+        phiStart[v] = phiStart[v-1];
+    phiStart[0] = 0;
+    // 逐个值反向遍历，(基本块, 值)对按值编号的顺序产生
+    inStamp = (int*)malloc(sizeof(int) * blockNum);
+    outStamp = (int*)malloc(sizeof(int) * blockNum);
+    liveWork = (Block*)malloc(sizeof(Block) * blockNum);
+    for (int b = 0; b < blockNum; b++) {
+        inStamp[b] = -1;
+        outStamp[b] = -1;
+    }
+    livePairCap = 1024;
+    livePairNum = 0;
+    livePairs = (int*)malloc(sizeof(int) * 2 * livePairCap);
+    for (int v = 0; v < valueCount; v++) {
+        Block def = defBlock[v];
+        if (def == NULL)
+            continue;
+        workTop = 0;
+        for (int u = useStart[v]; u < useStart[v+1]; u++) {
+            Block block = &cfg->blocks[blockOf[useList[u]]];
+            if (block != def && inStamp[block->no] != v) {
+                inStamp[block->no] = v;
+                liveWork[workTop++] = block;
+            }
+        }
+        // PHI参数在对应前驱的出口处活跃
+        for (int p = phiStart[v]; p < phiStart[v+1]; p++)
+            reachPred(&cfg->blocks[phiPred[p]], v, def);
+        while (workTop > 0) {
+            Block block = liveWork[--workTop];
+            for (int j = 0; j < block->predNum; j++)
+                reachPred(block->preds[j], v, def);
+        }
+    }
+    // 按基本块稳定地分桶，每块内的值保持升序
+    outStart = (int*)calloc(blockNum + 1, sizeof(int));
+    outList = (int*)malloc(sizeof(int) * (livePairNum > 0 ? livePairNum : 1));
+    for (int p = 0; p < livePairNum; p++)
+        outStart[livePairs[2*p] + 1]++;
+    for (int b = 0; b < blockNum; b++)
+        outStart[b+1] += outStart[b];
+    for (int p = 0; p < livePairNum; p++)
+        outList[outStart[livePairs[2*p]]++] = livePairs[2*p+1];
+    for (int b = blockNum; b > 0; b--)
+        outStart[b] = outStart[b-1];
+    outStart[0] = 0;
+    free(blockOf);
+    free(phiStart);
+    free(phiPred);
+    free(inStamp);
+    free(outStamp);
+    free(liveWork);
+    free(livePairs);
+}
+
+static int compareGroup(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    Operand ox = originOf(x) != NULL ? originOf(x) : valueOps[x];
+    Operand oy = originOf(y) != NULL ? originOf(y) : valueOps[y];
+    if (ox != oy)
+        return (size_t)ox < (size_t)oy ? -1 : 1;
+    if (defBefore(x, y))
+        return -1;
+    return defBefore(y, x) ? 1 : 0;
+}
+
+/*
+* 离开SSA：
+* 1. 同一个原变量的各个版本按支配序贪心地合并为一类，与已合并的值干涉的版本单独成类并改用新的临时变量；
+* 2. 尝试把每个PHI的参数所在的类与结果所在的类合并，合并成功的参数不需要拷贝；
+* 3. 其余参数在前驱出口处插入并行拷贝，条件跳转只有跳转边需要拷贝时取反条件，拷贝放在落空的一侧，
+*    两条边都需要拷贝时拆分跳转边，新块放在函数末尾
+* 没有经过优化的程序中同一变量的版本互不干涉，离开SSA后得到与构造前相同的指令
+*/
+void destructSSA() {
+    pruneDeadPhis();
+    CFG cfg = buildCFG(0, interCodeNum);
+    int valueCount = tmpVarNo - ssaBase;
+    if (valueCount <= 0)
+        valueCount = 1;
+    defBlock = (Block*)calloc(valueCount, sizeof(Block));
+    defPos = (int*)malloc(sizeof(int) * valueCount);
+    valueOps = (Operand*)calloc(valueCount, sizeof(Operand));
+    useStart = (int*)calloc(valueCount + 1, sizeof(int));
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        if (block->rpoNo < 0)
+            continue;
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            int v = definesOp(code) ? valueNo(code->ops[0]) : -1;
+            if (v >= 0) {
+                defBlock[v] = block;
+                defPos[v] = i;
+                valueOps[v] = code->ops[0];
+            }
+            if (code->kind == PHI_IR)
+                continue;
+            for (int k = definesOp(code); k < 3; k++) {
+                int u = usedValue(code->ops[k]);
+                if (u >= 0)
+                    useStart[u+1]++;
+            }
+        }
+    }
+    for (int v = 0; v < valueCount; v++)
+        useStart[v+1] += useStart[v];
+    useList = (int*)malloc(sizeof(int) * (useStart[valueCount] > 0 ? useStart[valueCount] : 1));
+    int* useFill = (int*)malloc(sizeof(int) * valueCount);
+    for (int v = 0; v < valueCount; v++)
+        useFill[v] = useStart[v];
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        if (block->rpoNo < 0)
+            continue;
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            if (code->kind == PHI_IR)
+                continue;
+            for (int k = definesOp(code); k < 3; k++) {
+                int u = usedValue(code->ops[k]);
+                if (u >= 0)
+                    useList[useFill[u]++] = i;
+            }
+        }
+    }
+    free(useFill);
+    computeLiveness(cfg, valueCount);
+    // 按原变量分组，组内按支配序贪心合并
+    classParent = (int*)malloc(sizeof(int) * valueCount);
+    classNext = (int*)malloc(sizeof(int) * valueCount);
+    classTail = (int*)malloc(sizeof(int) * valueCount);
+    classSize = (int*)malloc(sizeof(int) * valueCount);
+    className = (Operand*)calloc(valueCount, sizeof(Operand));
+    forest = (int*)malloc(sizeof(int) * valueCount);
+    forestSide = (char*)malloc(valueCount);
+    int* order = (int*)malloc(sizeof(int) * valueCount);
+    int orderNum = 0;
+    for (int v = 0; v < valueCount; v++) {
+        classParent[v] = v;
+        classNext[v] = -1;
+        classTail[v] = v;
+        classSize[v] = 1;
+        if (defBlock[v] != NULL)
+            order[orderNum++] = v;
+    }
+    qsort(order, orderNum, sizeof(int), compareGroup);
+    for (int s = 0; s < orderNum; ) {
+        Operand origin = originOf(order[s]) != NULL ? originOf(order[s]) : valueOps[order[s]];
+        int e = s;
+        int root = -1;
+        int top = 0;
+        while (e < orderNum && (originOf(order[e]) != NULL ? originOf(order[e]) : valueOps[order[e]]) == origin) {
+            int v = order[e++];
+            while (top > 0 && !defDominates(forest[top-1], v))
+                top--;
+            if (top > 0 && interferes(forest[top-1], v)) {
+                apartTotal++;
+                continue;
+            }
+            forest[top++] = v;
+            if (root < 0) {
+                root = v;
+                className[root] = origin;
+            }
+            else {
+                classParent[v] = root;
+                classNext[classTail[root]] = v;
+                classTail[root] = v;
+                classSize[root]++;
+            }
+        }
+        s = e;
+    }
+    // 合并PHI结果与参数所在的类
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        if (block->rpoNo < 0)
+            continue;
+        for (int i = block->start; i < block->end; i++) {
+            InterCode code = &interCodes[i];
+            if (code->kind != PHI_IR)
+                continue;
+            int d = valueNo(code->ops[0]);
+            for (int j = 0; j < code->argNum; j++) {
+                int a = valueNo(code->args[j]);
+                if (a < 0 || defBlock[a] == NULL)
+                    continue;
+                int ra = findClass(a), rd = findClass(d);
+                if (ra != rd)
+                    mergeClasses(rd, ra);
+            }
+        }
+    }
+    // 生成离开SSA后的指令
+    Operand* dests = (Operand*)malloc(sizeof(Operand) * (interCodeNum + 1));
+    Operand* srcs = (Operand*)malloc(sizeof(Operand) * (interCodeNum + 1));
+    Block* splitBlocks = (Block*)malloc(sizeof(Block) * (cfg->blockNum + 1));
+    Operand* splitLabels = (Operand*)malloc(sizeof(Operand) * (cfg->blockNum + 1));
+    int splitNum = 0;
+    beginRewrite(interCodeNum + interCodeNum / 4);
+    for (int b = 0; b < cfg->blockNum; b++) {
+        Block block = &cfg->blocks[b];
+        if (block->rpoNo < 0)
+            continue;
+        for (int i = block->start; i < block->end - 1; i++)
+            if (interCodes[i].kind != PHI_IR)
+                emitRenamed(&interCodes[i]);
+        InterCode last = &interCodes[block->end - 1];
+        if (last->kind == PHI_IR) {
+            if (block->succNum > 0)
+                emitEdgeCopies(block, 0, dests, srcs);
+        }
+        else if (last->kind == GOTO_IR) {
+            emitEdgeCopies(block, 0, dests, srcs);
+            emitRenamed(last);
+        }
+        else if (last->kind == IF_GOTO_IR) {
+            // 跳转目标就是下一块时条件跳转没有作用
+            if (block->succNum == 1 && b + 1 < cfg->blockNum && block->succs[0] == &cfg->blocks[b+1])
+                emitEdgeCopies(block, 0, dests, srcs);
+            else {
+                int num = collectCopies(block, 0, dests, srcs);
+                Block fall = block->succNum == 2 ? block->succs[1] : NULL;
+                if (num > 0 && fall != NULL && interCodes[fall->start].kind == LABEL_IR &&
+                    collectCopies(block, 1, dests + num, srcs + num) == 0) {
+                    // 只有跳转边需要拷贝时把条件取反跳到落入的块，拷贝放在条件跳转之后，再跳到原目标
+                    InterCode jump = emitRenamed(last);
+                    jump->relop = invertRelop(jump->relop);
+                    jump->ops[2] = interCodes[fall->start].ops[0];
+                    emitParallelCopies(dests, srcs, num);
+                    InterCode_ code;
+                    memset(&code, 0, sizeof(InterCode_));
+                    code.kind = GOTO_IR;
+                    code.ops[0] = interCodes[block->succs[0]->start].ops[0];
+                    emitInterCode(&code);
+                    invertTotal++;
+                    continue;
+                }
+                InterCode jump = emitRenamed(last);
+                if (num > 0) {
+                    // 拆分跳转边：跳到函数末尾的新块，拷贝后再跳到原目标
+                    Operand label = newLabel();
+                    jump->ops[2] = label;
+                    splitBlocks[splitNum] = block;
+                    splitLabels[splitNum++] = label;
+                    splitTotal++;
+                }
+                if (block->succNum == 2)
+                    emitEdgeCopies(block, 1, dests, srcs);
+            }
+        }
+        else if (last->kind == RETURN_IR)
+            emitRenamed(last);
+        else {
+            emitRenamed(last);
+            if (block->succNum > 0)
+                emitEdgeCopies(block, 0, dests, srcs);
+        }
+    }
+    for (int s = 0; s < splitNum; s++) {
+        Block block = splitBlocks[s];
+        InterCode_ code;
+        memset(&code, 0, sizeof(InterCode_));
+        code.kind = LABEL_IR;
+        code.ops[0] = splitLabels[s];
+        emitInterCode(&code);
+        emitEdgeCopies(block, 0, dests, srcs);
+        code.kind = GOTO_IR;
+        code.ops[0] = interCodes[block->succs[0]->start].ops[0];
+        emitInterCode(&code);
+    }
+    finishRewrite();
+    compactCodes();
+    free(dests);
+    free(srcs);
+    free(splitBlocks);
+    free(splitLabels);
+    free(order);
+    free(defBlock);
+    free(defPos);
+    free(valueOps);
+    free(useStart);
+    free(useList);
+    free(outStart);
+    free(outList);
+    free(classParent);
+    free(classNext);
+    free(classTail);
+    free(classSize);
+    free(className);
+    free(forest);
+    free(forestSide);
+    freeCFG(cfg);
+    // 清空本函数用过的原变量记录，下一个函数的值编号从新的ssaBase开始
+    for (int v = 0; v < valueCount && v < originCap; v++)
+        valueOrigin[v] = NULL;
+    ssaBase = tmpVarNo;
+}
+
+// 打印SSA构造和消去的统计信息
+void printSSAStats(FILE* fp) {
+    fprintf(fp, "ssa: %d functions, %d values, %d phis placed (%d dead removed)\n",
+        ssaFuncNum, valueTotal, phiTotal, deadPhiTotal);
+    fprintf(fp, "ssa: out of SSA %d copies inserted, %d critical edges split, %d branches inverted, %d values renamed apart\n",
+        copyTotal, splitTotal, invertTotal, apartTotal);
+}
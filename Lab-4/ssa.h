@@ -0,0 +1,19 @@
+#ifndef SSA_H
+#define SSA_H
+
+#include "cfg.h"
+
+// 当前函数中编号不小于ssaBase的临时变量是SSA值，每个SSA值只有一处定值
+extern int ssaBase;
+
+int definesOp(InterCode code);
+int writesMemory(InterCode code);
+int valueNo(Operand op);
+Operand* allocPhiArgs(int num);
+void compactCodes();
+void pruneDeadPhis();
+void buildSSA();
+void destructSSA();
+void printSSAStats(FILE* fp);
+
+#endif
@@ -75,8 +75,10 @@
     Node** package(int childNum, Node* child1, ...);
     void yyerror(const char* msg);
     int synError = 0;
+    // 语句列表和else if链都是右递归，生成的长程序需要很深的分析栈
+    #define YYMAXDEPTH 1000000
 
-#line 80 "./syntax.tab.c"
+#line 82 "./syntax.tab.c"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -548,15 +550,15 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    30,    30,    34,    36,    39,    41,    43,    45,    47,
-      49,    51,    54,    56,    58,    63,    65,    68,    70,    72,
-      74,    76,    78,    81,    83,    86,    91,    93,    95,    97,
-     100,   102,   104,   106,   109,   111,   114,   119,   122,   124,
-     127,   129,   131,   133,   135,   137,   139,   141,   143,   145,
-     147,   152,   154,   157,   160,   162,   164,   167,   169,   171,
-     176,   178,   180,   182,   184,   186,   188,   190,   192,   194,
-     196,   198,   200,   202,   204,   206,   208,   210,   212,   214,
-     216,   218,   220,   222,   224,   226,   228,   230,   233,   235
+       0,    32,    32,    36,    38,    41,    43,    45,    47,    49,
+      51,    53,    56,    58,    60,    65,    67,    70,    72,    74,
+      76,    78,    80,    83,    85,    88,    93,    95,    97,    99,
+     102,   104,   106,   108,   111,   113,   116,   121,   124,   126,
+     129,   131,   133,   135,   137,   139,   141,   143,   145,   147,
+     149,   154,   156,   159,   162,   164,   166,   169,   171,   173,
+     178,   180,   182,   184,   186,   188,   190,   192,   194,   196,
+     198,   200,   202,   204,   206,   208,   210,   212,   214,   216,
+     218,   220,   222,   224,   226,   228,   230,   232,   235,   237
 };
 #endif
 
@@ -1654,624 +1656,624 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* Program: ExtDefList  */
-#line 30 "./syntax.y"
-                                                { yyval = createNode("Program", ENUM_SYN_NOT_NULL, (yyloc).first_line, 
+#line 32 "./syntax.y"
+                                                { yyval = createNode("Program", ENUM_PROGRAM, ENUM_SYN_NOT_NULL, (yyloc).first_line, 
                                                   1, package(1, yyvsp[0]));
                                                   root = yyval; }
-#line 1662 "./syntax.tab.c"
+#line 1664 "./syntax.tab.c"
     break;
 
   case 3: /* ExtDefList: ExtDef ExtDefList  */
-#line 34 "./syntax.y"
-                                                { yyval = createNode("ExtDefList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 36 "./syntax.y"
+                                                { yyval = createNode("ExtDefList", ENUM_EXTDEFLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 1669 "./syntax.tab.c"
+#line 1671 "./syntax.tab.c"
     break;
 
   case 4: /* ExtDefList: %empty  */
-#line 36 "./syntax.y"
-                                                { yyval = createNode("ExtDefList", ENUM_SYN_NULL, (yyloc).first_line
+#line 38 "./syntax.y"
+                                                { yyval = createNode("ExtDefList", ENUM_EXTDEFLIST, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL);}
-#line 1676 "./syntax.tab.c"
+#line 1678 "./syntax.tab.c"
     break;
 
   case 5: /* ExtDef: Specifier ExtDecList SEMI  */
-#line 39 "./syntax.y"
-                                                { yyval = createNode("ExtDef", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 41 "./syntax.y"
+                                                { yyval = createNode("ExtDef", ENUM_EXTDEF_VAR, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1683 "./syntax.tab.c"
+#line 1685 "./syntax.tab.c"
     break;
 
   case 6: /* ExtDef: Specifier SEMI  */
-#line 41 "./syntax.y"
-                                                { yyval = createNode("ExtDef", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 43 "./syntax.y"
+                                                { yyval = createNode("ExtDef", ENUM_EXTDEF_TYPE, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 1690 "./syntax.tab.c"
+#line 1692 "./syntax.tab.c"
     break;
 
   case 7: /* ExtDef: Specifier FunDec SEMI  */
-#line 43 "./syntax.y"
-                                                { yyval = createNode("ExtDef", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 45 "./syntax.y"
+                                                { yyval = createNode("ExtDef", ENUM_EXTDEF_FUNDEC, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1697 "./syntax.tab.c"
+#line 1699 "./syntax.tab.c"
     break;
 
   case 8: /* ExtDef: Specifier FunDec CompSt  */
-#line 45 "./syntax.y"
-                                                { yyval = createNode("ExtDef", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 47 "./syntax.y"
+                                                { yyval = createNode("ExtDef", ENUM_EXTDEF_FUNDEF, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1704 "./syntax.tab.c"
+#line 1706 "./syntax.tab.c"
     break;
 
   case 9: /* ExtDef: Specifier error SEMI  */
-#line 47 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 49 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1711 "./syntax.tab.c"
+#line 1713 "./syntax.tab.c"
     break;
 
   case 10: /* ExtDef: error SEMI  */
-#line 49 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 51 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1718 "./syntax.tab.c"
+#line 1720 "./syntax.tab.c"
     break;
 
   case 11: /* ExtDef: Specifier error  */
-#line 51 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 53 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1725 "./syntax.tab.c"
+#line 1727 "./syntax.tab.c"
     break;
 
   case 12: /* ExtDecList: VarDec  */
-#line 54 "./syntax.y"
-                                                { yyval = createNode("ExtDecList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 56 "./syntax.y"
+                                                { yyval = createNode("ExtDecList", ENUM_EXTDECLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1732 "./syntax.tab.c"
+#line 1734 "./syntax.tab.c"
     break;
 
   case 13: /* ExtDecList: VarDec COMMA ExtDecList  */
-#line 56 "./syntax.y"
-                                                { yyval = createNode("ExtDecList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 58 "./syntax.y"
+                                                { yyval = createNode("ExtDecList", ENUM_EXTDECLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1739 "./syntax.tab.c"
+#line 1741 "./syntax.tab.c"
     break;
 
   case 14: /* ExtDecList: VarDec error COMMA ExtDecList  */
-#line 58 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 60 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1746 "./syntax.tab.c"
+#line 1748 "./syntax.tab.c"
     break;
 
   case 15: /* Specifier: TYPE  */
-#line 63 "./syntax.y"
-                                                { yyval = createNode("Specifier", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 65 "./syntax.y"
+                                                { yyval = createNode("Specifier", ENUM_SPECIFIER_TYPE, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1753 "./syntax.tab.c"
+#line 1755 "./syntax.tab.c"
     break;
 
   case 16: /* Specifier: StructSpecifier  */
-#line 65 "./syntax.y"
-                                                { yyval = createNode("Specifier", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 67 "./syntax.y"
+                                                { yyval = createNode("Specifier", ENUM_SPECIFIER_STRUCT, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1760 "./syntax.tab.c"
+#line 1762 "./syntax.tab.c"
     break;
 
   case 17: /* StructSpecifier: STRUCT OptTag LC DefList RC  */
-#line 68 "./syntax.y"
-                                                { yyval = createNode("StructSpecifier", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 70 "./syntax.y"
+                                                { yyval = createNode("StructSpecifier", ENUM_STRUCTSPECIFIER_DEF, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 5, package(5, yyvsp[-4], yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1767 "./syntax.tab.c"
+#line 1769 "./syntax.tab.c"
     break;
 
   case 18: /* StructSpecifier: STRUCT Tag  */
-#line 70 "./syntax.y"
-                                                { yyval = createNode("StructSpecifier", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 72 "./syntax.y"
+                                                { yyval = createNode("StructSpecifier", ENUM_STRUCTSPECIFIER_TAG, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 1774 "./syntax.tab.c"
+#line 1776 "./syntax.tab.c"
     break;
 
   case 19: /* StructSpecifier: STRUCT error LC DefList RC  */
-#line 72 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 74 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1781 "./syntax.tab.c"
+#line 1783 "./syntax.tab.c"
     break;
 
   case 20: /* StructSpecifier: STRUCT OptTag LC error RC  */
-#line 74 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 76 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1788 "./syntax.tab.c"
+#line 1790 "./syntax.tab.c"
     break;
 
   case 21: /* StructSpecifier: STRUCT OptTag LC error  */
-#line 76 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 78 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1795 "./syntax.tab.c"
+#line 1797 "./syntax.tab.c"
     break;
 
   case 22: /* StructSpecifier: STRUCT error  */
-#line 78 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 80 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1802 "./syntax.tab.c"
+#line 1804 "./syntax.tab.c"
     break;
 
   case 23: /* OptTag: ID  */
-#line 81 "./syntax.y"
-                                                { yyval = createNode("OptTag", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 83 "./syntax.y"
+                                                { yyval = createNode("OptTag", ENUM_OPTTAG, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1809 "./syntax.tab.c"
+#line 1811 "./syntax.tab.c"
     break;
 
   case 24: /* OptTag: %empty  */
-#line 83 "./syntax.y"
-                                                { yyval = createNode("OptTag", ENUM_SYN_NULL, (yyloc).first_line
+#line 85 "./syntax.y"
+                                                { yyval = createNode("OptTag", ENUM_OPTTAG, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); }
-#line 1816 "./syntax.tab.c"
+#line 1818 "./syntax.tab.c"
     break;
 
   case 25: /* Tag: ID  */
-#line 86 "./syntax.y"
-                                                { yyval = createNode("Tag", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 88 "./syntax.y"
+                                                { yyval = createNode("Tag", ENUM_TAG, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1823 "./syntax.tab.c"
+#line 1825 "./syntax.tab.c"
     break;
 
   case 26: /* VarDec: ID  */
-#line 91 "./syntax.y"
-                                                { yyval = createNode("VarDec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 93 "./syntax.y"
+                                                { yyval = createNode("VarDec", ENUM_VARDEC_ID, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1830 "./syntax.tab.c"
+#line 1832 "./syntax.tab.c"
     break;
 
   case 27: /* VarDec: VarDec LB INT RB  */
-#line 93 "./syntax.y"
-                                                { yyval = createNode("VarDec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 95 "./syntax.y"
+                                                { yyval = createNode("VarDec", ENUM_VARDEC_ARRAY, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 4, package(4, yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1837 "./syntax.tab.c"
+#line 1839 "./syntax.tab.c"
     break;
 
   case 28: /* VarDec: VarDec LB error RB  */
-#line 95 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 97 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1844 "./syntax.tab.c"
+#line 1846 "./syntax.tab.c"
     break;
 
   case 29: /* VarDec: VarDec LB error  */
-#line 97 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 99 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1851 "./syntax.tab.c"
+#line 1853 "./syntax.tab.c"
     break;
 
   case 30: /* FunDec: ID LP VarList RP  */
-#line 100 "./syntax.y"
-                                                { yyval = createNode("FunDec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 102 "./syntax.y"
+                                                { yyval = createNode("FunDec", ENUM_FUNDEC, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 4, package(4, yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1858 "./syntax.tab.c"
+#line 1860 "./syntax.tab.c"
     break;
 
   case 31: /* FunDec: ID LP RP  */
-#line 102 "./syntax.y"
-                                                { yyval = createNode("FunDec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 104 "./syntax.y"
+                                                { yyval = createNode("FunDec", ENUM_FUNDEC, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1865 "./syntax.tab.c"
+#line 1867 "./syntax.tab.c"
     break;
 
   case 32: /* FunDec: ID LP error RP  */
-#line 104 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 106 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1872 "./syntax.tab.c"
+#line 1874 "./syntax.tab.c"
     break;
 
   case 33: /* FunDec: ID LP error  */
-#line 106 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 108 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1879 "./syntax.tab.c"
+#line 1881 "./syntax.tab.c"
     break;
 
   case 34: /* VarList: ParamDec COMMA VarList  */
-#line 109 "./syntax.y"
-                                                { yyval = createNode("VarList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 111 "./syntax.y"
+                                                { yyval = createNode("VarList", ENUM_VARLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1886 "./syntax.tab.c"
+#line 1888 "./syntax.tab.c"
     break;
 
   case 35: /* VarList: ParamDec  */
-#line 111 "./syntax.y"
-                                                { yyval = createNode("VarList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 113 "./syntax.y"
+                                                { yyval = createNode("VarList", ENUM_VARLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1893 "./syntax.tab.c"
+#line 1895 "./syntax.tab.c"
     break;
 
   case 36: /* ParamDec: Specifier VarDec  */
-#line 114 "./syntax.y"
-                                                { yyval = createNode("ParamDec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 116 "./syntax.y"
+                                                { yyval = createNode("ParamDec", ENUM_PARAMDEC, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 1900 "./syntax.tab.c"
+#line 1902 "./syntax.tab.c"
     break;
 
   case 37: /* CompSt: LC DefList StmtList RC  */
-#line 119 "./syntax.y"
-                                                { yyval = createNode("CompSt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 121 "./syntax.y"
+                                                { yyval = createNode("CompSt", ENUM_COMPST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 4, package(4, yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1907 "./syntax.tab.c"
+#line 1909 "./syntax.tab.c"
     break;
 
   case 38: /* StmtList: Stmt StmtList  */
-#line 122 "./syntax.y"
-                                                { yyval = createNode("StmtList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 124 "./syntax.y"
+                                                { yyval = createNode("StmtList", ENUM_STMTLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 1914 "./syntax.tab.c"
+#line 1916 "./syntax.tab.c"
     break;
 
   case 39: /* StmtList: %empty  */
-#line 124 "./syntax.y"
-                                                { yyval = createNode("StmtList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 126 "./syntax.y"
+                                                { yyval = createNode("StmtList", ENUM_STMTLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 0, NULL); }
-#line 1921 "./syntax.tab.c"
+#line 1923 "./syntax.tab.c"
     break;
 
   case 40: /* Stmt: Exp SEMI  */
-#line 127 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 129 "./syntax.y"
+                                                { yyval = createNode("Stmt", ENUM_STMT_EXP, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 1928 "./syntax.tab.c"
+#line 1930 "./syntax.tab.c"
     break;
 
   case 41: /* Stmt: CompSt  */
-#line 129 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 131 "./syntax.y"
+                                                { yyval = createNode("Stmt", ENUM_STMT_COMPST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 1935 "./syntax.tab.c"
+#line 1937 "./syntax.tab.c"
     break;
 
   case 42: /* Stmt: RETURN Exp SEMI  */
-#line 131 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 133 "./syntax.y"
+                                                { yyval = createNode("Stmt", ENUM_STMT_RETURN, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1942 "./syntax.tab.c"
+#line 1944 "./syntax.tab.c"
     break;
 
   case 43: /* Stmt: IF LP Exp RP Stmt  */
-#line 133 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 135 "./syntax.y"
+                                                { yyval = createNode("Stmt", ENUM_STMT_IF, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 5, package(5, yyvsp[-4], yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1949 "./syntax.tab.c"
+#line 1951 "./syntax.tab.c"
     break;
 
   case 44: /* Stmt: IF LP Exp RP Stmt ELSE Stmt  */
-#line 135 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 137 "./syntax.y"
+                                                { yyval = createNode("Stmt", ENUM_STMT_IF_ELSE, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 7, package(7, yyvsp[-6], yyvsp[-5], yyvsp[-4], yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1956 "./syntax.tab.c"
+#line 1958 "./syntax.tab.c"
     break;
 
   case 45: /* Stmt: WHILE LP Exp RP Stmt  */
-#line 137 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 139 "./syntax.y"
+                                                { yyval = createNode("Stmt", ENUM_STMT_WHILE, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 5, package(5, yyvsp[-4], yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 1963 "./syntax.tab.c"
+#line 1965 "./syntax.tab.c"
     break;
 
   case 46: /* Stmt: error SEMI  */
-#line 139 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 141 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1970 "./syntax.tab.c"
+#line 1972 "./syntax.tab.c"
     break;
 
   case 47: /* Stmt: IF LP error RP Stmt  */
-#line 141 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 143 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1977 "./syntax.tab.c"
+#line 1979 "./syntax.tab.c"
     break;
 
   case 48: /* Stmt: IF LP Exp RP error ELSE Stmt  */
-#line 143 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 145 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1984 "./syntax.tab.c"
+#line 1986 "./syntax.tab.c"
     break;
 
   case 49: /* Stmt: IF LP error RP ELSE Stmt  */
-#line 145 "./syntax.y"
-                                            { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 147 "./syntax.y"
+                                            { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1991 "./syntax.tab.c"
+#line 1993 "./syntax.tab.c"
     break;
 
   case 50: /* Stmt: error LP Exp RP Stmt  */
-#line 147 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 149 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 1998 "./syntax.tab.c"
+#line 2000 "./syntax.tab.c"
     break;
 
   case 51: /* DefList: Def DefList  */
-#line 152 "./syntax.y"
-                                                { yyval = createNode("DefList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 154 "./syntax.y"
+                                                { yyval = createNode("DefList", ENUM_DEFLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 2005 "./syntax.tab.c"
+#line 2007 "./syntax.tab.c"
     break;
 
   case 52: /* DefList: %empty  */
-#line 154 "./syntax.y"
-                                                { yyval = createNode("Stmt", ENUM_SYN_NULL, (yyloc).first_line
+#line 156 "./syntax.y"
+                                                { yyval = createNode("DefList", ENUM_DEFLIST, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); }
-#line 2012 "./syntax.tab.c"
+#line 2014 "./syntax.tab.c"
     break;
 
   case 53: /* Def: Specifier DecList SEMI  */
-#line 157 "./syntax.y"
-                                                { yyval = createNode("Def", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 159 "./syntax.y"
+                                                { yyval = createNode("Def", ENUM_DEF, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2019 "./syntax.tab.c"
+#line 2021 "./syntax.tab.c"
     break;
 
   case 54: /* DecList: Dec  */
-#line 160 "./syntax.y"
-                                                { yyval = createNode("DecList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 162 "./syntax.y"
+                                                { yyval = createNode("DecList", ENUM_DECLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 2026 "./syntax.tab.c"
+#line 2028 "./syntax.tab.c"
     break;
 
   case 55: /* DecList: Dec COMMA DecList  */
-#line 162 "./syntax.y"
-                                                { yyval = createNode("DecList", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 164 "./syntax.y"
+                                                { yyval = createNode("DecList", ENUM_DECLIST, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2033 "./syntax.tab.c"
+#line 2035 "./syntax.tab.c"
     break;
 
   case 56: /* DecList: Dec error DecList  */
-#line 164 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 166 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2040 "./syntax.tab.c"
+#line 2042 "./syntax.tab.c"
     break;
 
   case 57: /* Dec: VarDec  */
-#line 167 "./syntax.y"
-                                                { yyval = createNode("Dec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 169 "./syntax.y"
+                                                { yyval = createNode("Dec", ENUM_DEC, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 2047 "./syntax.tab.c"
+#line 2049 "./syntax.tab.c"
     break;
 
   case 58: /* Dec: VarDec ASSIGNOP Exp  */
-#line 169 "./syntax.y"
-                                                { yyval = createNode("Dec", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 171 "./syntax.y"
+                                                { yyval = createNode("Dec", ENUM_DEC, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2054 "./syntax.tab.c"
+#line 2056 "./syntax.tab.c"
     break;
 
   case 59: /* Dec: error ASSIGNOP Exp  */
-#line 171 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 173 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2061 "./syntax.tab.c"
+#line 2063 "./syntax.tab.c"
     break;
 
   case 60: /* Exp: Exp ASSIGNOP Exp  */
-#line 176 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 178 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_ASSIGNOP, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2068 "./syntax.tab.c"
+#line 2070 "./syntax.tab.c"
     break;
 
   case 61: /* Exp: Exp AND Exp  */
-#line 178 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 180 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_AND, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2075 "./syntax.tab.c"
+#line 2077 "./syntax.tab.c"
     break;
 
   case 62: /* Exp: Exp OR Exp  */
-#line 180 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 182 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_OR, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2082 "./syntax.tab.c"
+#line 2084 "./syntax.tab.c"
     break;
 
   case 63: /* Exp: Exp RELOP Exp  */
-#line 182 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 184 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_RELOP, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2089 "./syntax.tab.c"
+#line 2091 "./syntax.tab.c"
     break;
 
   case 64: /* Exp: Exp PLUS Exp  */
-#line 184 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 186 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_PLUS, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2096 "./syntax.tab.c"
+#line 2098 "./syntax.tab.c"
     break;
 
   case 65: /* Exp: Exp MINUS Exp  */
-#line 186 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 188 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_MINUS, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2103 "./syntax.tab.c"
+#line 2105 "./syntax.tab.c"
     break;
 
   case 66: /* Exp: Exp STAR Exp  */
-#line 188 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 190 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_STAR, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2110 "./syntax.tab.c"
+#line 2112 "./syntax.tab.c"
     break;
 
   case 67: /* Exp: Exp DIV Exp  */
-#line 190 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 192 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_DIV, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2117 "./syntax.tab.c"
+#line 2119 "./syntax.tab.c"
     break;
 
   case 68: /* Exp: LP Exp RP  */
-#line 192 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 194 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_PAREN, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2124 "./syntax.tab.c"
+#line 2126 "./syntax.tab.c"
     break;
 
   case 69: /* Exp: MINUS Exp  */
-#line 194 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 196 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_NEG, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 2131 "./syntax.tab.c"
+#line 2133 "./syntax.tab.c"
     break;
 
   case 70: /* Exp: NOT Exp  */
-#line 196 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 198 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_NOT, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 2, package(2, yyvsp[-1], yyvsp[0])); }
-#line 2138 "./syntax.tab.c"
+#line 2140 "./syntax.tab.c"
     break;
 
   case 71: /* Exp: ID LP Args RP  */
-#line 198 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 200 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_CALL, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 4, package(4, yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2145 "./syntax.tab.c"
+#line 2147 "./syntax.tab.c"
     break;
 
   case 72: /* Exp: ID LP RP  */
-#line 200 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 202 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_CALL, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2152 "./syntax.tab.c"
+#line 2154 "./syntax.tab.c"
     break;
 
   case 73: /* Exp: Exp LB Exp RB  */
-#line 202 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 204 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_INDEX, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 4, package(4, yyvsp[-3], yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2159 "./syntax.tab.c"
+#line 2161 "./syntax.tab.c"
     break;
 
   case 74: /* Exp: Exp DOT ID  */
-#line 204 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 206 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_DOT, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2166 "./syntax.tab.c"
+#line 2168 "./syntax.tab.c"
     break;
 
   case 75: /* Exp: ID  */
-#line 206 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 208 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_ID, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 2173 "./syntax.tab.c"
+#line 2175 "./syntax.tab.c"
     break;
 
   case 76: /* Exp: INT  */
-#line 208 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 210 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_INT, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 2180 "./syntax.tab.c"
+#line 2182 "./syntax.tab.c"
     break;
 
   case 77: /* Exp: FLOAT  */
-#line 210 "./syntax.y"
-                                                { yyval = createNode("Exp", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 212 "./syntax.y"
+                                                { yyval = createNode("Exp", ENUM_EXP_FLOAT, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 2187 "./syntax.tab.c"
+#line 2189 "./syntax.tab.c"
     break;
 
   case 78: /* Exp: Exp ASSIGNOP error  */
-#line 212 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 214 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2194 "./syntax.tab.c"
+#line 2196 "./syntax.tab.c"
     break;
 
   case 79: /* Exp: Exp AND error  */
-#line 214 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 216 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2201 "./syntax.tab.c"
+#line 2203 "./syntax.tab.c"
     break;
 
   case 80: /* Exp: Exp OR error  */
-#line 216 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 218 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2208 "./syntax.tab.c"
+#line 2210 "./syntax.tab.c"
     break;
 
   case 81: /* Exp: Exp RELOP error  */
-#line 218 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 220 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2215 "./syntax.tab.c"
+#line 2217 "./syntax.tab.c"
     break;
 
   case 82: /* Exp: Exp PLUS error  */
-#line 220 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 222 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2222 "./syntax.tab.c"
+#line 2224 "./syntax.tab.c"
     break;
 
   case 83: /* Exp: Exp MINUS error  */
-#line 222 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 224 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2229 "./syntax.tab.c"
+#line 2231 "./syntax.tab.c"
     break;
 
   case 84: /* Exp: Exp STAR error  */
-#line 224 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 226 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2236 "./syntax.tab.c"
+#line 2238 "./syntax.tab.c"
     break;
 
   case 85: /* Exp: Exp DIV error  */
-#line 226 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 228 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2243 "./syntax.tab.c"
+#line 2245 "./syntax.tab.c"
     break;
 
   case 86: /* Exp: ID LP error RP  */
-#line 228 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 230 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2250 "./syntax.tab.c"
+#line 2252 "./syntax.tab.c"
     break;
 
   case 87: /* Exp: Exp LB error RB  */
-#line 230 "./syntax.y"
-                                                { yyval = createNode("Error", ENUM_SYN_NULL, (yyloc).first_line
+#line 232 "./syntax.y"
+                                                { yyval = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, (yyloc).first_line
                                                   , 0, NULL); yyerrok; }
-#line 2257 "./syntax.tab.c"
+#line 2259 "./syntax.tab.c"
     break;
 
   case 88: /* Args: Exp COMMA Args  */
-#line 233 "./syntax.y"
-                                                { yyval = createNode("Args", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 235 "./syntax.y"
+                                                { yyval = createNode("Args", ENUM_ARGS, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 3, package(3, yyvsp[-2], yyvsp[-1], yyvsp[0])); }
-#line 2264 "./syntax.tab.c"
+#line 2266 "./syntax.tab.c"
     break;
 
   case 89: /* Args: Exp  */
-#line 235 "./syntax.y"
-                                                { yyval = createNode("Args", ENUM_SYN_NOT_NULL, (yyloc).first_line
+#line 237 "./syntax.y"
+                                                { yyval = createNode("Args", ENUM_ARGS, ENUM_SYN_NOT_NULL, (yyloc).first_line
                                                   , 1, package(1, yyvsp[0])); }
-#line 2271 "./syntax.tab.c"
+#line 2273 "./syntax.tab.c"
     break;
 
 
-#line 2275 "./syntax.tab.c"
+#line 2277 "./syntax.tab.c"
 
       default: break;
     }
@@ -2500,12 +2502,12 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 238 "./syntax.y"
+#line 240 "./syntax.y"
 
 Node** package(int childNum, Node* child1, ...) {
     va_list ap;
     va_start(ap, child1);
-    Node** res = (Node**)malloc(sizeof(Node*) * childNum);
+    Node** res = (Node**)treeAlloc(sizeof(Node*) * childNum);
     res[0] = child1;
     for (int i = 1; i < childNum; i++)
     {
@@ -8,6 +8,8 @@
     Node** package(int childNum, Node* child1, ...);
     void yyerror(const char* msg);
     int synError = 0;
+    // 语句列表和else if链都是右递归，生成的长程序需要很深的分析栈
+    #define YYMAXDEPTH 1000000
 %}
 
 %token INT FLOAT ID SEMI COMMA ASSIGNOP RELOP 
@@ -27,219 +29,219 @@
 
 %%
 /* High-level Definitions */
-Program : ExtDefList                            { $$ = createNode("Program", ENUM_SYN_NOT_NULL, @$.first_line, 
+Program : ExtDefList                            { $$ = createNode("Program", ENUM_PROGRAM, ENUM_SYN_NOT_NULL, @$.first_line, 
                                                   1, package(1, $1));
                                                   root = $$; }
     ;
-ExtDefList : ExtDef ExtDefList                  { $$ = createNode("ExtDefList", ENUM_SYN_NOT_NULL, @$.first_line
+ExtDefList : ExtDef ExtDefList                  { $$ = createNode("ExtDefList", ENUM_EXTDEFLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | /* empty */                               { $$ = createNode("ExtDefList", ENUM_SYN_NULL, @$.first_line
+    | /* empty */                               { $$ = createNode("ExtDefList", ENUM_EXTDEFLIST, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL);}
     ;
-ExtDef : Specifier ExtDecList SEMI              { $$ = createNode("ExtDef", ENUM_SYN_NOT_NULL, @$.first_line
+ExtDef : Specifier ExtDecList SEMI              { $$ = createNode("ExtDef", ENUM_EXTDEF_VAR, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Specifier SEMI                            { $$ = createNode("ExtDef", ENUM_SYN_NOT_NULL, @$.first_line
+    | Specifier SEMI                            { $$ = createNode("ExtDef", ENUM_EXTDEF_TYPE, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | Specifier FunDec SEMI                     { $$ = createNode("ExtDef", ENUM_SYN_NOT_NULL, @$.first_line
+    | Specifier FunDec SEMI                     { $$ = createNode("ExtDef", ENUM_EXTDEF_FUNDEC, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Specifier FunDec CompSt                   { $$ = createNode("ExtDef", ENUM_SYN_NOT_NULL, @$.first_line
+    | Specifier FunDec CompSt                   { $$ = createNode("ExtDef", ENUM_EXTDEF_FUNDEF, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Specifier error SEMI                      { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Specifier error SEMI                      { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | error SEMI                                { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | error SEMI                                { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Specifier error                           { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Specifier error                           { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
-ExtDecList : VarDec                             { $$ = createNode("ExtDecList", ENUM_SYN_NOT_NULL, @$.first_line
+ExtDecList : VarDec                             { $$ = createNode("ExtDecList", ENUM_EXTDECLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | VarDec COMMA ExtDecList                   { $$ = createNode("ExtDecList", ENUM_SYN_NOT_NULL, @$.first_line
+    | VarDec COMMA ExtDecList                   { $$ = createNode("ExtDecList", ENUM_EXTDECLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | VarDec error COMMA ExtDecList             { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | VarDec error COMMA ExtDecList             { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
 
 /* Specifiers */
-Specifier : TYPE                                { $$ = createNode("Specifier", ENUM_SYN_NOT_NULL, @$.first_line
+Specifier : TYPE                                { $$ = createNode("Specifier", ENUM_SPECIFIER_TYPE, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | StructSpecifier                           { $$ = createNode("Specifier", ENUM_SYN_NOT_NULL, @$.first_line
+    | StructSpecifier                           { $$ = createNode("Specifier", ENUM_SPECIFIER_STRUCT, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
     ;
-StructSpecifier : STRUCT OptTag LC DefList RC   { $$ = createNode("StructSpecifier", ENUM_SYN_NOT_NULL, @$.first_line
+StructSpecifier : STRUCT OptTag LC DefList RC   { $$ = createNode("StructSpecifier", ENUM_STRUCTSPECIFIER_DEF, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 5, package(5, $1, $2, $3, $4, $5)); }
-    | STRUCT Tag                                { $$ = createNode("StructSpecifier", ENUM_SYN_NOT_NULL, @$.first_line
+    | STRUCT Tag                                { $$ = createNode("StructSpecifier", ENUM_STRUCTSPECIFIER_TAG, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | STRUCT error LC DefList RC                { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | STRUCT error LC DefList RC                { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | STRUCT OptTag LC error RC                 { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | STRUCT OptTag LC error RC                 { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | STRUCT OptTag LC error                    { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | STRUCT OptTag LC error                    { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | STRUCT error                              { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | STRUCT error                              { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
-OptTag : ID                                     { $$ = createNode("OptTag", ENUM_SYN_NOT_NULL, @$.first_line
+OptTag : ID                                     { $$ = createNode("OptTag", ENUM_OPTTAG, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | /* empty */                               { $$ = createNode("OptTag", ENUM_SYN_NULL, @$.first_line
+    | /* empty */                               { $$ = createNode("OptTag", ENUM_OPTTAG, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); }
     ;
-Tag : ID                                        { $$ = createNode("Tag", ENUM_SYN_NOT_NULL, @$.first_line
+Tag : ID                                        { $$ = createNode("Tag", ENUM_TAG, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
     ;
 
 /* Declarators */
-VarDec : ID                                     { $$ = createNode("VarDec", ENUM_SYN_NOT_NULL, @$.first_line
+VarDec : ID                                     { $$ = createNode("VarDec", ENUM_VARDEC_ID, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | VarDec LB INT RB                          { $$ = createNode("VarDec", ENUM_SYN_NOT_NULL, @$.first_line
+    | VarDec LB INT RB                          { $$ = createNode("VarDec", ENUM_VARDEC_ARRAY, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 4, package(4, $1, $2, $3, $4)); }
-    | VarDec LB error RB                        { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | VarDec LB error RB                        { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | VarDec LB error                           { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | VarDec LB error                           { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
-FunDec : ID LP VarList RP                       { $$ = createNode("FunDec", ENUM_SYN_NOT_NULL, @$.first_line
+FunDec : ID LP VarList RP                       { $$ = createNode("FunDec", ENUM_FUNDEC, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 4, package(4, $1, $2, $3, $4)); }
-    | ID LP RP                                  { $$ = createNode("FunDec", ENUM_SYN_NOT_NULL, @$.first_line
+    | ID LP RP                                  { $$ = createNode("FunDec", ENUM_FUNDEC, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | ID LP error RP                            { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | ID LP error RP                            { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | ID LP error                               { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | ID LP error                               { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
-VarList : ParamDec COMMA VarList                { $$ = createNode("VarList", ENUM_SYN_NOT_NULL, @$.first_line
+VarList : ParamDec COMMA VarList                { $$ = createNode("VarList", ENUM_VARLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | ParamDec                                  { $$ = createNode("VarList", ENUM_SYN_NOT_NULL, @$.first_line
+    | ParamDec                                  { $$ = createNode("VarList", ENUM_VARLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
     ;
-ParamDec : Specifier VarDec                     { $$ = createNode("ParamDec", ENUM_SYN_NOT_NULL, @$.first_line
+ParamDec : Specifier VarDec                     { $$ = createNode("ParamDec", ENUM_PARAMDEC, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
     ;
 
 /* Statements */
-CompSt : LC DefList StmtList RC                 { $$ = createNode("CompSt", ENUM_SYN_NOT_NULL, @$.first_line
+CompSt : LC DefList StmtList RC                 { $$ = createNode("CompSt", ENUM_COMPST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 4, package(4, $1, $2, $3, $4)); }
     ;
-StmtList : Stmt StmtList                        { $$ = createNode("StmtList", ENUM_SYN_NOT_NULL, @$.first_line
+StmtList : Stmt StmtList                        { $$ = createNode("StmtList", ENUM_STMTLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | /* empty */                               { $$ = createNode("StmtList", ENUM_SYN_NOT_NULL, @$.first_line
+    | /* empty */                               { $$ = createNode("StmtList", ENUM_STMTLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 0, NULL); }
     ;
-Stmt : Exp SEMI                                 { $$ = createNode("Stmt", ENUM_SYN_NOT_NULL, @$.first_line
+Stmt : Exp SEMI                                 { $$ = createNode("Stmt", ENUM_STMT_EXP, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | CompSt                                    { $$ = createNode("Stmt", ENUM_SYN_NOT_NULL, @$.first_line
+    | CompSt                                    { $$ = createNode("Stmt", ENUM_STMT_COMPST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | RETURN Exp SEMI                           { $$ = createNode("Stmt", ENUM_SYN_NOT_NULL, @$.first_line
+    | RETURN Exp SEMI                           { $$ = createNode("Stmt", ENUM_STMT_RETURN, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | IF LP Exp RP Stmt %prec LOWER_THAN_ELSE   { $$ = createNode("Stmt", ENUM_SYN_NOT_NULL, @$.first_line
+    | IF LP Exp RP Stmt %prec LOWER_THAN_ELSE   { $$ = createNode("Stmt", ENUM_STMT_IF, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 5, package(5, $1, $2, $3, $4, $5)); }
-    | IF LP Exp RP Stmt ELSE Stmt               { $$ = createNode("Stmt", ENUM_SYN_NOT_NULL, @$.first_line
+    | IF LP Exp RP Stmt ELSE Stmt               { $$ = createNode("Stmt", ENUM_STMT_IF_ELSE, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 7, package(7, $1, $2, $3, $4, $5, $6, $7)); }
-    | WHILE LP Exp RP Stmt                      { $$ = createNode("Stmt", ENUM_SYN_NOT_NULL, @$.first_line
+    | WHILE LP Exp RP Stmt                      { $$ = createNode("Stmt", ENUM_STMT_WHILE, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 5, package(5, $1, $2, $3, $4, $5)); }
-    | error SEMI                                { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | error SEMI                                { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | IF LP error RP Stmt %prec LOWER_THAN_ELSE { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | IF LP error RP Stmt %prec LOWER_THAN_ELSE { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | IF LP Exp RP error ELSE Stmt              { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | IF LP Exp RP error ELSE Stmt              { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | IF LP error RP ELSE Stmt              { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | IF LP error RP ELSE Stmt              { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | error LP Exp RP Stmt                      { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | error LP Exp RP Stmt                      { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
 
 /* Local Definitions */
-DefList : Def DefList                           { $$ = createNode("DefList", ENUM_SYN_NOT_NULL, @$.first_line
+DefList : Def DefList                           { $$ = createNode("DefList", ENUM_DEFLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | /* empty */                               { $$ = createNode("Stmt", ENUM_SYN_NULL, @$.first_line
+    | /* empty */                               { $$ = createNode("DefList", ENUM_DEFLIST, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); }
     ;
-Def : Specifier DecList SEMI                    { $$ = createNode("Def", ENUM_SYN_NOT_NULL, @$.first_line
+Def : Specifier DecList SEMI                    { $$ = createNode("Def", ENUM_DEF, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
     ;
-DecList : Dec                                   { $$ = createNode("DecList", ENUM_SYN_NOT_NULL, @$.first_line
+DecList : Dec                                   { $$ = createNode("DecList", ENUM_DECLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | Dec COMMA DecList                         { $$ = createNode("DecList", ENUM_SYN_NOT_NULL, @$.first_line
+    | Dec COMMA DecList                         { $$ = createNode("DecList", ENUM_DECLIST, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Dec error DecList                         { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Dec error DecList                         { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
-Dec : VarDec                                    { $$ = createNode("Dec", ENUM_SYN_NOT_NULL, @$.first_line
+Dec : VarDec                                    { $$ = createNode("Dec", ENUM_DEC, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | VarDec ASSIGNOP Exp                       { $$ = createNode("Dec", ENUM_SYN_NOT_NULL, @$.first_line
+    | VarDec ASSIGNOP Exp                       { $$ = createNode("Dec", ENUM_DEC, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | error ASSIGNOP Exp                        { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | error ASSIGNOP Exp                        { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
 
 /* Expressions */
-Exp : Exp ASSIGNOP Exp                          { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+Exp : Exp ASSIGNOP Exp                          { $$ = createNode("Exp", ENUM_EXP_ASSIGNOP, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp AND Exp                               { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp AND Exp                               { $$ = createNode("Exp", ENUM_EXP_AND, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp OR Exp                                { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp OR Exp                                { $$ = createNode("Exp", ENUM_EXP_OR, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp RELOP Exp                             { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp RELOP Exp                             { $$ = createNode("Exp", ENUM_EXP_RELOP, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp PLUS Exp                              { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp PLUS Exp                              { $$ = createNode("Exp", ENUM_EXP_PLUS, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp MINUS Exp                             { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp MINUS Exp                             { $$ = createNode("Exp", ENUM_EXP_MINUS, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp STAR Exp                              { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp STAR Exp                              { $$ = createNode("Exp", ENUM_EXP_STAR, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp DIV Exp                               { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp DIV Exp                               { $$ = createNode("Exp", ENUM_EXP_DIV, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | LP Exp RP                                 { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | LP Exp RP                                 { $$ = createNode("Exp", ENUM_EXP_PAREN, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | MINUS Exp                                 { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | MINUS Exp                                 { $$ = createNode("Exp", ENUM_EXP_NEG, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | NOT Exp                                   { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | NOT Exp                                   { $$ = createNode("Exp", ENUM_EXP_NOT, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 2, package(2, $1, $2)); }
-    | ID LP Args RP                             { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | ID LP Args RP                             { $$ = createNode("Exp", ENUM_EXP_CALL, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 4, package(4, $1, $2, $3, $4)); }
-    | ID LP RP                                  { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | ID LP RP                                  { $$ = createNode("Exp", ENUM_EXP_CALL, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp LB Exp RB                             { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp LB Exp RB                             { $$ = createNode("Exp", ENUM_EXP_INDEX, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 4, package(4, $1, $2, $3, $4)); }
-    | Exp DOT ID                                { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp DOT ID                                { $$ = createNode("Exp", ENUM_EXP_DOT, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | ID                                        { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | ID                                        { $$ = createNode("Exp", ENUM_EXP_ID, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | INT                                       { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | INT                                       { $$ = createNode("Exp", ENUM_EXP_INT, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | FLOAT                                     { $$ = createNode("Exp", ENUM_SYN_NOT_NULL, @$.first_line
+    | FLOAT                                     { $$ = createNode("Exp", ENUM_EXP_FLOAT, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
-    | Exp ASSIGNOP error                        { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp ASSIGNOP error                        { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp AND error                             { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp AND error                             { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp OR error                              { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp OR error                              { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp RELOP error                           { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp RELOP error                           { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp PLUS error                            { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp PLUS error                            { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp MINUS error                           { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp MINUS error                           { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp STAR error                            { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp STAR error                            { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp DIV error                             { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp DIV error                             { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | ID LP error RP                            { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | ID LP error RP                            { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
-    | Exp LB error RB                           { $$ = createNode("Error", ENUM_SYN_NULL, @$.first_line
+    | Exp LB error RB                           { $$ = createNode("Error", ENUM_ERROR, ENUM_SYN_NULL, @$.first_line
                                                   , 0, NULL); yyerrok; }
     ;
-Args : Exp COMMA Args                           { $$ = createNode("Args", ENUM_SYN_NOT_NULL, @$.first_line
+Args : Exp COMMA Args                           { $$ = createNode("Args", ENUM_ARGS, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 3, package(3, $1, $2, $3)); }
-    | Exp                                       { $$ = createNode("Args", ENUM_SYN_NOT_NULL, @$.first_line
+    | Exp                                       { $$ = createNode("Args", ENUM_ARGS, ENUM_SYN_NOT_NULL, @$.first_line
                                                   , 1, package(1, $1)); }
     ;
 %%
 Node** package(int childNum, Node* child1, ...) {
     va_list ap;
     va_start(ap, child1);
-    Node** res = (Node**)malloc(sizeof(Node*) * childNum);
+    Node** res = (Node**)treeAlloc(sizeof(Node*) * childNum);
     res[0] = child1;
     for (int i = 1; i < childNum; i++)
     {